@@ -68,6 +68,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <rcsc/action/body_intercept.h>
 #include <rcsc/action/neck_turn_to_ball_or_scan.h>
 #include <rcsc/action/neck_turn_to_low_conf_teammate.h>
+#include <rcsc/action/path_planner.h>
 
 #include "bhv_basic_tackle.h"
 #include "obake_stamina_control.h"
@@ -157,7 +158,23 @@ Bhv_BasicMove::execute( rcsc::PlayerAgent * agent )
     /********************************************/
     //end of the added code
     agent->debugClient().setTarget( M_home_pos );
-    if ( ! rcsc::Body_GoToPoint( M_home_pos, dist_thr, dash_power
+
+    // detour around the players on the way
+    rcsc::Vector2D move_point = M_home_pos;
+    double move_dist_thr = dist_thr;
+    if ( wm.self().pos().dist( M_home_pos ) > dist_thr
+         && rcsc::PathPlanner::instance().plan( agent, M_home_pos, &move_point )
+         && move_point.dist2( M_home_pos ) > 1.0e-6 )
+    {
+        move_dist_thr = rcsc::PathPlanner::CELL_SIZE * 0.5;
+        agent->debugClient().addMessage( "Detour" );
+    }
+    else
+    {
+        move_point = M_home_pos;
+    }
+
+    if ( ! rcsc::Body_GoToPoint( move_point, move_dist_thr, dash_power
                                  ).execute( agent ) )
     {
         if(Obake_Analysis().checkExistOurPenaltyAreaIn(wm.self().pos()))
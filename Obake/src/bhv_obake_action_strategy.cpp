@@ -44,6 +44,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "obake_strategy.h"
 #include "bhv_obake_action_strategy.h"
 #include "bhv_obake_action_strategy_test.h"
+#include "obake_action_evaluator.h"
 
 bool
 Bhv_ObakeActionStrategy::execute(rcsc::PlayerAgent * agent)
@@ -66,6 +67,11 @@ Bhv_ObakeActionStrategy::execute(rcsc::PlayerAgent * agent)
         }
     }
 
+    if(Obake_ActionEvaluator::instance().execute(agent))
+    {
+        return true;
+    }
+
     if(getBestAction(agent))
     {
 	return true;
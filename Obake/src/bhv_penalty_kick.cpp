@@ -47,6 +47,7 @@
 #include <rcsc/action/body_intercept.h>
 #include <rcsc/action/body_kick_one_step.h>
 #include <rcsc/action/body_kick_multi_step.h>
+#include <rcsc/action/kick_oracle.h>
 #include <rcsc/action/body_stop_dash.h>
 #include <rcsc/action/body_stop_ball.h>
 #include <rcsc/action/neck_scan_field.h>
@@ -56,6 +57,7 @@
 #include "bhv_go_to_static_ball.h"
 
 #include "bhv_penalty_kick.h"
+#include "penalty_table.h"
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -78,6 +80,17 @@ bool
 Bhv_PenaltyKick::execute( rcsc::PlayerAgent * agent )
 {
     const rcsc::PenaltyKickState * state = agent->world().penaltyKickState();
+
+    if ( ! PenaltyTable::instance().matchServerParam() )
+    {
+        // the tables were solved by other server parameters,
+        // e.g. the defaults used at startup.
+        PenaltyTable::instance().build();
+        rcsc::dlog.addText( rcsc::Logger::TEAM,
+                            "%s:%d: penalty tables are solved again"
+                            ,__FILE__, __LINE__ );
+    }
+
     switch ( agent->world().gameMode().type() ) {
     case rcsc::GameMode::PenaltySetup_:
         if ( state->currentTakerSide() == agent->world().ourSide() )
@@ -392,6 +405,19 @@ Bhv_PenaltyKick::doOneKickShoot( rcsc::PlayerAgent * agent )
                 shot_point.y *= -1.0;
             }
         }
+        else
+        {
+            // no hint from the goalie. select the faster side.
+            const rcsc::KickOracle & oracle = rcsc::KickOracle::get( agent->world() );
+            const rcsc::Vector2D ball_pos = agent->world().ball().pos();
+            rcsc::Vector2D opposite = shot_point;
+            opposite.y *= -1.0;
+            if ( oracle.maxSpeed( ( opposite - ball_pos ).th() )
+                 > oracle.maxSpeed( ( shot_point - ball_pos ).th() ) )
+            {
+                shot_point = opposite;
+            }
+        }
     }
 
     // enforce one step kick
@@ -499,6 +525,41 @@ Bhv_PenaltyKick::getShootTarget( const rcsc::PlayerAgent * agent,
 
     const rcsc::Vector2D goalie_next_pos = opp_goalie->pos() + opp_goalie->vel();
 
+    // table lookup. coordinates are reversed if the kicker attacks the left goal.
+    {
+        const double reverse = ( state->onfieldSide() == agent->world().ourSide()
+                                 ? -1.0 : 1.0 );
+        const rcsc::PlayerType * ptype = opp_goalie->playerTypePtr();
+        const int bin = PenaltyTable::speed_bin( ptype
+                                                 ? ptype->realSpeedMax()
+                                                 : goalie_max_speed );
+        PenaltyTable::Shot shot;
+        if ( PenaltyTable::instance().getShot( agent->world().ball().pos() * reverse,
+                                               goalie_next_pos * reverse,
+                                               bin,
+                                               shot ) )
+        {
+            // the table assumes that the goalie position is accurate.
+            if ( shot.margin_ <= goalie_max_speed * std::min( 5, opp_goalie->posCount() ) )
+            {
+                rcsc::dlog.addText( rcsc::Logger::TEAM,
+                                    "%s:%d: shoot table. goalie can reach. margin=%.2f"
+                                    ,__FILE__, __LINE__,
+                                    shot.margin_ );
+                return false;
+            }
+
+            rcsc::dlog.addText( rcsc::Logger::TEAM,
+                                "%s:%d: shoot table. target=(%.1f, %.1f) margin=%.2f"
+                                ,__FILE__, __LINE__,
+                                shot.target_.x * reverse, shot.target_.y * reverse,
+                                shot.margin_ );
+            if ( point ) *point = shot.target_ * reverse;
+            if ( first_speed ) *first_speed = rcsc::ServerParam::i().ballSpeedMax();
+            return true;
+        }
+    }
+
     for ( int i = 0; i < 2; i++ )
     {
         const rcsc::Vector2D& target = ( i == 0 ? shot_l : shot_r );
@@ -634,7 +695,29 @@ Bhv_PenaltyKick::doDribble( rcsc::PlayerAgent * agent )
     }
     else
     {
-        if ( goalie_abs_x > my_abs_x )
+        rcsc::Vector2D table_target;
+        if ( opp_goalie
+             && PenaltyTable::instance()
+             .getDribbleTarget( agent->world().ball().pos() * onfield_flag,
+                                ( opp_goalie->pos() + opp_goalie->vel() ) * onfield_flag,
+                                PenaltyTable::speed_bin( opp_goalie->playerTypePtr()
+                                                         ? opp_goalie->playerTypePtr()->realSpeedMax()
+                                                         : goalie_max_speed ),
+                                table_target ) )
+        {
+            // move to the neighbor cell that has the best shot
+            drib_target = table_target * onfield_flag;
+
+            double dashes = ( agent->world().self().pos().dist( drib_target )
+                              / rcsc::ServerParam::i().defaultPlayerSpeedMax() );
+            drib_dashes = static_cast<int>(floor(dashes));
+            drib_dashes = rcsc::min_max( 1, drib_dashes, 6 );
+            rcsc::dlog.addText( rcsc::Logger::TEAM,
+                                "%s:%d: dribble table. target=(%f, %f) dashes=%d"
+                                ,__FILE__, __LINE__,
+                                drib_target.x, drib_target.y, drib_dashes );
+        }
+        else if ( goalie_abs_x > my_abs_x )
         {
             if ( goalie_dist < 4.0 )
             {
@@ -986,7 +1069,18 @@ Bhv_PenaltyKick::doGoalieBasicMove( rcsc::PlayerAgent * agent )
         ball_pos *= -1.0;
     }
 
-    move_pos = getGoalieMovePos(ball_pos, my_pos);
+    // the table is normalized so that the kicker attacks the positive x side.
+    if ( PenaltyTable::instance()
+         .getGoalieMovePos( -ball_pos,
+                            PenaltyTable::speed_bin( agent->world().self().playerType().realSpeedMax() ),
+                            move_pos ) )
+    {
+        move_pos *= -1.0;
+    }
+    else
+    {
+        move_pos = getGoalieMovePos(ball_pos, my_pos);
+    }
 
     if ( state->onfieldSide() != agent->world().ourSide() )
     {
@@ -46,6 +46,7 @@
 #include <rcsc/action/neck_scan_field.h>
 
 #include "bhv_set_play.h"
+#include "set_play_coordinator.h"
 #include "bhv_prepare_set_play_kick.h"
 #include "bhv_go_to_static_ball.h"
 
@@ -94,15 +95,10 @@ Bhv_SetPlayFreeKick::isKicker( const rcsc::PlayerAgent * agent )
         return false;
     }
 
-    const rcsc::PlayerObject * nearest_mate
-        = static_cast< rcsc::PlayerObject * >( 0 );
-    nearest_mate = wm.teammatesFromBall().front();
-
     if ( wm.setplayCount() < max_wait1
          || ( wm.setplayCount() < max_wait2
               && wm.self().pos().dist( M_home_pos ) > 20.0 )
-         || ( nearest_mate
-              && nearest_mate->distFromBall() < wm.ball().distFromSelf() * 0.9 )
+         || ! SetPlayCoordinator::instance().isKicker( wm )
          )
     {
         return false;
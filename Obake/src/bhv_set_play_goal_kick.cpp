@@ -40,6 +40,7 @@
 #include <rcsc/action/intention_kick.h>
 
 #include "bhv_set_play.h"
+#include "set_play_coordinator.h"
 #include "bhv_prepare_set_play_kick.h"
 #include "bhv_go_to_static_ball.h"
 
@@ -82,27 +83,7 @@ Bhv_SetPlayGoalKick::isKicker( const rcsc::PlayerAgent * agent )
         return false;
     }
 
-    if ( wm.teammatesFromBall().empty() )
-    {
-        return true;
-    }
-
-    const rcsc::PlayerPtrCont::const_iterator end
-        = agent->world().teammatesFromBall().end();
-    for ( rcsc::PlayerPtrCont::const_iterator it
-              = agent->world().teammatesFromBall().begin();
-          it != end;
-          ++it )
-    {
-        if ( ! (*it)->goalie()
-             && (*it)->distFromBall() < agent->world().ball().distFromSelf() )
-        {
-            // exist other kicker
-            return false;
-        }
-    }
-
-    return true;
+    return SetPlayCoordinator::instance().isKicker( wm );
 }
 
 /*-------------------------------------------------------------------*/
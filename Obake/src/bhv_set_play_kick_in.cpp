@@ -45,6 +45,7 @@
 #include <rcsc/action/neck_scan_field.h>
 
 #include "bhv_set_play.h"
+#include "set_play_coordinator.h"
 #include "bhv_prepare_set_play_kick.h"
 
 #include "bhv_set_play_kick_in.h"
@@ -89,15 +90,10 @@ Bhv_SetPlayKickIn::isKicker( const rcsc::PlayerAgent * agent )
     long max_wait1 = 30;
     long max_wait2 = 50;
 
-    const rcsc::PlayerObject * nearest_mate
-        = static_cast< rcsc::PlayerObject * >( 0 );
-    nearest_mate = wm.teammatesFromBall().front();
-
     if ( wm.setplayCount() < max_wait1
          || ( wm.setplayCount() < max_wait2
               && wm.self().pos().dist( M_home_pos ) > 20.0 )
-         || ( nearest_mate
-              && nearest_mate->distFromBall() < wm.ball().distFromSelf() * 0.9 )
+         || ! SetPlayCoordinator::instance().isKicker( wm )
          )
     {
         return false;
@@ -42,6 +42,7 @@
 
 #include "bhv_go_to_static_ball.h"
 #include "bhv_set_play.h"
+#include "set_play_coordinator.h"
 #include "bhv_prepare_set_play_kick.h"
 
 #include "bhv_set_play_kick_off.h"
@@ -73,14 +74,7 @@ Bhv_SetPlayKickOff::execute( rcsc::PlayerAgent * agent )
 bool
 Bhv_SetPlayKickOff::isKicker( const rcsc::PlayerAgent * agent )
 {
-    if ( ! agent->world().teammatesFromBall().empty()
-         && ( agent->world().teammatesFromBall().front()->distFromBall()
-              < agent->world().ball().distFromSelf() ) )
-    {
-        return false;
-    }
-
-    return true;
+    return SetPlayCoordinator::instance().isKicker( agent->world() );
 }
 
 /*-------------------------------------------------------------------*/
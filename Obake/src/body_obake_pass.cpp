@@ -40,6 +40,7 @@
 #include <rcsc/action/body_kick_multi_step.h>
 #include <rcsc/action/body_stop_ball.h>
 #include <rcsc/action/body_hold_ball.h>
+#include <rcsc/action/kick_oracle.h>
 
 #include <rcsc/player/interception.h>
 #include <rcsc/common/logger.h>
@@ -1929,11 +1930,7 @@ Body_ObakePass::can_kick_by_one_step( rcsc::PlayerAgent * agent,
 				      const double & first_speed,
 				      const rcsc::AngleDeg & target_angle )
 {
-    const rcsc::WorldModel & wm = agent->world();
-    rcsc::Vector2D required_accel = rcsc::Vector2D::polar2vector( first_speed, target_angle );
-    required_accel -= wm.ball().vel();
-    return ( wm.self().kickRate() * rcsc::ServerParam::i().maxPower()
-             > required_accel.r() );
+    return rcsc::KickOracle::get( agent->world() ).canKick( first_speed, target_angle );
 }
 
 
@@ -0,0 +1,129 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib> // exit, atoi
+#include <cstdio> // printf
+
+#include <rcsc/timer.h>
+
+#include "penalty_table.h"
+
+/*!
+  usage:
+  penalty_solver build <output_file>
+  penalty_solver eval <table_file> [<trials>]
+
+  build: solve all penalty tables by the default server parameters
+  and write them to the file.
+  eval: load the table file and print the kicker's success rate
+  against goalie position errors.
+*/
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+void
+usage()
+{
+    std::cerr << "Usage: penalty_solver build <output_file>\n"
+              << "       penalty_solver eval <table_file> [<trials>]"
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+void
+print_success_rate( const PenaltyTable & table,
+                    const int trials )
+{
+    for ( int i = 0; i <= 4; ++i )
+    {
+        const double noise = 0.5 * i;
+        std::printf( "noise %.1f: success rate %.3f (%d trials)\n",
+                     noise,
+                     table.estimateSuccessRate( trials, noise, 1UL ),
+                     trials );
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 3 )
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    const std::string mode = argv[1];
+    const std::string filepath = argv[2];
+    PenaltyTable & table = PenaltyTable::instance();
+
+    if ( mode == "build" )
+    {
+        const rcsc::MSecTimer timer;
+        table.build();
+        std::printf( "solved in %.1f [ms]\n", timer.elapsedReal() );
+
+        std::ofstream fout( filepath.c_str() );
+        if ( ! fout.is_open()
+             || ! table.write( fout ) )
+        {
+            std::cerr << __FILE__ << ": " << __LINE__
+                      << ": could not write the table to "
+                      << filepath << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        print_success_rate( table, 10000 );
+    }
+    else if ( mode == "eval" )
+    {
+        if ( ! table.read( filepath ) )
+        {
+            return EXIT_FAILURE;
+        }
+
+        print_success_rate( table,
+                            ( argc >= 4 ? std::atoi( argv[3] ) : 10000 ) );
+    }
+    else
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
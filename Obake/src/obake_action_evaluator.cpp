@@ -0,0 +1,718 @@
+// -*-c++-*-
+
+/*!
+  \file obake_action_evaluator.cpp
+  \brief unified on-ball action candidate evaluator Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "obake_action_evaluator.h"
+
+#include "bhv_obake_action_strategy.h"
+
+#include <rcsc/action/body_dribble.h>
+#include <rcsc/action/body_kick_multi_step.h>
+#include <rcsc/action/intention_kick.h>
+#include <rcsc/action/kick_oracle.h>
+#include <rcsc/action/neck_turn_to_low_conf_teammate.h>
+#include <rcsc/action/reach_field.h>
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/debug_client.h>
+#include <rcsc/player/say_message_builder.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/math_util.h>
+#include <rcsc/timer.h>
+
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+namespace {
+
+//! the max ball travel steps simulated by the reach model
+const int MAX_REACH_STEP = 15;
+
+//! min score to accept the best candidate
+const double MIN_SCORE = 0.05;
+
+//! min success rate to accept the candidate
+const double MIN_SUCCESS_RATE = 0.8;
+
+/*-------------------------------------------------------------------*/
+/*!
+  convert the reach margin to the success probability
+*/
+inline
+double
+success_rate( const double & margin )
+{
+    return 1.0 / ( 1.0 + std::exp( -2.0 * margin ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct StepCmp
+  \brief compare the evaluation cost of candidates
+*/
+struct StepCmp
+    : public std::binary_function< Obake_ActionEvaluator::Candidate,
+                                   Obake_ActionEvaluator::Candidate,
+                                   bool > {
+    result_type operator()( const first_argument_type & lhs,
+                            const second_argument_type & rhs ) const
+      {
+          return lhs.step_ < rhs.step_;
+      }
+};
+
+}
+
+const int Obake_ActionEvaluator::MAX_OPPONENT;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Obake_ActionEvaluator::Obake_ActionEvaluator()
+    : M_enabled( false )
+    , M_time( -1, 0 )
+    , M_opponent_size( 0 )
+    , M_best( -1 )
+{
+    M_candidates.reserve( 128 );
+
+    for ( int i = 0; i < MAX_TYPE; ++i )
+    {
+        M_count[i] = 0;
+        M_msec[i] = 0.0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Obake_ActionEvaluator &
+Obake_ActionEvaluator::instance()
+{
+    static Obake_ActionEvaluator s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+Obake_ActionEvaluator::type_name( const Type type )
+{
+    static const char * names[] = { "pass",
+                                    "dribble",
+                                    "shoot",
+                                    "hold",
+                                    "clear",
+                                    "" };
+
+    if ( type < PASS || MAX_TYPE <= type )
+    {
+        return names[MAX_TYPE];
+    }
+
+    return names[type];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const
+Obake_ActionEvaluator::Candidate *
+Obake_ActionEvaluator::search( rcsc::PlayerAgent * agent,
+                               const double & time_budget )
+{
+    const rcsc::WorldModel & wm = agent->world();
+
+    if ( M_time == wm.time() )
+    {
+        return ( M_best >= 0 ? &M_candidates[M_best] : NULL );
+    }
+    M_time = wm.time();
+    M_best = -1;
+    M_candidates.clear();
+
+    for ( int i = 0; i < MAX_TYPE; ++i )
+    {
+        M_count[i] = 0;
+        M_msec[i] = 0.0;
+    }
+
+    if ( ! wm.self().isKickable() )
+    {
+        return NULL;
+    }
+
+    const rcsc::MSecTimer timer;
+
+    updateOpponents( wm );
+    createCandidates( wm );
+
+    const rcsc::KickOracle & oracle = rcsc::KickOracle::get( wm );
+    const rcsc::ReachField & field = rcsc::ReachField::get( wm );
+
+    double best_score = MIN_SCORE;
+    int skipped = 0;
+    double last_msec = timer.elapsedReal();
+
+    const int size = M_candidates.size();
+    for ( int i = 0; i < size; ++i )
+    {
+        if ( last_msec > time_budget )
+        {
+            skipped = size - i;
+            break;
+        }
+
+        Candidate & c = M_candidates[i];
+        evaluate( wm, oracle, field, c );
+
+        const double msec = timer.elapsedReal();
+        M_count[c.type_] += 1;
+        M_msec[c.type_] += msec - last_msec;
+        last_msec = msec;
+
+        rcsc::dlog.addText( rcsc::Logger::ACTION,
+                            "__ %s (%.1f %.1f) speed=%.2f unum=%d step=%d success=%.3f score=%.3f",
+                            type_name( c.type_ ),
+                            c.target_.x, c.target_.y,
+                            c.first_speed_, c.receiver_, c.step_,
+                            c.success_, c.score_ );
+
+        if ( c.success_ >= MIN_SUCCESS_RATE
+             && c.score_ > best_score )
+        {
+            best_score = c.score_;
+            M_best = i;
+        }
+    }
+
+    for ( int i = 0; i < MAX_TYPE; ++i )
+    {
+        rcsc::dlog.addText( rcsc::Logger::TEAM,
+                            "%s:%d: evaluator %s count=%d time=%.3f[ms]"
+                            ,__FILE__, __LINE__,
+                            type_name( static_cast< Type >( i ) ),
+                            M_count[i], M_msec[i] );
+    }
+
+    rcsc::dlog.addText( rcsc::Logger::TEAM,
+                        "%s:%d: evaluator total=%d skipped=%d time=%.3f[ms]"
+                        ,__FILE__, __LINE__,
+                        size, skipped, timer.elapsedReal() );
+
+    if ( M_best < 0 )
+    {
+        return NULL;
+    }
+
+    const Candidate & best = M_candidates[M_best];
+    rcsc::dlog.addText( rcsc::Logger::TEAM,
+                        "%s:%d: evaluator best %s (%.1f %.1f) speed=%.2f score=%.3f"
+                        ,__FILE__, __LINE__,
+                        type_name( best.type_ ),
+                        best.target_.x, best.target_.y,
+                        best.first_speed_, best.score_ );
+
+    return &best;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Obake_ActionEvaluator::execute( rcsc::PlayerAgent * agent )
+{
+    if ( ! M_enabled )
+    {
+        return false;
+    }
+
+    const Candidate * best = search( agent );
+
+    // holding is left to the old decision
+    if ( ! best
+         || best->type_ == HOLD )
+    {
+        return false;
+    }
+
+    const rcsc::WorldModel & wm = agent->world();
+
+    agent->debugClient().addMessage( "Eval:%s", type_name( best->type_ ) );
+    agent->debugClient().setTarget( best->target_ );
+
+    switch ( best->type_ ) {
+    case PASS:
+        rcsc::Body_KickMultiStep( best->target_,
+                                  best->first_speed_,
+                                  false
+                                  ).execute( agent );
+        if ( wm.gameMode().type() != rcsc::GameMode::PlayOn )
+        {
+            agent->setIntention
+                ( new rcsc::IntentionKick( best->target_,
+                                           best->first_speed_,
+                                           3, // max kick step
+                                           false, // not enforce
+                                           wm.time() ) );
+        }
+        if ( agent->config().useCommunication()
+             && best->receiver_ != rcsc::Unum_Unknown )
+        {
+            rcsc::Vector2D target_buf = best->target_ - wm.self().pos();
+            target_buf.setLength( 1.0 );
+
+            agent->addSayMessage( new rcsc::PassMessage( best->receiver_,
+                                                         best->target_ + target_buf,
+                                                         agent->effector().queuedNextBallPos(),
+                                                         agent->effector().queuedNextBallVel() ) );
+        }
+        break;
+    case SHOOT:
+    case CLEAR:
+        rcsc::Body_KickMultiStep( best->target_,
+                                  best->first_speed_,
+                                  false
+                                  ).execute( agent );
+        break;
+    case DRIBBLE:
+        rcsc::Body_Dribble( best->target_,
+                            1.0,
+                            Bhv_ObakeActionStrategy().getDashPower( agent,
+                                                                     best->target_ ),
+                            1
+                            ).execute( agent );
+        break;
+    default:
+        return false;
+    }
+
+    agent->setNeckAction( new rcsc::Neck_TurnToLowConfTeammate() );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+Obake_ActionEvaluator::opponentReachMargin( const rcsc::Vector2D & ball_pos,
+                                            const rcsc::Vector2D & ball_vel,
+                                            const int max_step ) const
+{
+    const double decay = rcsc::ServerParam::i().ballDecay();
+
+    rcsc::Vector2D pos = ball_pos;
+    rcsc::Vector2D vel = ball_vel;
+    double margin = 1000.0;
+
+    for ( int n = 1; n <= max_step; ++n )
+    {
+        pos += vel;
+        vel *= decay;
+
+        // one step is used to turn to the ball
+        const double move = static_cast< double >( std::max( 0, n - 1 ) );
+
+        for ( int i = 0; i < M_opponent_size; ++i )
+        {
+            const Opponent & o = M_opponents[i];
+            const double reach = o.control_ + o.error_ + o.speed_max_ * move;
+            margin = std::min( margin, o.pos_.dist( pos ) - reach );
+        }
+    }
+
+    return margin;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Obake_ActionEvaluator::updateOpponents( const rcsc::WorldModel & wm )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    M_opponent_size = 0;
+
+    const rcsc::PlayerPtrCont::const_iterator end = wm.opponentsFromSelf().end();
+    for ( rcsc::PlayerPtrCont::const_iterator o = wm.opponentsFromSelf().begin();
+          o != end && M_opponent_size < MAX_OPPONENT;
+          ++o )
+    {
+        if ( (*o)->isGhost()
+             || (*o)->posCount() > 10 )
+        {
+            continue;
+        }
+
+        const rcsc::PlayerType * ptype = (*o)->playerTypePtr();
+
+        Opponent & opp = M_opponents[M_opponent_size];
+        opp.pos_ = (*o)->pos() + (*o)->vel();
+        opp.speed_max_ = ( ptype
+                           ? ptype->playerSpeedMax()
+                           : SP.defaultPlayerSpeedMax() );
+        opp.control_ = ( ptype
+                         ? ptype->kickableArea()
+                         : SP.defaultKickableArea() );
+        if ( (*o)->goalie()
+             && opp.pos_.x > SP.theirPenaltyAreaLineX()
+             && opp.pos_.absY() < SP.penaltyAreaHalfWidth() )
+        {
+            opp.control_ = SP.catchableArea();
+        }
+        opp.error_ = std::min( (*o)->posCount(), 3 ) * opp.speed_max_ * 0.5;
+
+        ++M_opponent_size;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Obake_ActionEvaluator::createCandidates( const rcsc::WorldModel & wm )
+{
+    M_candidates.push_back( Candidate( HOLD, wm.ball().pos(), 0.0, -1, 0 ) );
+
+    createShoot( wm );
+    createPass( wm );
+    createDribble( wm );
+    createClear( wm );
+
+    // the reach model simulates the ball for each step.
+    // cheap candidates are evaluated first, so that the time budget never
+    // leaves the agent without a candidate.
+    std::stable_sort( M_candidates.begin(), M_candidates.end(), StepCmp() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Obake_ActionEvaluator::createPass( const rcsc::WorldModel & wm )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const double decay = SP.ballDecay();
+    const rcsc::Vector2D ball_pos = wm.ball().pos();
+    const rcsc::Vector2D goal( SP.pitchHalfLength(), 0.0 );
+
+    const rcsc::PlayerPtrCont::const_iterator end = wm.teammatesFromSelf().end();
+    for ( rcsc::PlayerPtrCont::const_iterator t = wm.teammatesFromSelf().begin();
+          t != end;
+          ++t )
+    {
+        if ( (*t)->isGhost()
+             || (*t)->posCount() > 5
+             || (*t)->unum() == rcsc::Unum_Unknown
+             || (*t)->goalie() )
+        {
+            continue;
+        }
+
+        const rcsc::Vector2D receiver_pos = (*t)->pos() + (*t)->vel();
+        const double receiver_dist = receiver_pos.dist( ball_pos );
+        if ( receiver_dist < 3.0
+             || 35.0 < receiver_dist )
+        {
+            continue;
+        }
+
+        const rcsc::PlayerType * ptype = (*t)->playerTypePtr();
+        const double speed_max = ( ptype
+                                   ? ptype->playerSpeedMax()
+                                   : SP.defaultPlayerSpeedMax() );
+        const double kickable = ( ptype
+                                  ? ptype->kickableArea()
+                                  : SP.defaultKickableArea() );
+
+        // direct pass and two lead passes to the goal direction
+        const rcsc::AngleDeg lead_angle = ( goal - receiver_pos ).th();
+        const double lead_dist[] = { 0.0, 3.0, 6.0 };
+        const double end_speed[] = { 1.5, 1.2, 1.0 };
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            const rcsc::Vector2D target
+                = receiver_pos + rcsc::Vector2D::polar2vector( lead_dist[i],
+                                                               lead_angle );
+            if ( target.absX() > SP.pitchHalfLength() - 1.0
+                 || target.absY() > SP.pitchHalfWidth() - 1.0 )
+            {
+                continue;
+            }
+
+            const double dist = target.dist( ball_pos );
+            const double first_speed
+                = std::min( SP.ballSpeedMax(),
+                            rcsc::calc_first_term_geom_series_last( end_speed[i],
+                                                                    dist,
+                                                                    decay ) );
+            const double len = rcsc::calc_length_geom_series( first_speed,
+                                                              dist,
+                                                              decay );
+            if ( len < 0.0 )
+            {
+                continue;
+            }
+
+            const int step = static_cast< int >( std::ceil( len ) );
+
+            // the receiver must arrive before the ball
+            if ( lead_dist[i] > kickable + speed_max * step )
+            {
+                continue;
+            }
+
+            M_candidates.push_back( Candidate( PASS, target, first_speed,
+                                               (*t)->unum(), step ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Obake_ActionEvaluator::createDribble( const rcsc::WorldModel & wm )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const double dist = 5.0;
+    const double speed = wm.self().playerType().playerSpeedMax() * 0.9;
+    // one step for the first kick
+    const int step = static_cast< int >( std::ceil( dist / speed ) ) + 1;
+
+    for ( int i = 0; i < 12; ++i )
+    {
+        const rcsc::Vector2D target
+            = wm.self().pos() + rcsc::Vector2D::polar2vector( dist, -180.0 + 30.0 * i );
+        if ( target.absX() > SP.pitchHalfLength() - 1.0
+             || target.absY() > SP.pitchHalfWidth() - 1.0 )
+        {
+            continue;
+        }
+
+        M_candidates.push_back( Candidate( DRIBBLE, target, 0.0, -1, step ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Obake_ActionEvaluator::createShoot( const rcsc::WorldModel & wm )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const rcsc::Vector2D ball_pos = wm.ball().pos();
+
+    if ( ball_pos.dist( rcsc::Vector2D( SP.pitchHalfLength(), 0.0 ) ) > 25.0 )
+    {
+        return;
+    }
+
+    const double first_speed = SP.ballSpeedMax();
+    const double max_y = SP.goalHalfWidth() - 0.8;
+
+    for ( double y = -max_y; y <= max_y + 0.001; y += max_y / 3.0 )
+    {
+        const rcsc::Vector2D target( SP.pitchHalfLength(), y );
+        const double len = rcsc::calc_length_geom_series( first_speed,
+                                                          target.dist( ball_pos ),
+                                                          SP.ballDecay() );
+        if ( len < 0.0 )
+        {
+            continue;
+        }
+
+        M_candidates.push_back( Candidate( SHOOT, target, first_speed, -1,
+                                           static_cast< int >( std::ceil( len ) ) ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Obake_ActionEvaluator::createClear( const rcsc::WorldModel & wm )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const rcsc::Vector2D ball_pos = wm.ball().pos();
+
+    if ( ball_pos.x > 0.0 )
+    {
+        return;
+    }
+
+    const double first_speed = SP.ballSpeedMax();
+    const double dist = 30.0;
+    const double len = rcsc::calc_length_geom_series( first_speed, dist,
+                                                      SP.ballDecay() );
+    const int step = ( len < 0.0
+                       ? MAX_REACH_STEP
+                       : static_cast< int >( std::ceil( len ) ) );
+
+    for ( double dir = -60.0; dir <= 60.0; dir += 15.0 )
+    {
+        rcsc::Vector2D target = ball_pos + rcsc::Vector2D::polar2vector( dist, dir );
+        target.y = std::min( std::max( target.y, -SP.pitchHalfWidth() + 2.0 ),
+                             SP.pitchHalfWidth() - 2.0 );
+
+        M_candidates.push_back( Candidate( CLEAR, target, first_speed, -1, step ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Obake_ActionEvaluator::evaluate( const rcsc::WorldModel & wm,
+                                 const rcsc::KickOracle & oracle,
+                                 const rcsc::ReachField & field,
+                                 Candidate & candidate ) const
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const rcsc::Vector2D ball_pos = wm.ball().pos();
+    const int max_step = std::min( std::max( candidate.step_, 1 ),
+                                   MAX_REACH_STEP );
+
+    double margin = 0.0;
+    double value = 0.0;
+    double dominance = 1000.0;
+
+    switch ( candidate.type_ ) {
+    case HOLD:
+        margin = opponentReachMargin( ball_pos, rcsc::Vector2D( 0.0, 0.0 ), 2 )
+            + wm.self().playerType().kickableArea();
+        value = 0.5 * positionValue( ball_pos );
+        break;
+    case DRIBBLE:
+        {
+            const rcsc::Vector2D move = candidate.target_ - ball_pos;
+            const double first_speed
+                = rcsc::calc_first_term_geom_series( move.r(),
+                                                     SP.ballDecay(),
+                                                     max_step );
+            // the dribbler keeps the ball within the kickable area
+            margin = opponentReachMargin( ball_pos,
+                                          rcsc::Vector2D::polar2vector( first_speed,
+                                                                        move.th() ),
+                                          max_step )
+                + wm.self().playerType().kickableArea();
+            value = 0.9 * positionValue( candidate.target_ );
+        }
+        break;
+    case PASS:
+    case SHOOT:
+    case CLEAR:
+        {
+            const rcsc::AngleDeg angle = ( candidate.target_ - ball_pos ).th();
+            const double one_step_speed = oracle.maxSpeed( angle );
+
+            margin = opponentReachMargin( ball_pos,
+                                          rcsc::Vector2D::polar2vector( candidate.first_speed_,
+                                                                        angle ),
+                                          max_step );
+
+            // opponents approach while the ball is accelerated by multiple kicks
+            if ( candidate.first_speed_ > one_step_speed )
+            {
+                margin -= SP.defaultPlayerSpeedMax()
+                    * ( one_step_speed < candidate.first_speed_ * 0.5 ? 2.0 : 1.0 );
+            }
+
+            // our team must control the ball before their team at the end point
+            if ( candidate.type_ != SHOOT )
+            {
+                dominance = field.theirStep( candidate.target_ )
+                    - std::max( static_cast< double >( candidate.step_ ),
+                                field.ourStep( candidate.target_ ) );
+            }
+
+            if ( candidate.type_ == PASS )
+            {
+                value = positionValue( candidate.target_ );
+            }
+            else if ( candidate.type_ == SHOOT )
+            {
+                value = 1.5;
+            }
+            else
+            {
+                value = 0.2 + 0.3 * positionValue( candidate.target_ );
+            }
+        }
+        break;
+    default:
+        candidate.score_ = 0.0;
+        return;
+    }
+
+    candidate.success_ = success_rate( margin ) * success_rate( dominance );
+    candidate.score_ = candidate.success_ * value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+Obake_ActionEvaluator::positionValue( const rcsc::Vector2D & pos )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    const double x_rate = std::min( 1.0,
+                                    std::max( 0.0,
+                                              ( pos.x + SP.pitchHalfLength() )
+                                              / SP.pitchLength() ) );
+    const double goal_dist = pos.dist( rcsc::Vector2D( SP.pitchHalfLength(), 0.0 ) );
+
+    return 0.6 * x_rate + 0.4 * std::exp( -goal_dist / 15.0 );
+}
@@ -0,0 +1,292 @@
+// -*-c++-*-
+
+/*!
+  \file obake_action_evaluator.h
+  \brief unified on-ball action candidate evaluator Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef OBAKE_ACTION_EVALUATOR_H
+#define OBAKE_ACTION_EVALUATOR_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+#include <vector>
+
+namespace rcsc {
+class PlayerAgent;
+class WorldModel;
+class KickOracle;
+class ReachField;
+}
+
+/*!
+  \class Obake_ActionEvaluator
+  \brief one pipeline to generate and evaluate all on-ball actions.
+
+  Pass, dribble, shoot, hold and clear candidates are stored in one
+  flat array and evaluated by the same opponent reach model and the
+  same one step kick envelope. The opponent snapshot is taken once per
+  cycle, so each candidate costs only a few array scans.
+
+  Candidates are evaluated in the order of the number of simulated
+  ball steps. The evaluation stops when the time budget is consumed,
+  and the best candidate found by then is used.
+
+  The evaluator is disabled by default. If enabled, it replaces the
+  old decision only by a pass, shoot, dribble or clear whose success
+  rate exceeds the threshold.
+ */
+class Obake_ActionEvaluator {
+public:
+
+    /*!
+      \enum Type
+      \brief action type id
+     */
+    enum Type {
+        PASS,
+        DRIBBLE,
+        SHOOT,
+        HOLD,
+        CLEAR,
+        MAX_TYPE
+    };
+
+    /*!
+      \struct Candidate
+      \brief one action candidate
+     */
+    struct Candidate {
+        Type type_; //!< action type id
+        rcsc::Vector2D target_; //!< ball target point or dribble target
+        double first_speed_; //!< ball first speed. 0 for dribble and hold
+        int receiver_; //!< receiver's uniform number, or -1
+        int step_; //!< estimated ball travel steps
+        double success_; //!< estimated success rate
+        double score_; //!< evaluated value. negative if not evaluated
+
+        /*!
+          \brief construct with all values
+         */
+        Candidate( const Type type,
+                   const rcsc::Vector2D & target,
+                   const double & first_speed,
+                   const int receiver,
+                   const int step )
+            : type_( type )
+            , target_( target )
+            , first_speed_( first_speed )
+            , receiver_( receiver )
+            , step_( step )
+            , success_( 0.0 )
+            , score_( -1.0 )
+          { }
+    };
+
+    //! the max number of opponents in the snapshot
+    static const int MAX_OPPONENT = 11;
+
+private:
+
+    //! if false, execute() does nothing
+    bool M_enabled;
+
+    /*!
+      \struct Opponent
+      \brief opponent state used by the reach model
+     */
+    struct Opponent {
+        rcsc::Vector2D pos_; //!< estimated position in the next cycle
+        double speed_max_; //!< max speed of the player type
+        double control_; //!< kickable or catchable area
+        double error_; //!< position uncertainty
+    };
+
+    //! last evaluated time
+    rcsc::GameTime M_time;
+
+    //! opponent snapshot
+    Opponent M_opponents[MAX_OPPONENT];
+    //! the number of opponents in the snapshot
+    int M_opponent_size;
+
+    //! all candidates of the current cycle
+    std::vector< Candidate > M_candidates;
+    //! index of the best candidate, or -1
+    int M_best;
+
+    //! the number of evaluated candidates for each type
+    int M_count[MAX_TYPE];
+    //! evaluation time [msec] for each type
+    double M_msec[MAX_TYPE];
+
+    /*!
+      \brief private for singleton
+     */
+    Obake_ActionEvaluator();
+
+    // not used
+    Obake_ActionEvaluator( const Obake_ActionEvaluator & );
+    Obake_ActionEvaluator & operator=( const Obake_ActionEvaluator & );
+
+public:
+
+    /*!
+      \brief get the singleton instance
+      \return reference to the instance
+     */
+    static
+    Obake_ActionEvaluator & instance();
+
+    /*!
+      \brief get the action type name
+      \param type action type id
+      \return name string
+     */
+    static
+    const char * type_name( const Type type );
+
+    /*!
+      \brief set the switch of the evaluator
+      \param on if true, execute() performs the best candidate
+     */
+    void setEnabled( const bool on )
+      {
+          M_enabled = on;
+      }
+
+    /*!
+      \brief get the switch of the evaluator
+      \return true if the evaluator is enabled
+     */
+    bool enabled() const
+      {
+          return M_enabled;
+      }
+
+    /*!
+      \brief generate and evaluate all candidates for the current cycle
+      \param agent pointer to the agent itself
+      \param time_budget max evaluation time [msec]
+      \return pointer to the best candidate, or NULL
+     */
+    const
+    Candidate * search( rcsc::PlayerAgent * agent,
+                        const double & time_budget = 2.0 );
+
+    /*!
+      \brief perform the best candidate
+      \param agent pointer to the agent itself
+      \return true if action is performed. false if the evaluator is
+      disabled or the best candidate is hold.
+     */
+    bool execute( rcsc::PlayerAgent * agent );
+
+    /*!
+      \brief get all candidates of the last search
+      \return const reference to the container
+     */
+    const
+    std::vector< Candidate > & candidates() const
+      {
+          return M_candidates;
+      }
+
+    /*!
+      \brief get the reach margin of the fastest opponent
+      \param ball_pos ball first position
+      \param ball_vel ball first velocity
+      \param max_step the number of simulated steps
+      \return the min distance between the ball and the opponent
+      reachable area over all steps. negative if an opponent can get the ball.
+     */
+    double opponentReachMargin( const rcsc::Vector2D & ball_pos,
+                                const rcsc::Vector2D & ball_vel,
+                                const int max_step ) const;
+
+private:
+
+    /*!
+      \brief take the opponent snapshot
+      \param wm const reference to the world model
+     */
+    void updateOpponents( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief create all candidates
+      \param wm const reference to the world model
+     */
+    void createCandidates( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief create pass candidates
+      \param wm const reference to the world model
+     */
+    void createPass( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief create dribble candidates
+      \param wm const reference to the world model
+     */
+    void createDribble( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief create shoot candidates
+      \param wm const reference to the world model
+     */
+    void createShoot( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief create clear candidates
+      \param wm const reference to the world model
+     */
+    void createClear( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief evaluate one candidate
+      \param wm const reference to the world model
+      \param oracle const reference to the kick envelope
+      \param field const reference to the reach time field
+      \param candidate reference to the evaluated candidate
+     */
+    void evaluate( const rcsc::WorldModel & wm,
+                   const rcsc::KickOracle & oracle,
+                   const rcsc::ReachField & field,
+                   Candidate & candidate ) const;
+
+    /*!
+      \brief get the positional value of the ball position
+      \param pos ball position
+      \return value in [0,1]
+     */
+    static
+    double positionValue( const rcsc::Vector2D & pos );
+
+};
+
+#endif
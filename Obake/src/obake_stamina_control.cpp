@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/player/intercept_table.h>
+#include <rcsc/player/stamina_planner.h>
 
 #include "obake_analysis.h"
 #include "obake_fuzzy_grade.h"
@@ -73,7 +74,14 @@ Obake_StaminaControl::getOffensiveDashPower(rcsc::PlayerAgent * agent)
         rate = std::max(rate, fourth_rate);
     }  
     const double dash_power = rcsc::ServerParam::i().maxPower() * rate;
-    return dash_power;
+
+    // the role is needed by the stamina budget
+    Obake_Analysis().setRole(wm.self().unum(),
+                             M_role_side_or_center_back,
+                             M_role_deffensive_half,
+                             M_role_offensive_half,
+                             M_role_side_or_center_forward);
+    return limitDashPower(agent, dash_power);
 }
 
 
@@ -116,7 +124,7 @@ Obake_StaminaControl::getDeffensiveDashPower(rcsc::PlayerAgent * agent)
                         "%s:%d: dash_power=%.2f"
                         ,__FILE__, __LINE__,
                         dash_power);
-    return dash_power;
+    return limitDashPower(agent, dash_power);
 }
 
 double
@@ -228,3 +236,47 @@ Obake_StaminaControl::getDeffensiveSlowDashRate(rcsc::PlayerAgent * agent)
                         slow_rate);
     return slow_rate;
 }
+
+/*!
+This function returns the ratio of the cycles
+that the player of this role dashes
+*/
+double
+Obake_StaminaControl::getRoleDashDemand() const
+{
+    if(M_role_side_or_center_back)
+    {
+        return 0.5;
+    }
+    if(M_role_deffensive_half
+       || M_role_offensive_half)
+    {
+        return 0.7;
+    }
+    if(M_role_side_or_center_forward)
+    {
+        return 0.6;
+    }
+    return 0.6;
+}
+
+/*!
+This function limits dash power by the stamina budget
+for the rest of the half
+*/
+double
+Obake_StaminaControl::limitDashPower(rcsc::PlayerAgent * agent,
+                                     const double & dash_power)
+{
+    static rcsc::StaminaPlanner s_planner;
+
+    const rcsc::WorldModel & wm = agent->world();
+    s_planner.update(wm, getRoleDashDemand());
+
+    const double budget = s_planner.dashPower(wm.self().stamina());
+    rcsc::dlog.addText( rcsc::Logger::TEAM,
+                        "%s:%d: dash_power=%.2f budget=%.2f"
+                        ,__FILE__, __LINE__,
+                        dash_power, budget);
+    return std::min(dash_power, budget);
+}
@@ -47,6 +47,10 @@ public:
     double getDeffensiveFastDashRate(rcsc::PlayerAgent * agent);
     double getDeffensiveModerateDashRate(rcsc::PlayerAgent * agent);
     double getDeffensiveSlowDashRate(rcsc::PlayerAgent * agent);
+private:
+    double getRoleDashDemand() const;
+    double limitDashPower(rcsc::PlayerAgent * agent,
+                          const double & dash_power);
 };
 
 #endif
@@ -0,0 +1,728 @@
+// -*-c++-*-
+
+/*!
+  \file penalty_table.cpp
+  \brief penalty shootout shot and goalie tables Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "penalty_table.h"
+
+#include <rcsc/common/server_param.h>
+
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+
+namespace {
+
+//! the number of ball cells
+const int BALL_CELLS = PenaltyTable::BALL_X_SIZE * PenaltyTable::BALL_Y_SIZE;
+//! the number of goalie cells
+const int GOALIE_CELLS = PenaltyTable::GOALIE_X_SIZE * PenaltyTable::GOALIE_Y_SIZE;
+
+//! margin value for shots that never reach the goal line
+const double NO_SHOT = -1000.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+  simple linear congruential generator for the batch evaluation.
+  \return random value in [0,1)
+*/
+inline
+double
+random_rate( unsigned long & state )
+{
+    state = state * 1103515245UL + 12345UL;
+    return static_cast< double >( ( state >> 16 ) & 0x7fff ) / 32768.0;
+}
+
+}
+
+const int PenaltyTable::VERSION;
+const int PenaltyTable::PARAM_SIZE;
+const int PenaltyTable::BALL_X_SIZE;
+const int PenaltyTable::BALL_Y_SIZE;
+const double PenaltyTable::BALL_STEP = 2.0;
+const int PenaltyTable::GOALIE_X_SIZE;
+const int PenaltyTable::GOALIE_Y_SIZE;
+const double PenaltyTable::GOALIE_STEP = 1.0;
+const int PenaltyTable::SPEED_BINS;
+const int PenaltyTable::TARGET_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PenaltyTable::PenaltyTable()
+    : M_ready( false )
+{
+    for ( int i = 0; i < PARAM_SIZE; ++i )
+    {
+        M_params[i] = 0.0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PenaltyTable &
+PenaltyTable::instance()
+{
+    static PenaltyTable s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PenaltyTable::matchServerParam() const
+{
+    if ( ! M_ready )
+    {
+        return false;
+    }
+
+    double params[PARAM_SIZE];
+    current_params( params );
+
+    for ( int i = 0; i < PARAM_SIZE; ++i )
+    {
+        if ( std::fabs( params[i] - M_params[i] ) > 1.0e-4 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PenaltyTable::build()
+{
+    const rcsc::Vector2D goal_c( rcsc::ServerParam::i().pitchHalfLength(), 0.0 );
+
+    current_params( M_params );
+
+    M_shot_target.assign( SPEED_BINS * BALL_CELLS * GOALIE_CELLS, -1 );
+    M_shot_margin.assign( SPEED_BINS * BALL_CELLS * GOALIE_CELLS, NO_SHOT );
+    M_goalie_cell.assign( SPEED_BINS * BALL_CELLS, -1 );
+
+    rcsc::Vector2D targets[TARGET_SIZE];
+    for ( int t = 0; t < TARGET_SIZE; ++t )
+    {
+        targets[t] = target_point( t );
+    }
+
+    for ( int bin = 0; bin < SPEED_BINS; ++bin )
+    {
+        const double speed = bin_speed( bin );
+
+        for ( int b = 0; b < BALL_CELLS; ++b )
+        {
+            const rcsc::Vector2D ball = ball_cell( b / BALL_Y_SIZE, b % BALL_Y_SIZE );
+            const int base = ( bin * BALL_CELLS + b ) * GOALIE_CELLS;
+
+            //
+            // kicker: the best target for each goalie position
+            //
+            for ( int g = 0; g < GOALIE_CELLS; ++g )
+            {
+                const rcsc::Vector2D goalie = goalie_cell( g / GOALIE_Y_SIZE,
+                                                           g % GOALIE_Y_SIZE );
+                for ( int t = 0; t < TARGET_SIZE; ++t )
+                {
+                    const double margin = simulate( ball, goalie, targets[t], speed );
+                    if ( margin > M_shot_margin[base + g] )
+                    {
+                        M_shot_target[base + g] = static_cast< signed char >( t );
+                        M_shot_margin[base + g] = static_cast< float >( margin );
+                    }
+                }
+            }
+
+            //
+            // goalie: the position that minimizes the kicker's best margin.
+            // the goalie must stay between the ball and the goal line
+            // and must not be so close that the kicker can dribble around.
+            //
+            double best_margin = 1000.0;
+            double best_dist = 1000.0;
+            for ( int g = 0; g < GOALIE_CELLS; ++g )
+            {
+                const rcsc::Vector2D goalie = goalie_cell( g / GOALIE_Y_SIZE,
+                                                           g % GOALIE_Y_SIZE );
+                if ( goalie.x < ball.x + 1.0
+                     || goalie.dist( ball ) < 4.0 )
+                {
+                    continue;
+                }
+
+                const double margin = M_shot_margin[base + g];
+                const double dist = goalie.dist( goal_c );
+                if ( margin < best_margin - 1.0e-3
+                     || ( margin < best_margin + 1.0e-3
+                          && dist < best_dist ) )
+                {
+                    best_margin = margin;
+                    best_dist = dist;
+                    M_goalie_cell[bin * BALL_CELLS + b] = static_cast< short >( g );
+                }
+            }
+        }
+    }
+
+    M_ready = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PenaltyTable::read( const std::string & filepath )
+{
+    std::ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** failed to open the penalty table ["
+                  << filepath << "]" << std::endl;
+        return false;
+    }
+
+    std::string tag;
+    int version = 0;
+    int bx = 0, by = 0, gx = 0, gy = 0, bins = 0, targets = 0;
+
+    if ( ! ( fin >> tag >> version )
+         || tag != "penalty_table"
+         || version != VERSION
+         || ! ( fin >> tag >> bx >> by >> gx >> gy >> bins >> targets )
+         || tag != "grid"
+         || bx != BALL_X_SIZE || by != BALL_Y_SIZE
+         || gx != GOALIE_X_SIZE || gy != GOALIE_Y_SIZE
+         || bins != SPEED_BINS || targets != TARGET_SIZE )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** unsupported penalty table header ["
+                  << filepath << "]" << std::endl;
+        return false;
+    }
+
+    double params[PARAM_SIZE];
+    if ( ! ( fin >> tag ) || tag != "param" )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** no server parameters [" << filepath << "]"
+                  << std::endl;
+        return false;
+    }
+
+    for ( int i = 0; i < PARAM_SIZE; ++i )
+    {
+        if ( ! ( fin >> params[i] ) )
+        {
+            std::cerr << __FILE__ << ":" << __LINE__
+                      << " ***ERROR*** illegal server parameter " << i
+                      << " [" << filepath << "]" << std::endl;
+            return false;
+        }
+    }
+
+    std::vector< signed char > shot_target( SPEED_BINS * BALL_CELLS * GOALIE_CELLS );
+    std::vector< float > shot_margin( SPEED_BINS * BALL_CELLS * GOALIE_CELLS );
+    std::vector< short > goalie_cell( SPEED_BINS * BALL_CELLS );
+
+    if ( ! ( fin >> tag ) || tag != "shot" )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** no shot table [" << filepath << "]"
+                  << std::endl;
+        return false;
+    }
+
+    for ( std::size_t i = 0; i < shot_target.size(); ++i )
+    {
+        int t = 0;
+        double m = 0.0;
+        if ( ! ( fin >> t >> m )
+             || t < -1 || TARGET_SIZE <= t )
+        {
+            std::cerr << __FILE__ << ":" << __LINE__
+                      << " ***ERROR*** illegal shot element " << i
+                      << " [" << filepath << "]" << std::endl;
+            return false;
+        }
+        shot_target[i] = static_cast< signed char >( t );
+        shot_margin[i] = static_cast< float >( m );
+    }
+
+    if ( ! ( fin >> tag ) || tag != "goalie" )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** no goalie table [" << filepath << "]"
+                  << std::endl;
+        return false;
+    }
+
+    for ( std::size_t i = 0; i < goalie_cell.size(); ++i )
+    {
+        int g = 0;
+        if ( ! ( fin >> g )
+             || g < -1 || GOALIE_CELLS <= g )
+        {
+            std::cerr << __FILE__ << ":" << __LINE__
+                      << " ***ERROR*** illegal goalie element " << i
+                      << " [" << filepath << "]" << std::endl;
+            return false;
+        }
+        goalie_cell[i] = static_cast< short >( g );
+    }
+
+    M_shot_target.swap( shot_target );
+    M_shot_margin.swap( shot_margin );
+    M_goalie_cell.swap( goalie_cell );
+    for ( int i = 0; i < PARAM_SIZE; ++i )
+    {
+        M_params[i] = params[i];
+    }
+    M_ready = true;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+PenaltyTable::write( std::ostream & os ) const
+{
+    if ( ! M_ready )
+    {
+        return os;
+    }
+
+    os << "penalty_table " << VERSION << '\n'
+       << "grid " << BALL_X_SIZE << ' ' << BALL_Y_SIZE << ' '
+       << GOALIE_X_SIZE << ' ' << GOALIE_Y_SIZE << ' '
+       << SPEED_BINS << ' ' << TARGET_SIZE << '\n';
+
+    os << "param";
+    for ( int i = 0; i < PARAM_SIZE; ++i )
+    {
+        os << ' ' << M_params[i];
+    }
+    os << '\n';
+
+    // one line for each (bin, ball cell)
+    os << "shot\n";
+    char buf[32];
+    for ( int i = 0; i < SPEED_BINS * BALL_CELLS; ++i )
+    {
+        for ( int g = 0; g < GOALIE_CELLS; ++g )
+        {
+            const int idx = i * GOALIE_CELLS + g;
+            std::snprintf( buf, 32, "%s%d %.2f",
+                      ( g == 0 ? "" : " " ),
+                      static_cast< int >( M_shot_target[idx] ),
+                      M_shot_margin[idx] );
+            os << buf;
+        }
+        os << '\n';
+    }
+
+    // one line for each bin
+    os << "goalie\n";
+    for ( int bin = 0; bin < SPEED_BINS; ++bin )
+    {
+        for ( int b = 0; b < BALL_CELLS; ++b )
+        {
+            if ( b != 0 ) os << ' ';
+            os << M_goalie_cell[bin * BALL_CELLS + b];
+        }
+        os << '\n';
+    }
+
+    return os << std::flush;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PenaltyTable::speed_bin( const double & speed_max )
+{
+    int best = 0;
+    double min_diff = 1000.0;
+    for ( int bin = 0; bin < SPEED_BINS; ++bin )
+    {
+        const double diff = std::fabs( speed_max - bin_speed( bin ) );
+        if ( diff < min_diff )
+        {
+            min_diff = diff;
+            best = bin;
+        }
+    }
+
+    return best;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PenaltyTable::getShot( const rcsc::Vector2D & ball_pos,
+                       const rcsc::Vector2D & goalie_pos,
+                       const int bin,
+                       Shot & shot ) const
+{
+    const int b = ball_index( ball_pos );
+    const int g = goalie_index( goalie_pos );
+
+    if ( ! M_ready
+         || b < 0 || g < 0
+         || bin < 0 || SPEED_BINS <= bin )
+    {
+        return false;
+    }
+
+    const int idx = ( bin * BALL_CELLS + b ) * GOALIE_CELLS + g;
+
+    shot.target_ = ( M_shot_target[idx] >= 0
+                     ? target_point( M_shot_target[idx] )
+                     : rcsc::Vector2D( rcsc::ServerParam::i().pitchHalfLength(), 0.0 ) );
+    shot.margin_ = M_shot_margin[idx];
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PenaltyTable::getDribbleTarget( const rcsc::Vector2D & ball_pos,
+                                const rcsc::Vector2D & goalie_pos,
+                                const int bin,
+                                rcsc::Vector2D & target ) const
+{
+    const int b = ball_index( ball_pos );
+    const int g = goalie_index( goalie_pos );
+
+    if ( ! M_ready
+         || b < 0 || g < 0
+         || bin < 0 || SPEED_BINS <= bin )
+    {
+        return false;
+    }
+
+    const int ix = b / BALL_Y_SIZE;
+    const int iy = b % BALL_Y_SIZE;
+
+    double best_margin = NO_SHOT - 1.0;
+
+    for ( int dx = -1; dx <= 1; ++dx )
+    {
+        for ( int dy = -1; dy <= 1; ++dy )
+        {
+            const int nx = ix + dx;
+            const int ny = iy + dy;
+            if ( ( dx == 0 && dy == 0 )
+                 || nx < 0 || BALL_X_SIZE <= nx
+                 || ny < 0 || BALL_Y_SIZE <= ny )
+            {
+                continue;
+            }
+
+            const int idx = ( bin * BALL_CELLS + nx * BALL_Y_SIZE + ny ) * GOALIE_CELLS + g;
+            if ( M_shot_margin[idx] > best_margin )
+            {
+                best_margin = M_shot_margin[idx];
+                target = ball_cell( nx, ny );
+            }
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PenaltyTable::getGoalieMovePos( const rcsc::Vector2D & ball_pos,
+                                const int bin,
+                                rcsc::Vector2D & move_pos ) const
+{
+    const int b = ball_index( ball_pos );
+
+    if ( ! M_ready
+         || b < 0
+         || bin < 0 || SPEED_BINS <= bin )
+    {
+        return false;
+    }
+
+    const int g = M_goalie_cell[bin * BALL_CELLS + b];
+    if ( g < 0 )
+    {
+        return false;
+    }
+
+    move_pos = goalie_cell( g / GOALIE_Y_SIZE, g % GOALIE_Y_SIZE );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PenaltyTable::estimateSuccessRate( const int trials,
+                                   const double & noise,
+                                   const unsigned long seed ) const
+{
+    if ( ! M_ready
+         || trials <= 0 )
+    {
+        return 0.0;
+    }
+
+    unsigned long state = seed;
+    int count = 0;
+    int success = 0;
+
+    for ( int i = 0; i < trials; ++i )
+    {
+        const int bin = std::min( SPEED_BINS - 1,
+                                  static_cast< int >( random_rate( state ) * SPEED_BINS ) );
+        const rcsc::Vector2D ball
+            = ball_cell( std::min( BALL_X_SIZE - 1,
+                                   static_cast< int >( random_rate( state ) * BALL_X_SIZE ) ),
+                         std::min( BALL_Y_SIZE - 1,
+                                   static_cast< int >( random_rate( state ) * BALL_Y_SIZE ) ) )
+            + rcsc::Vector2D( ( random_rate( state ) - 0.5 ) * BALL_STEP,
+                              ( random_rate( state ) - 0.5 ) * BALL_STEP );
+
+        rcsc::Vector2D goalie;
+        if ( ! getGoalieMovePos( ball, bin, goalie ) )
+        {
+            continue;
+        }
+
+        goalie.x += ( random_rate( state ) * 2.0 - 1.0 ) * noise;
+        goalie.y += ( random_rate( state ) * 2.0 - 1.0 ) * noise;
+        goalie.x = std::min( goalie.x, rcsc::ServerParam::i().pitchHalfLength() );
+
+        ++count;
+
+        Shot shot;
+        if ( getShot( ball, goalie, bin, shot )
+             && shot.margin_ > 0.0
+             && simulate( ball, goalie, shot.target_, bin_speed( bin ) ) > 0.0 )
+        {
+            ++success;
+        }
+    }
+
+    return ( count > 0
+             ? static_cast< double >( success ) / count
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PenaltyTable::current_params( double * params )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    params[0] = SP.pitchHalfLength();
+    params[1] = SP.goalHalfWidth();
+    params[2] = SP.ballDecay();
+    params[3] = SP.ballSpeedMax();
+    params[4] = SP.catchAreaLength();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+rcsc::Vector2D
+PenaltyTable::target_point( const int i )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const double max_y = SP.goalHalfWidth() - 1.0;
+
+    return rcsc::Vector2D( SP.pitchHalfLength(),
+                           -max_y + 2.0 * max_y * i / ( TARGET_SIZE - 1 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+rcsc::Vector2D
+PenaltyTable::ball_cell( const int ix,
+                         const int iy )
+{
+    return rcsc::Vector2D( rcsc::ServerParam::i().pitchHalfLength()
+                           - BALL_X_SIZE * BALL_STEP
+                           + ix * BALL_STEP,
+                           ( iy - ( BALL_Y_SIZE - 1 ) / 2 ) * BALL_STEP );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+rcsc::Vector2D
+PenaltyTable::goalie_cell( const int ix,
+                           const int iy )
+{
+    return rcsc::Vector2D( rcsc::ServerParam::i().pitchHalfLength()
+                           - ( GOALIE_X_SIZE - 1 ) * GOALIE_STEP
+                           + ix * GOALIE_STEP,
+                           ( iy - ( GOALIE_Y_SIZE - 1 ) / 2 ) * GOALIE_STEP );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PenaltyTable::ball_index( const rcsc::Vector2D & pos )
+{
+    const rcsc::Vector2D origin = ball_cell( 0, 0 );
+
+    if ( pos.x > rcsc::ServerParam::i().pitchHalfLength() )
+    {
+        return -1;
+    }
+
+    const int ix = std::min( BALL_X_SIZE - 1,
+                             static_cast< int >( std::floor( ( pos.x - origin.x )
+                                                             / BALL_STEP + 0.5 ) ) );
+    const int iy = static_cast< int >( std::floor( ( pos.y - origin.y ) / BALL_STEP + 0.5 ) );
+
+    if ( ix < 0
+         || iy < 0 || BALL_Y_SIZE <= iy )
+    {
+        return -1;
+    }
+
+    return ix * BALL_Y_SIZE + iy;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PenaltyTable::goalie_index( const rcsc::Vector2D & pos )
+{
+    const rcsc::Vector2D origin = goalie_cell( 0, 0 );
+
+    const int ix = static_cast< int >( std::floor( ( pos.x - origin.x ) / GOALIE_STEP + 0.5 ) );
+    const int iy = static_cast< int >( std::floor( ( pos.y - origin.y ) / GOALIE_STEP + 0.5 ) );
+
+    if ( ix < 0 || GOALIE_X_SIZE <= ix
+         || iy < 0 || GOALIE_Y_SIZE <= iy )
+    {
+        return -1;
+    }
+
+    return ix * GOALIE_Y_SIZE + iy;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PenaltyTable::bin_speed( const int bin )
+{
+    static const double speeds[] = { 0.9, 1.0, 1.1 };
+
+    return speeds[ std::min( std::max( bin, 0 ), SPEED_BINS - 1 ) ];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PenaltyTable::simulate( const rcsc::Vector2D & ball_pos,
+                        const rcsc::Vector2D & goalie_pos,
+                        const rcsc::Vector2D & target,
+                        const double & goalie_speed )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const double goal_x = SP.pitchHalfLength();
+    const double decay = SP.ballDecay();
+    const double dist_buf = SP.catchAreaLength() + 0.2;
+
+    rcsc::Vector2D pos = ball_pos;
+    rcsc::Vector2D vel = rcsc::Vector2D::polar2vector( SP.ballSpeedMax(),
+                                                       ( target - ball_pos ).th() );
+    double margin = 1000.0;
+
+    // goalie move at first step is ignored,
+    // because goalie must see the ball velocity before chasing.
+    for ( int cycle = 0; cycle < 50; ++cycle )
+    {
+        pos += vel;
+        vel *= decay;
+
+        if ( pos.x >= goal_x )
+        {
+            return margin;
+        }
+
+        margin = std::min( margin,
+                           goalie_pos.dist( pos ) - ( goalie_speed * cycle + dist_buf ) );
+    }
+
+    return NO_SHOT;
+}
@@ -0,0 +1,296 @@
+// -*-c++-*-
+
+/*!
+  \file penalty_table.h
+  \brief penalty shootout shot and goalie tables Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef PENALTY_TABLE_H
+#define PENALTY_TABLE_H
+
+#include <rcsc/geom/vector_2d.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+  \class PenaltyTable
+  \brief precomputed kicker and goalie decisions for the penalty shootout.
+
+  All coordinates are normalized so that the kicker attacks the goal
+  at the positive x side.
+
+  The shot table is indexed by (goalie speed bin, ball cell, goalie
+  cell). Each element is the best shot target and the goalie reach
+  margin for that target. The goalie table is indexed by (goalie speed
+  bin, ball cell). Each element is the goalie cell that minimizes the
+  kicker's best margin.
+
+  The tables are created by build() or loaded from the file written by
+  write(). Each query is a nearest cell lookup.
+ */
+class PenaltyTable {
+public:
+
+    //! table format version
+    static const int VERSION = 2;
+
+    //! the number of server parameters that the tables depend on
+    static const int PARAM_SIZE = 5;
+
+    //! the number of ball cells along the x axis
+    static const int BALL_X_SIZE = 10;
+    //! the number of ball cells along the y axis
+    static const int BALL_Y_SIZE = 21;
+    //! ball cell size
+    static const double BALL_STEP;
+
+    //! the number of goalie cells along the x axis
+    static const int GOALIE_X_SIZE = 17;
+    //! the number of goalie cells along the y axis
+    static const int GOALIE_Y_SIZE = 21;
+    //! goalie cell size
+    static const double GOALIE_STEP;
+
+    //! the number of goalie speed bins
+    static const int SPEED_BINS = 3;
+
+    //! the number of shot targets on the goal line
+    static const int TARGET_SIZE = 9;
+
+    /*!
+      \struct Shot
+      \brief shot table element
+     */
+    struct Shot {
+        rcsc::Vector2D target_; //!< shot target on the goal line
+        double margin_; //!< min distance between the ball and the goalie reach
+    };
+
+private:
+
+    //! true if tables are available
+    bool M_ready;
+
+    //! server parameters used to solve the tables
+    double M_params[PARAM_SIZE];
+
+    //! shot target index. -1 if the goal line is never reached.
+    std::vector< signed char > M_shot_target;
+    //! goalie reach margin of the shot
+    std::vector< float > M_shot_margin;
+
+    //! goalie cell index
+    std::vector< short > M_goalie_cell;
+
+    /*!
+      \brief private for singleton
+     */
+    PenaltyTable();
+
+    // not used
+    PenaltyTable( const PenaltyTable & );
+    PenaltyTable & operator=( const PenaltyTable & );
+
+public:
+
+    /*!
+      \brief get the singleton instance
+      \return reference to the instance
+     */
+    static
+    PenaltyTable & instance();
+
+    /*!
+      \brief check if tables are available
+      \return true if tables are available
+     */
+    bool ready() const
+      {
+          return M_ready;
+      }
+
+    /*!
+      \brief check if the tables are solved by the current server parameters
+      \return true if tables are available and the parameters are same
+     */
+    bool matchServerParam() const;
+
+    /*!
+      \brief solve all tables by the current server parameters
+     */
+    void build();
+
+    /*!
+      \brief read tables from the file
+      \param filepath table file path
+      \return true if successfully read
+     */
+    bool read( const std::string & filepath );
+
+    /*!
+      \brief write tables to the stream
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & write( std::ostream & os ) const;
+
+    /*!
+      \brief get the speed bin of the goalie
+      \param speed_max goalie's max speed
+      \return bin index
+     */
+    static
+    int speed_bin( const double & speed_max );
+
+    /*!
+      \brief get the best shot
+      \param ball_pos normalized ball position
+      \param goalie_pos normalized goalie position
+      \param bin goalie speed bin
+      \param shot reference to the result
+      \return true if the positions are covered by the table
+     */
+    bool getShot( const rcsc::Vector2D & ball_pos,
+                  const rcsc::Vector2D & goalie_pos,
+                  const int bin,
+                  Shot & shot ) const;
+
+    /*!
+      \brief get the neighbor ball cell that has the best shot
+      \param ball_pos normalized ball position
+      \param goalie_pos normalized goalie position
+      \param bin goalie speed bin
+      \param target reference to the dribble target
+      \return true if the positions are covered by the table
+     */
+    bool getDribbleTarget( const rcsc::Vector2D & ball_pos,
+                           const rcsc::Vector2D & goalie_pos,
+                           const int bin,
+                           rcsc::Vector2D & target ) const;
+
+    /*!
+      \brief get the goalie position against the ball
+      \param ball_pos normalized ball position
+      \param bin goalie speed bin
+      \param move_pos reference to the result
+      \return true if the ball position is covered by the table
+     */
+    bool getGoalieMovePos( const rcsc::Vector2D & ball_pos,
+                           const int bin,
+                           rcsc::Vector2D & move_pos ) const;
+
+    /*!
+      \brief estimate the kicker's success rate by random situations
+      \param trials the number of trials
+      \param noise max goalie position error from the table position
+      \param seed random seed
+      \return success rate in [0,1]
+     */
+    double estimateSuccessRate( const int trials,
+                                const double & noise,
+                                const unsigned long seed ) const;
+
+private:
+
+    /*!
+      \brief get the shot target on the goal line
+      \param i target index
+      \return target point
+     */
+    static
+    rcsc::Vector2D target_point( const int i );
+
+    /*!
+      \brief get the current server parameters that the tables depend on
+      \param params array of PARAM_SIZE elements to store the values
+     */
+    static
+    void current_params( double * params );
+
+    /*!
+      \brief get the ball cell center
+      \param ix x index
+      \param iy y index
+      \return cell center
+     */
+    static
+    rcsc::Vector2D ball_cell( const int ix,
+                              const int iy );
+
+    /*!
+      \brief get the goalie cell center
+      \param ix x index
+      \param iy y index
+      \return cell center
+     */
+    static
+    rcsc::Vector2D goalie_cell( const int ix,
+                                const int iy );
+
+    /*!
+      \brief get the ball cell index of the position
+      \param pos normalized position
+      \return cell index, or -1 if out of the table
+     */
+    static
+    int ball_index( const rcsc::Vector2D & pos );
+
+    /*!
+      \brief get the goalie cell index of the position
+      \param pos normalized position
+      \return cell index, or -1 if out of the table
+     */
+    static
+    int goalie_index( const rcsc::Vector2D & pos );
+
+    /*!
+      \brief get the representative speed of the bin
+      \param bin speed bin
+      \return goalie max speed
+     */
+    static
+    double bin_speed( const int bin );
+
+    /*!
+      \brief simulate the shot and get the goalie reach margin
+      \param ball_pos ball first position
+      \param goalie_pos goalie position
+      \param target shot target
+      \param goalie_speed goalie max speed
+      \return margin. very small value if the ball does not reach the goal line
+     */
+    static
+    double simulate( const rcsc::Vector2D & ball_pos,
+                     const rcsc::Vector2D & goalie_pos,
+                     const rcsc::Vector2D & target,
+                     const double & goalie_speed );
+
+};
+
+#endif
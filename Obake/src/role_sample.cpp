@@ -114,8 +114,8 @@ RoleSample::doMove( rcsc::PlayerAgent * agent )
         = wm.ball().inertiaPoint( ball_reach_step );
 
     rcsc::Vector2D home_pos
-        = formation().getPosition( agent->config().playerNumber(),
-                                   base_pos );
+        = formation().getCachedPosition( agent->config().playerNumber(),
+                                         base_pos );
     if ( rcsc::ServerParam::i().useOffside() )
     {
         home_pos.x = std::min( home_pos.x, wm.offsideLineX() - 1.0 );
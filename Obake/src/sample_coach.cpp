@@ -139,6 +139,7 @@ struct MaxSpeedReachStepCmp
  */
 SampleCoach::SampleCoach()
     : CoachAgent()
+    , M_opponent_statistics_send_cycle( 0 )
 {
     //
     // register audio memory & say message parsers
@@ -254,7 +255,15 @@ SampleCoach::actionImpl()
     }
 
     doSubstitute();
+
+    M_opponent_statistics.update( world() );
+
+    const int send_count = world().freeformSendCount();
     sayPlayerTypes();
+    if ( world().freeformSendCount() == send_count )
+    {
+        sayOpponentStatistics();
+    }
 
 //     if ( world().canSendFreeform() )
 //     {
@@ -673,6 +682,43 @@ SampleCoach::sayPlayerTypes()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+SampleCoach::sayOpponentStatistics()
+{
+    if ( ! config().useFreeform() )
+    {
+        return;
+    }
+
+    // the summary is sent at most once per 300 cycles
+    if ( world().time().cycle() - M_opponent_statistics_send_cycle < 300
+         || ! world().canSendFreeform() )
+    {
+        return;
+    }
+
+    std::string msg;
+    if ( ! M_opponent_statistics.makeSummary( rcsc::ServerParam::i().coachSayMsgSize(),
+                                              msg ) )
+    {
+        return;
+    }
+
+    doSayFreeform( msg );
+
+    M_opponent_statistics_send_cycle = world().time().cycle();
+
+    std::cout << config().teamName()
+              << " coach: "
+              << world().time()
+              << " send freeform " << msg
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 SampleCoach::sendTeamGraphic()
@@ -33,6 +33,7 @@
 #include <rcsc/types.h>
 
 #include <rcsc/coach/coach_agent.h>
+#include <rcsc/coach/opponent_statistics.h>
 
 namespace rcsc {
 class PlayerType;
@@ -55,6 +56,12 @@ private:
     //! team graphic holder
     rcsc::TeamGraphic M_team_graphic;
 
+    //! incremental statistics of the opponent team
+    rcsc::OpponentStatistics M_opponent_statistics;
+
+    //! last time when the opponent statistics was sent
+    long M_opponent_statistics_send_cycle;
+
 public:
 
     SampleCoach();
@@ -85,6 +92,11 @@ private:
      */
     void sayPlayerTypes();
 
+    /*!
+      \brief broadcast the summary of the opponent statistics
+     */
+    void sayOpponentStatistics();
+
     /*!
       \brief send team graphic tiles to rcssserver
      */
@@ -37,6 +37,9 @@
 #include "bhv_pre_process.h"
 #include "bhv_set_play.h"
 #include "bhv_set_play_kick_in.h"
+#include "penalty_table.h"
+#include "obake_action_evaluator.h"
+#include "set_play_coordinator.h"
 
 #include <rcsc/formation/formation.h>
 #include <rcsc/player/intercept_table.h>
@@ -125,6 +128,24 @@ SamplePlayer::initImpl( rcsc::CmdLineParser & cmd_parser )
 
     cmd_parser.parse( my_params );
 #endif
+    double formation_grid_step = 0.0;
+    my_params.add()
+        ( "formation_grid_step", "", &formation_grid_step,
+          "if positive, formations are rasterized with this ball grid step." )
+        ;
+    std::string penalty_table;
+    my_params.add()
+        ( "penalty_table", "", &penalty_table,
+          "penalty shootout table file. if empty, tables are solved at startup." )
+        ;
+
+    bool use_action_evaluator = false;
+    my_params.add()
+        ( "use_action_evaluator", "", rcsc::BoolSwitch( &use_action_evaluator ),
+          "on-ball actions are chosen by the unified action evaluator." )
+        ;
+
+    cmd_parser.parse( my_params );
 
     if ( ! rcsc::PlayerAgent::initImpl( cmd_parser ) )
     {
@@ -140,6 +161,9 @@ SamplePlayer::initImpl( rcsc::CmdLineParser & cmd_parser )
         std::cerr << std::endl;
     }
 
+    M_strategy.setFormationGridStep( formation_grid_step );
+    Obake_ActionEvaluator::instance().setEnabled( use_action_evaluator );
+
     if ( ! M_strategy.read( config().configDir() ) )
     {
         std::cerr << "***ERROR*** Failed to read team strategy." << std::endl;
@@ -147,6 +171,21 @@ SamplePlayer::initImpl( rcsc::CmdLineParser & cmd_parser )
         return false;
     }
 
+    if ( ! penalty_table.empty()
+         && ! PenaltyTable::instance().read( penalty_table ) )
+    {
+        std::cerr << "***WARNING*** Failed to read the penalty table ["
+                  << penalty_table << "]. tables will be solved." << std::endl;
+    }
+
+    if ( ! PenaltyTable::instance().ready() )
+    {
+        // solved by the default server parameters. if the server
+        // parameters differ, tables are solved again at the first
+        // penalty cycle.
+        PenaltyTable::instance().build();
+    }
+
     //////////////////////////////////////////////////////////////////
     // Add your code here.
     //////////////////////////////////////////////////////////////////
@@ -232,6 +271,15 @@ SamplePlayer::actionImpl()
         return;
     }
 
+    //////////////////////////////////////////////////////////////
+    // set play positions are recomputed only when the situation changes
+    if ( ! world().gameMode().isPenaltyKickMode() )
+    {
+        SetPlayCoordinator::instance().update( world(),
+                                               M_strategy,
+                                               role_ptr->formation() );
+    }
+
     //////////////////////////////////////////////////////////////
     // kick_in or corner_kick
     if ( ( world().gameMode().type() == rcsc::GameMode::KickIn_
@@ -244,10 +292,8 @@ SamplePlayer::actionImpl()
         }
         else
         {
-            const rcsc::Vector2D base_pos = world().ball().pos();
-            rcsc::Vector2D home_pos
-                = role_ptr->formation().getPosition( config().playerNumber(),
-                                                     base_pos );
+            const rcsc::Vector2D & home_pos
+                = SetPlayCoordinator::instance().position( config().playerNumber() );
             Bhv_SetPlayKickIn( home_pos ).execute( this );
         }
         return;
@@ -276,10 +322,8 @@ SamplePlayer::actionImpl()
     //////////////////////////////////////////////////////////////
     // other set play mode
 
-    rcsc::Vector2D move_pos
-        = M_strategy.getSetPlayPosition( config().playerNumber(),
-                                         role_ptr->formation(),
-                                         world() );
+    const rcsc::Vector2D & move_pos
+        = SetPlayCoordinator::instance().position( config().playerNumber() );
 
     //////////////////////////////////////////////////////////////
 
@@ -41,13 +41,23 @@
 #include <rcsc/param/cmd_line_parser.h>
 #include <rcsc/random.h>
 
+#include <algorithm>
+#include <iostream>
+
 /*-------------------------------------------------------------------*/
 /*!
 
  */
 SampleTrainer::SampleTrainer()
     : TrainerAgent()
+    , M_episodes( 0 )
+    , M_episode( 0 )
+    , M_scenario_state( 0 )
+    , M_episode_start_cycle( 0 )
 {
+    std::fill( M_outcome_count,
+               M_outcome_count + rcsc::TrainerScenario::MAX_OUTCOME,
+               0 );
 
 }
 
@@ -75,6 +85,19 @@ SampleTrainer::initImpl( rcsc::CmdLineParser & cmd_parser )
         ( &conf_path, "fconf" )
         ;
 #endif
+    std::string scenario_file;
+    std::string result_file;
+    int episodes = 100;
+    my_params.add()
+        ( "scenario", "", &scenario_file,
+          "run the scripted scenarios in this file instead of the sample training." )
+        ( "episodes", "", &episodes,
+          "the number of scenario episodes." )
+        ( "scenario_result", "", &result_file,
+          "if specified, episode results are written to this file as csv." )
+        ;
+
+    cmd_parser.parse( my_params );
 
     if ( ! rcsc::TrainerAgent::initImpl( cmd_parser ) )
     {
@@ -95,6 +118,38 @@ SampleTrainer::initImpl( rcsc::CmdLineParser & cmd_parser )
     // Add your code here.
     //////////////////////////////////////////////////////////////////
 
+    if ( ! scenario_file.empty() )
+    {
+        std::ifstream fin( scenario_file.c_str() );
+        if ( ! fin.is_open()
+             || ! rcsc::TrainerScenario::read( fin, M_scenarios )
+             || M_scenarios.empty() )
+        {
+            std::cerr << "trainer: ***ERROR*** failed to read the scenario file ["
+                      << scenario_file << "]" << std::endl;
+            M_client->setServerAlive( false );
+            return false;
+        }
+
+        M_episodes = std::max( 1, episodes );
+
+        if ( ! result_file.empty() )
+        {
+            M_result_file.open( result_file.c_str() );
+            if ( ! M_result_file.is_open() )
+            {
+                std::cerr << "trainer: ***ERROR*** failed to open the result file ["
+                          << result_file << "]" << std::endl;
+                M_client->setServerAlive( false );
+                return false;
+            }
+            M_result_file << "episode,scenario,outcome,cycles,msec\n";
+        }
+
+        std::cout << "trainer: loaded " << M_scenarios.size()
+                  << " scenarios. episodes=" << M_episodes
+                  << std::endl;
+    }
 
     return true;
 }
@@ -109,6 +164,12 @@ SampleTrainer::actionImpl()
     //////////////////////////////////////////////////////////////////
     // This function is a sample trainer action.
     // At first, remove this.
+    if ( ! M_scenarios.empty() )
+    {
+        scenarioAction();
+        return;
+    }
+
     sampleAction();
 
     // Add your code here.
@@ -188,3 +249,146 @@ SampleTrainer::sampleAction()
 
     }
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SampleTrainer::scenarioAction()
+{
+    if ( M_episode >= M_episodes )
+    {
+        return;
+    }
+
+    const rcsc::TrainerScenario & scenario
+        = M_scenarios[M_episode % M_scenarios.size()];
+
+    switch ( M_scenario_state ) {
+    case 0:
+        setupScenario();
+        M_scenario_state = 1;
+        break;
+    case 1:
+        // wait one cycle so that the moved objects are observed.
+        M_episode_start_cycle = world().time().cycle();
+        M_episode_timer.restart();
+        M_scenario_state = 2;
+        break;
+    case 2:
+        {
+            const long elapsed = world().time().cycle() - M_episode_start_cycle;
+            const rcsc::TrainerScenario::Outcome outcome
+                = scenario.judge( world(), static_cast< int >( elapsed ) );
+            if ( outcome != rcsc::TrainerScenario::Running )
+            {
+                finishEpisode( outcome, elapsed );
+                M_scenario_state = 0;
+            }
+        }
+        break;
+    default:
+        M_scenario_state = 0;
+        break;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SampleTrainer::setupScenario()
+{
+    const rcsc::TrainerScenario & scenario
+        = M_scenarios[M_episode % M_scenarios.size()];
+
+    if ( M_episode == 0 )
+    {
+        M_batch_timer.restart();
+    }
+
+    doRecover();
+    doMoveBall( scenario.ballPos(), scenario.ballVel() );
+
+    const std::vector< rcsc::TrainerScenario::Player >::const_iterator end
+        = scenario.players().end();
+    for ( std::vector< rcsc::TrainerScenario::Player >::const_iterator p
+              = scenario.players().begin();
+          p != end;
+          ++p )
+    {
+        const std::string & team_name = ( p->side_ == rcsc::LEFT
+                                          ? world().teamNameLeft()
+                                          : world().teamNameRight() );
+        if ( team_name.empty() )
+        {
+            continue;
+        }
+
+        doMovePlayer( team_name,
+                      p->unum_,
+                      p->pos_,
+                      rcsc::AngleDeg( p->body_ ) );
+    }
+
+    doChangeMode( scenario.playmode() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SampleTrainer::finishEpisode( const rcsc::TrainerScenario::Outcome outcome,
+                              const long cycles )
+{
+    const rcsc::TrainerScenario & scenario
+        = M_scenarios[M_episode % M_scenarios.size()];
+    const long msec = M_episode_timer.elapsed();
+
+    M_outcome_count[outcome] += 1;
+
+    if ( M_result_file.is_open() )
+    {
+        M_result_file << M_episode << ','
+                      << scenario.name() << ','
+                      << rcsc::TrainerScenario::outcome_name( outcome ) << ','
+                      << cycles << ','
+                      << msec << '\n';
+    }
+
+    ++M_episode;
+
+    if ( M_episode < M_episodes )
+    {
+        return;
+    }
+
+    //
+    // all episodes are finished
+    //
+
+    const long total_msec = M_batch_timer.elapsed();
+
+    std::cout << "trainer: finished " << M_episodes << " episodes in "
+              << total_msec << " msec" << std::endl;
+    for ( int i = rcsc::TrainerScenario::GoalLeft;
+          i < rcsc::TrainerScenario::MAX_OUTCOME;
+          ++i )
+    {
+        std::cout << "  "
+                  << rcsc::TrainerScenario::outcome_name( static_cast< rcsc::TrainerScenario::Outcome >( i ) )
+                  << ": " << M_outcome_count[i]
+                  << std::endl;
+    }
+
+    if ( M_result_file.is_open() )
+    {
+        M_result_file.flush();
+        M_result_file.close();
+    }
+
+    M_client->setServerAlive( false );
+}
@@ -28,11 +28,37 @@
 #define AGENT2D_SAMPLE_TRAINER_H
 
 #include <rcsc/trainer/trainer_agent.h>
+#include <rcsc/trainer/trainer_scenario.h>
+#include <rcsc/timer.h>
+
+#include <fstream>
+#include <vector>
 
 class SampleTrainer
     : public rcsc::TrainerAgent {
 private:
 
+    //! scripted scenarios. if empty, sampleAction() is used.
+    std::vector< rcsc::TrainerScenario > M_scenarios;
+
+    //! the number of episodes to run
+    int M_episodes;
+    //! the number of finished episodes
+    int M_episode;
+    //! 0: setup, 1: waiting the setup, 2: running
+    int M_scenario_state;
+    //! game cycle when the current episode started
+    long M_episode_start_cycle;
+    //! wall clock timer of the current episode
+    rcsc::MSecTimer M_episode_timer;
+    //! wall clock timer of the whole batch
+    rcsc::MSecTimer M_batch_timer;
+    //! outcome counter
+    int M_outcome_count[rcsc::TrainerScenario::MAX_OUTCOME];
+
+    //! result output. one csv line per episode.
+    std::ofstream M_result_file;
+
 public:
 
     SampleTrainer();
@@ -58,6 +84,24 @@ private:
 
     void sampleAction();
 
+    /*!
+      \brief run the loaded scenarios one by one
+     */
+    void scenarioAction();
+
+    /*!
+      \brief set up the current episode
+     */
+    void setupScenario();
+
+    /*!
+      \brief record the result of the current episode
+      \param outcome finished outcome
+      \param cycles the number of cycles of the episode
+     */
+    void finishEpisode( const rcsc::TrainerScenario::Outcome outcome,
+                        const long cycles );
+
 };
 
 #endif
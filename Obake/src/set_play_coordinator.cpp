@@ -0,0 +1,324 @@
+// -*-c++-*-
+
+/*!
+  \file set_play_coordinator.cpp
+  \brief event driven set play positioning and kicker assignment Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "set_play_coordinator.h"
+
+#include "strategy.h"
+
+#include <rcsc/formation/formation.h>
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/logger.h>
+
+#include <cmath>
+
+const double SetPlayCoordinator::BALL_MOVE_THR = 1.0;
+const double SetPlayCoordinator::OFFSIDE_MOVE_THR = 1.0;
+const int SetPlayCoordinator::KICKER_LOST_COUNT = 5;
+const double SetPlayCoordinator::KICKER_NEARER_RATE = 0.8;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SetPlayCoordinator::SetPlayCoordinator()
+    : M_start_time( -1, 0 )
+    , M_mode_type( rcsc::GameMode::MODE_MAX )
+    , M_mode_side( rcsc::NEUTRAL )
+    , M_formation( static_cast< const rcsc::Formation * >( 0 ) )
+    , M_ball_pos( 0.0, 0.0 )
+    , M_ball_valid( false )
+    , M_offside_line_x( 0.0 )
+    , M_kicker_time( -1, 0 )
+    , M_kicker_start_time( -1, 0 )
+    , M_kicker_unum( 0 )
+    , M_update_count( 0 )
+{
+    for ( int i = 0; i < 11; ++i )
+    {
+        M_teammate_types[i] = rcsc::Hetero_Default;
+        M_positions[i].assign( 0.0, 0.0 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SetPlayCoordinator &
+SetPlayCoordinator::instance()
+{
+    static SetPlayCoordinator s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SetPlayCoordinator::Event
+SetPlayCoordinator::detectEvent( const rcsc::WorldModel & wm,
+                                 const rcsc::Formation & formation ) const
+{
+    if ( M_start_time != wm.lastSetPlayStartTime()
+         || M_mode_type != wm.gameMode().type()
+         || M_mode_side != wm.gameMode().side() )
+    {
+        return PLAYMODE_CHANGED;
+    }
+
+    if ( M_formation != &formation )
+    {
+        return FORMATION_CHANGED;
+    }
+
+    if ( M_ball_valid != wm.ball().posValid()
+         || ( M_ball_valid
+              && M_ball_pos.dist2( wm.ball().pos() ) > BALL_MOVE_THR * BALL_MOVE_THR ) )
+    {
+        return BALL_MOVED;
+    }
+
+    for ( int i = 0; i < 11; ++i )
+    {
+        if ( M_teammate_types[i] != wm.teammateHeteroID( i + 1 ) )
+        {
+            return SUBSTITUTED;
+        }
+    }
+
+    if ( std::fabs( M_offside_line_x - wm.offsideLineX() ) > OFFSIDE_MOVE_THR )
+    {
+        return OFFSIDE_LINE_MOVED;
+    }
+
+    return NO_EVENT;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SetPlayCoordinator::Event
+SetPlayCoordinator::update( const rcsc::WorldModel & wm,
+                            const Strategy & strategy,
+                            const rcsc::Formation & formation )
+{
+    const Event event = detectEvent( wm, formation );
+
+    if ( event == NO_EVENT )
+    {
+        return NO_EVENT;
+    }
+
+    M_start_time = wm.lastSetPlayStartTime();
+    M_mode_type = wm.gameMode().type();
+    M_mode_side = wm.gameMode().side();
+    M_formation = &formation;
+    M_ball_pos = wm.ball().pos();
+    M_ball_valid = wm.ball().posValid();
+    M_offside_line_x = wm.offsideLineX();
+    for ( int i = 0; i < 11; ++i )
+    {
+        M_teammate_types[i] = wm.teammateHeteroID( i + 1 );
+    }
+
+    // our kick in and corner kick positions are not limited by the offside line
+    const bool our_kick_in = ( ( M_mode_type == rcsc::GameMode::KickIn_
+                                 || M_mode_type == rcsc::GameMode::CornerKick_ )
+                               && M_mode_side == wm.ourSide() );
+
+    for ( int unum = 1; unum <= 11; ++unum )
+    {
+        M_positions[unum - 1]
+            = ( our_kick_in
+                ? formation.getCachedPosition( unum, M_ball_pos )
+                : strategy.getSetPlayPosition( unum, formation, wm ) );
+    }
+
+    ++M_update_count;
+
+    rcsc::dlog.addText( rcsc::Logger::TEAM,
+                        "%s:%d: set play positions are updated. event=%d count=%ld"
+                        ,__FILE__, __LINE__,
+                        static_cast< int >( event ), M_update_count );
+
+    return event;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SetPlayCoordinator::isKicker( const rcsc::WorldModel & wm )
+{
+    if ( M_kicker_time == wm.time() )
+    {
+        return M_kicker_unum == wm.self().unum();
+    }
+    M_kicker_time = wm.time();
+
+    if ( M_kicker_start_time != wm.lastSetPlayStartTime() )
+    {
+        M_kicker_start_time = wm.lastSetPlayStartTime();
+        M_kicker_unum = assign_kicker( wm );
+        rcsc::dlog.addText( rcsc::Logger::TEAM,
+                            "%s:%d: kicker is assigned to %d"
+                            ,__FILE__, __LINE__,
+                            M_kicker_unum );
+        return M_kicker_unum == wm.self().unum();
+    }
+
+    if ( M_kicker_unum == 0 )
+    {
+        return false;
+    }
+
+    double kicker_dist = 0.0;
+    if ( ! get_ball_dist( wm, M_kicker_unum, &kicker_dist ) )
+    {
+        M_kicker_unum = assign_kicker( wm );
+        rcsc::dlog.addText( rcsc::Logger::TEAM,
+                            "%s:%d: kicker is lost. reassigned to %d"
+                            ,__FILE__, __LINE__,
+                            M_kicker_unum );
+        return M_kicker_unum == wm.self().unum();
+    }
+
+    const int nearest = assign_kicker( wm );
+    double nearest_dist = 0.0;
+    if ( nearest != 0
+         && nearest != M_kicker_unum
+         && get_ball_dist( wm, nearest, &nearest_dist )
+         && nearest_dist < kicker_dist * KICKER_NEARER_RATE )
+    {
+        rcsc::dlog.addText( rcsc::Logger::TEAM,
+                            "%s:%d: %d is nearer than the kicker %d (%.2f < %.2f)."
+                            " reassigned"
+                            ,__FILE__, __LINE__,
+                            nearest, M_kicker_unum, nearest_dist, kicker_dist );
+        M_kicker_unum = nearest;
+    }
+
+    return M_kicker_unum == wm.self().unum();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+SetPlayCoordinator::assign_kicker( const rcsc::WorldModel & wm )
+{
+    if ( ! wm.gameMode().isOurSetPlay( wm.ourSide() ) )
+    {
+        return 0;
+    }
+
+    // the goalie kicks the ball after catch
+    if ( wm.gameMode().type() == rcsc::GameMode::GoalieCatch_ )
+    {
+        return ( wm.self().goalie() ? wm.self().unum() : 0 );
+    }
+
+    // kick off and goal kick are given to the nearest player.
+    // otherwise, this player is preferred unless another player is clearly nearer.
+    const bool goal_kick = ( wm.gameMode().type() == rcsc::GameMode::GoalKick_ );
+    const double rate = ( goal_kick
+                          || wm.gameMode().type() == rcsc::GameMode::KickOff_
+                          ? 1.0
+                          : 0.9 );
+
+    const double self_dist = wm.ball().distFromSelf();
+
+    const rcsc::PlayerPtrCont::const_iterator end = wm.teammatesFromBall().end();
+    for ( rcsc::PlayerPtrCont::const_iterator it = wm.teammatesFromBall().begin();
+          it != end;
+          ++it )
+    {
+        if ( goal_kick && (*it)->goalie() )
+        {
+            continue;
+        }
+
+        if ( (*it)->distFromBall() < self_dist * rate )
+        {
+            return ( (*it)->unum() > 0 ? (*it)->unum() : -1 );
+        }
+
+        // container is sorted by the distance from ball
+        break;
+    }
+
+    return wm.self().unum();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SetPlayCoordinator::get_ball_dist( const rcsc::WorldModel & wm,
+                                   const int unum,
+                                   double * dist )
+{
+    if ( unum == wm.self().unum() )
+    {
+        *dist = wm.ball().distFromSelf();
+        return true;
+    }
+
+    // container is sorted by the distance from ball
+    const rcsc::PlayerPtrCont::const_iterator end = wm.teammatesFromBall().end();
+    for ( rcsc::PlayerPtrCont::const_iterator it = wm.teammatesFromBall().begin();
+          it != end;
+          ++it )
+    {
+        if ( (*it)->posCount() > KICKER_LOST_COUNT )
+        {
+            continue;
+        }
+
+        if ( unum < 0
+             ? (*it)->unum() == rcsc::Unum_Unknown
+             : (*it)->unum() == unum )
+        {
+            *dist = (*it)->distFromBall();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,219 @@
+// -*-c++-*-
+
+/*!
+  \file set_play_coordinator.h
+  \brief event driven set play positioning and kicker assignment Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef OBAKE_SET_PLAY_COORDINATOR_H
+#define OBAKE_SET_PLAY_COORDINATOR_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_mode.h>
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+class Formation;
+class WorldModel;
+}
+
+class Strategy;
+
+/*!
+  \class SetPlayCoordinator
+  \brief caches the team positioning and the kicker during one set play.
+
+  The positions of all teammates are computed at the playmode change,
+  and are computed again only when one of the following events is
+  detected:
+  - the ball moved (the placed ball is static during the set play)
+  - a teammate is substituted
+  - the offside line moved
+  - the formation is switched
+
+  The kicker is also assigned at the playmode change, and is kept
+  during the set play. It is reassigned only when:
+  - the assigned kicker is lost from view
+  - another player is clearly nearer to the ball than the assigned kicker
+ */
+class SetPlayCoordinator {
+public:
+
+    /*!
+      \enum Event
+      \brief the reason of the update
+     */
+    enum Event {
+        NO_EVENT,
+        PLAYMODE_CHANGED,
+        BALL_MOVED,
+        SUBSTITUTED,
+        OFFSIDE_LINE_MOVED,
+        FORMATION_CHANGED
+    };
+
+private:
+
+    //! ball moved threshold
+    static const double BALL_MOVE_THR;
+    //! offside line moved threshold
+    static const double OFFSIDE_MOVE_THR;
+    //! the kicker is lost if its accuracy count exceeds this value
+    static const int KICKER_LOST_COUNT;
+    //! the distance rate that another player must be nearer to the ball
+    static const double KICKER_NEARER_RATE;
+
+    //! the start time of the cached set play
+    rcsc::GameTime M_start_time;
+    //! the playmode type of the cached set play
+    rcsc::GameMode::Type M_mode_type;
+    //! the playmode side of the cached set play
+    rcsc::SideID M_mode_side;
+
+    //! the formation used for the cached positions
+    const rcsc::Formation * M_formation;
+    //! the ball position used for the cached positions
+    rcsc::Vector2D M_ball_pos;
+    //! true if the ball position was valid
+    bool M_ball_valid;
+    //! the offside line used for the cached positions
+    double M_offside_line_x;
+    //! the teammate player types used for the cached positions
+    int M_teammate_types[11];
+
+    //! the cached positions. index is (unum - 1)
+    rcsc::Vector2D M_positions[11];
+
+    //! the last time when the kicker is checked
+    rcsc::GameTime M_kicker_time;
+    //! the start time of the set play when the kicker is assigned
+    rcsc::GameTime M_kicker_start_time;
+    //! the kicker's uniform number. 0: nobody, -1: unknown teammate
+    int M_kicker_unum;
+
+    //! the number of position updates, for debugging
+    long M_update_count;
+
+    // private for singleton
+    SetPlayCoordinator();
+
+    // not used
+    SetPlayCoordinator( const SetPlayCoordinator & );
+    SetPlayCoordinator & operator=( const SetPlayCoordinator & );
+
+public:
+
+    /*!
+      \brief get the singleton instance
+      \return reference to the instance
+     */
+    static
+    SetPlayCoordinator & instance();
+
+    /*!
+      \brief check the events, and update the positions if needed
+      \param wm const reference to the world model
+      \param strategy const reference to the team strategy
+      \param formation const reference to the current formation
+      \return detected event. NO_EVENT if cached positions are used.
+     */
+    Event update( const rcsc::WorldModel & wm,
+                  const Strategy & strategy,
+                  const rcsc::Formation & formation );
+
+    /*!
+      \brief get the cached set play position
+      \param unum uniform number [1,11]
+      \return const reference to the position
+     */
+    const
+    rcsc::Vector2D & position( const int unum ) const
+      {
+          return M_positions[ ( unum < 1 || 11 < unum ) ? 0 : unum - 1 ];
+      }
+
+    /*!
+      \brief check if this player is the assigned kicker
+      \param wm const reference to the world model
+      \return true if this player should kick the ball
+
+      The assignment is kept during the set play, and is checked for
+      contradictions at most once per cycle.
+     */
+    bool isKicker( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief get the assigned kicker
+      \return kicker's uniform number. 0: nobody, -1: unknown teammate
+     */
+    int kickerUnum() const
+      {
+          return M_kicker_unum;
+      }
+
+    /*!
+      \brief get the number of position updates
+      \return update count
+     */
+    long updateCount() const
+      {
+          return M_update_count;
+      }
+
+private:
+
+    /*!
+      \brief detect the event since the last update
+      \param wm const reference to the world model
+      \param formation const reference to the current formation
+      \return detected event
+     */
+    Event detectEvent( const rcsc::WorldModel & wm,
+                       const rcsc::Formation & formation ) const;
+
+    /*!
+      \brief assign the kicker by the current observation
+      \param wm const reference to the world model
+      \return kicker's uniform number
+     */
+    static
+    int assign_kicker( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief get the observed ball distance of the player
+      \param wm const reference to the world model
+      \param unum player's uniform number. -1: unknown teammate
+      \param dist pointer to the variable to store the result
+      \return true if the player is observed
+     */
+    static
+    bool get_ball_dist( const rcsc::WorldModel & wm,
+                        const int unum,
+                        double * dist );
+};
+
+#endif
@@ -52,6 +52,7 @@
 #include <rcsc/formation/formation_dt.h>
 #include <rcsc/formation/formation_ngnet.h>
 #include <rcsc/formation/formation_uva.h>
+#include <rcsc/formation/formation_grid.h>
 
 #include <rcsc/player/intercept_table.h>
 #include <rcsc/player/world_model.h>
@@ -85,6 +86,7 @@ Strategy::Strategy()
     , M_goal_kick_our_pos( 11 )
     , M_goalie_catch_opp_pos( 11 )
     , M_goalie_catch_our_pos( 11 )
+    , M_formation_grid_step( 0.0 )
 {
     M_role_factory[RoleSample::name()] = &RoleSample::create;
 
@@ -242,6 +244,22 @@ Strategy::readFormation( const std::string & filepath )
         }
     }
 
+    if ( M_formation_grid_step > 0.0 )
+    {
+        boost::shared_ptr< rcsc::FormationGrid >
+            grid( new rcsc::FormationGrid( ptr, M_formation_grid_step ) );
+
+        double max_error = 0.0, average_error = 0.0;
+        grid->checkError( max_error, average_error );
+        std::cout << "formation grid [" << filepath << "]"
+                  << " step=" << grid->step()
+                  << " max_error=" << max_error
+                  << " average_error=" << average_error
+                  << std::endl;
+
+        ptr = grid;
+    }
+
     return ptr;
 }
 
@@ -395,8 +413,8 @@ Strategy::createRole( const int number,
 rcsc::Vector2D
 Strategy::getBeforeKickOffPos( const int number ) const
 {
-    return M_before_kick_off_formation->getPosition( number,
-                                                     rcsc::Vector2D( 0.0, 0.0 ) );
+    return M_before_kick_off_formation->getCachedPosition( number,
+                                                           rcsc::Vector2D( 0.0, 0.0 ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -512,7 +530,7 @@ Strategy::getSetPlayPosition( const int number,
     rcsc::Vector2D base_pos( 0.0, 0.0 );
     if ( ! world.ball().posValid() )
     {
-        return formation.getPosition( number, base_pos );
+        return formation.getCachedPosition( number, base_pos );
     }
 
 
@@ -552,7 +570,7 @@ Strategy::getSetPlayPosition( const int number,
                                base_pos.x - 10.0 );
     }
 
-    rcsc::Vector2D home_pos = formation.getPosition( number, base_pos );
+    rcsc::Vector2D home_pos = formation.getCachedPosition( number, base_pos );
 
     // to onside
     if ( rcsc::ServerParam::i().useOffside() )
@@ -82,9 +82,17 @@ private:
     FormationPtr M_kickin_our_formation;
     FormationPtr M_setplay_our_formation;
 
+    //! if positive, formations are replaced by rcsc::FormationGrid
+    double M_formation_grid_step;
+
 public:
     Strategy();
 
+    void setFormationGridStep( const double & step )
+      {
+          M_formation_grid_step = step;
+      }
+
     bool read( const std::string & config_dir );
 
 
@@ -41,6 +41,7 @@
 #include "body_kick_one_step.h"
 #include "body_kick_two_step.h"
 #include "body_kick_multi_step.h"
+#include "kick_oracle.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/player/debug_client.h>
@@ -107,12 +108,9 @@ Body_AdvanceBall::execute( PlayerAgent * agent )
     }
     else
     {
-        Vector2D one_step_vel
-            = Body_KickOneStep::get_max_possible_vel
-            ( ( target_point - wm.ball().pos() ).th(),
-              wm.self().kickRate(),
-              wm.ball().vel() );
-        if ( one_step_vel.r() > 2.0 )
+        double one_step_speed
+            = KickOracle::get( wm ).maxSpeed( ( target_point - wm.ball().pos() ).th() );
+        if ( one_step_speed > 2.0 )
         {
             Body_KickOneStep( target_point,
                               ServerParam::i().ballSpeedMax()
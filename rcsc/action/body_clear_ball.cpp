@@ -39,6 +39,7 @@
 #include "body_kick_one_step.h"
 #include "body_kick_two_step.h"
 #include "body_kick_multi_step.h"
+#include "kick_oracle.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/player/debug_client.h>
@@ -131,13 +132,11 @@ Body_ClearBall::execute( PlayerAgent * agent )
     }
     else
     {
-        Vector2D one_step_vel
-            = Body_KickOneStep::get_max_possible_vel
-            ( ( target_point - agent->world().ball().pos() ).th(),
-              agent->world().self().kickRate(),
-              agent->world().ball().vel() );
+        double one_step_speed
+            = KickOracle::get( agent->world() )
+            .maxSpeed( ( target_point - agent->world().ball().pos() ).th() );
 
-        if ( one_step_vel.r() > 2.0 )
+        if ( one_step_speed > 2.0 )
         {
             Body_KickOneStep( target_point,
                               ServerParam::i().ballSpeedMax()
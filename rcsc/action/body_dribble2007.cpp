@@ -44,6 +44,7 @@
 #include <rcsc/action/body_kick_to_relative.h>
 #include <rcsc/action/body_stop_ball.h>
 #include <rcsc/action/neck_scan_field.h>
+#include <rcsc/action/dribble_planner.h>
 
 #include <rcsc/player/audio_sensor.h>
 #include <rcsc/player/player_agent.h>
@@ -57,48 +58,10 @@
 #include <rcsc/soccer_math.h>
 #include <rcsc/math_util.h>
 
-#include <functional>
-
 //#define USE_CHANGE_VIEW
 
 namespace rcsc {
 
-/*!
-  \struct KeepDribbleCmp
-  \brief function object to evaluate the keep dribble
- */
-struct KeepDribbleCmp
-    : public std::binary_function< Body_Dribble2007::KeepDribbleInfo,
-                                   Body_Dribble2007::KeepDribbleInfo,
-                                   bool > {
-    /*!
-      \brief compare operator
-      \param lhs left hand side argument
-      \param rhs right hand side argument
-     */
-    result_type operator()( const first_argument_type & lhs,
-                            const second_argument_type & rhs ) const
-      {
-          if ( lhs.dash_count_ > rhs.dash_count_ )
-          {
-              return true;
-          }
-
-          if ( lhs.dash_count_ == rhs.dash_count_ )
-          {
-              if ( lhs.min_opp_dist_ > 5.0
-                   && rhs.min_opp_dist_ > 5.0 )
-              {
-                  return lhs.ball_forward_travel_ > rhs.ball_forward_travel_;
-              }
-
-              return lhs.min_opp_dist_ > rhs.min_opp_dist_;
-          }
-
-          return false;
-      }
-};
-
 /*-------------------------------------------------------------------*/
 /*!
   execute action
@@ -1132,229 +1095,13 @@ Body_Dribble2007::doKickDashesWithBall( PlayerAgent * agent,
 
     const WorldModel & wm = agent->world();
 
-    // estimate my move positions
-    std::vector< Vector2D > my_state;
-    createSelfCache( agent,
-                     target_point, dash_power,
-                     0, // no turn
-                     std::max( 4, dash_count ),
-                     my_state );
-
-
-    const double collide_dist
-        = wm.self().playerType().playerSize()
-        + ServerParam::i().ballSize();
-    const double kickable_area = wm.self().kickableArea();
-    const double ball_decay = ServerParam::i().ballDecay();
-
-    const Rect2D pitch_rect( - ServerParam::i().pitchHalfLength() + 1.0,
-                             - ServerParam::i().pitchHalfWidth() + 1.0,
-                             ServerParam::i().pitchLength() - 1.0,
-                             ServerParam::i().pitchWidth() - 1.0 );
-
-    const std::vector< Vector2D >::const_iterator my_pos_end = my_state.end();
-
-
-    std::list< KeepDribbleInfo > dribble_info;
-
-    const AngleDeg accel_angle = ( dash_power > 0.0
-                                   ? wm.self().body()
-                                   : wm.self().body() - 180.0 );
-
-    const int DIST_DIVS = 10;
-
-    const double max_dist = wm.self().kickableArea() + 0.2;
-    double first_ball_dist = ( wm.self().playerType().playerSize()
-                               + ServerParam::i().ballSize()
-                               + 0.15 );
-    const double dist_step = ( max_dist - first_ball_dist ) / ( DIST_DIVS - 1 );
-
-    const double angle_range = 240.0;
-    const double angle_range_forward = 160.0;
-    const double arc_dist_step = 0.1;
-
-    int total_loop_count = 0;
-
-    for ( int dist_loop = 0;
-          dist_loop < DIST_DIVS;
-          ++dist_loop, first_ball_dist += dist_step )
-    {
-        const double angle_step
-            = ( arc_dist_step * 360.0 )
-            / ( 2.0 * first_ball_dist * M_PI );
-        const int ANGLE_DIVS
-            = ( first_ball_dist < wm.self().kickableArea() - 0.1
-                ? static_cast< int >( std::ceil( angle_range / angle_step ) ) + 1
-                : static_cast< int >( std::ceil( angle_range_forward / angle_step ) ) + 1 );
-
-        AngleDeg first_ball_angle = accel_angle - angle_step * ( ANGLE_DIVS/2 );
-
-        // angle loop
-        for ( int angle_loop = 0;
-              angle_loop < ANGLE_DIVS;
-              ++angle_loop, first_ball_angle += angle_step )
-        {
-            ++total_loop_count;
-
-            Vector2D ball_pos
-                = my_state.front()
-                + Vector2D::polar2vector( first_ball_dist, first_ball_angle );
-            double min_opp_dist = 1000.0;
-
-            if ( ! pitch_rect.contains( ball_pos ) )
-            {
-                // out of pitch
-                continue;
-            }
-
-            const Vector2D first_ball_vel = ball_pos - wm.ball().pos();
-            const Vector2D first_ball_accel = first_ball_vel - wm.ball().vel();
-            const double first_ball_accel_r = first_ball_accel.r();
-
-            if ( first_ball_vel.r() > ServerParam::i().ballSpeedMax()
-                 || first_ball_accel_r > ServerParam::i().ballAccelMax()
-                 || ( first_ball_accel_r
-                      > wm.self().kickRate() * ServerParam::i().maxPower() )
-                 )
-            {
-                // cannot acccelerate to the desired speed
-                continue;
-            }
-
-            if ( existKickableOpponent( wm, ball_pos, &min_opp_dist ) )
-            {
-                continue;
-            }
-
-            Vector2D ball_vel = first_ball_vel;
-            ball_vel *= ball_decay;
-
-            int tmp_dash_count = 0;
-            Vector2D ball_move;
-
-            // future state loop
-            for ( std::vector< Vector2D >::const_iterator my_pos = my_state.begin() + 1;
-                  my_pos != my_pos_end;
-                  ++my_pos )
-            {
-                ball_pos += ball_vel;
-
-                // out of pitch
-                if ( ! pitch_rect.contains( ball_pos ) ) break;
-
-                const Vector2D ball_rel = ( ball_pos - *my_pos ).rotatedVector( - accel_angle );
-                const double new_ball_dist = ball_rel.r();
-
-                const double ball_travel = ball_pos.dist( wm.ball().pos() );
-                const double my_travel = my_pos->dist( wm.self().pos() );
-
-                // check collision
-                //double dist_buf = std::min( 0.01 * ball_travel + 0.02 * my_travel,
-                //                            0.3 );
-                //if ( new_ball_dist < collide_dist - dist_buf + 0.1 ) break;
-                //double dist_buf = std::min( 0.02 * ball_travel + 0.03 * my_travel,
-                //                            0.3 );
-                //if ( new_ball_dist < collide_dist - dist_buf + 0.15 ) break;
-                //double dist_buf = std::min( 0.02 * ball_travel + 0.03 * my_travel,
-                //                            0.1 );
-                //if ( new_ball_dist < collide_dist - dist_buf + 0.15 ) break;
-                double dist_buf = std::min( 0.02 * ball_travel + 0.03 * my_travel,
-                                            0.1 );
-                if ( new_ball_dist < collide_dist - dist_buf + 0.2 ) break;
-
-                // check kickable
-
-                if ( tmp_dash_count == dash_count - 1
-                     && ball_rel.x > 0.0
-                     && new_ball_dist > kickable_area - 0.25 ) break;
-
-                //dist_buf = std::min( 0.025 * ball_travel + 0.05 * my_travel,
-                //                     0.2 );
-                //if ( new_ball_dist > kickable_area + dist_buf ) break;
-                //if ( new_ball_dist > kickable_area - 0.2 * std::pow( 0.8, tmp_dash_count ) ) break;
-                if ( new_ball_dist > kickable_area - 0.2 ) break;
-
-                // front x buffer
-                dist_buf = std::min( 0.02 * ball_travel + 0.04 * my_travel,
-                                     0.2 );
-                if ( ball_rel.x > kickable_area - dist_buf - 0.2 ) break;
-
-                // side y buffer
-                //dist_buf = std::min( 0.02 * ball_travel + 0.04 + my_travel,
-                //                     0.2 );
-                //if ( ball_rel.absY() > kickable_area - dist_buf - 0.25 ) break;
-                dist_buf = std::min( 0.02 * ball_travel + 0.055 + my_travel,
-                                     0.35 );
-                if ( ball_rel.absY() > kickable_area - dist_buf - 0.15 ) break;
-
-                // check opponent kickable possibility
-                if ( existKickableOpponent( wm, ball_pos, &min_opp_dist ) )
-                {
-                    break;
-                }
-
-                ball_move = ball_pos - wm.ball().pos();
-                ++tmp_dash_count;
-                ball_vel *= ball_decay;
-            }
-#if 0
-            if ( tmp_dash_count >= 1 )
-            {
-                ball_pos = wm.ball().pos() + ball_move;
-                Vector2D ball_rel = ( ball_pos - my_state[tmp_dash_count + 1] ).rotatedVector( - accel_angle );
-                if ( ball_rel.x > 0.2
-                     && ball_rel.r() > kickable_area - 0.4 )//0.15 - ball_travel * 0.05 * 1.1414 )
-                {
-                    continue;
-                }
-            }
-#endif
-            if ( tmp_dash_count <= 0 )
-            {
-                //dlog.addText( Logger::DRIBBLE,
-                //              "_____ failed bdist=%.2f bangle=%.1f"
-                //              " vel=(%.1f %.1f)",
-                //              first_ball_dist,
-                //              (first_ball_angle - accel_angle).degree(),
-                //              first_ball_vel.x, first_ball_vel.y );
-                continue;
-            }
-
-            dribble_info.push_back( KeepDribbleInfo( first_ball_vel,
-                                                     ball_move.rotate( - accel_angle ).x,
-                                                     tmp_dash_count,
-                                                     min_opp_dist ) );
-            dlog.addText( Logger::DRIBBLE,
-                          "_____ add bdist=%.2f bangle=%.1f"
-                          " vel=(%.1f %.1f) dash=%d  opp_dist=%.1f",
-                          first_ball_dist,
-                          //(first_ball_angle - accel_angle).degree(),
-                          first_ball_angle.degree(),
-                          first_ball_vel.x, first_ball_vel.y,
-                          tmp_dash_count,
-                          min_opp_dist );
-        }
-    }
-
-    dlog.addText( Logger::DRIBBLE,
-                  "___ total loop = %d, solution size = %d",
-                  total_loop_count, dribble_info.size() );
-
-    if ( dribble_info.empty() )
-    {
-        dlog.addText( Logger::DRIBBLE,
-                      "%s: doKickDashesWithBall() WARNING. no solution!"
-                      ,__FILE__ );
-
-        return false;
-    }
-
-    std::list< KeepDribbleInfo >::const_iterator dribble
-        = std::min_element( dribble_info.begin(),
-                            dribble_info.end(),
-                            KeepDribbleCmp() );
-
-    if ( dribble == dribble_info.end() )
+    DribblePlanner::Plan dribble;
+    if ( ! DribblePlanner::instance().plan( agent,
+                                            target_point,
+                                            dash_power,
+                                            dash_count,
+                                            std::max( 4, dash_count ),
+                                            dribble ) )
     {
         dlog.addText( Logger::DRIBBLE,
                       "%s: doKickDashesWithBall() WARNING. no solution!"
@@ -1363,47 +1110,43 @@ Body_Dribble2007::doKickDashesWithBall( PlayerAgent * agent,
     }
 
     if ( dodge_mode
-         && dash_count > dribble->dash_count_ )
+         && dash_count > dribble.dash_count_ )
     {
         dlog.addText( Logger::DRIBBLE,
                       "%s: doKickDashesWithBall() dodge mode. but not found. required_dash=%d found_dash=%d"
                       ,__FILE__,
-                      dash_count, dribble->dash_count_ );
+                      dash_count, dribble.dash_count_ );
         return false;
     }
 
     agent->debugClient().addMessage( "DribKDKeep%d:%.0f",
-                                     dribble->dash_count_,
+                                     dribble.dash_count_,
                                      dash_power );
 
     dlog.addText( Logger::DRIBBLE,
                   "%s: doKickDashesWithBall() dash_count=%d, ball_vel=(%.1f %.1f) ball_travel_x=%.1f"
                   ,__FILE__,
-                  dribble->dash_count_,
-                  dribble->first_ball_vel_.x,
-                  dribble->first_ball_vel_.y,
-                  dribble->ball_forward_travel_ );
+                  dribble.dash_count_,
+                  dribble.first_ball_vel_.x,
+                  dribble.first_ball_vel_.y,
+                  dribble.forward_travel_ );
 
 #ifdef DEBUG
     {
         Vector2D ball_pos = wm.ball().pos();
-        Vector2D ball_vel = dribble->first_ball_vel_;
-        const int DASH = dribble->dash_count_ + 1;
+        Vector2D ball_vel = dribble.first_ball_vel_;
+        const int DASH = dribble.dash_count_ + 1;
         for ( int i = 0; i < DASH; ++i )
         {
             ball_pos += ball_vel;
             ball_vel *= ServerParam::i().ballDecay();
             dlog.addCircle( Logger::DRIBBLE,
                             ball_pos, 0.05, "#0000FF" );
-            dlog.addCircle( Logger::DRIBBLE,
-                            my_state[i], wm.self().kickableArea(), "#0000FF" );
-            //agent->debugClient().addCircle( ball_pos, 0.05 );
-            //agent->debugClient().addCircle( my_state[i], wm.self().kickableArea() );
         }
     }
 #endif
 
-    Vector2D kick_accel = dribble->first_ball_vel_ - wm.ball().vel();
+    Vector2D kick_accel = dribble.first_ball_vel_ - wm.ball().vel();
 
     // execute first kick
     agent->doKick( kick_accel.r() / wm.self().kickRate(),
@@ -1417,13 +1160,13 @@ Body_Dribble2007::doKickDashesWithBall( PlayerAgent * agent,
         ( new IntentionDribble2007( target_point,
                                     M_dist_thr,
                                     0, // zero turn
-                                    std::min( dribble->dash_count_, dash_count ),
+                                    std::min( dribble.dash_count_, dash_count ),
                                     std::fabs( dash_power ),
                                     ( dash_power < 0.0 ), // back_dash
                                     wm.time() ) );
-    say( agent, target_point, std::min( dribble->dash_count_, dash_count ) );
+    say( agent, target_point, std::min( dribble.dash_count_, dash_count ) );
 #ifdef USE_CHANGE_VIEW
-    if ( std::min( dribble->dash_count_, dash_count ) >= 2 )
+    if ( std::min( dribble.dash_count_, dash_count ) >= 2 )
     {
         agent->setViewAction( new View_Normal() );
     }
@@ -1531,70 +1274,6 @@ Body_Dribble2007::createSelfCache( PlayerAgent * agent,
     }
 }
 
-/*-------------------------------------------------------------------*/
-/*!
-
-*/
-bool
-Body_Dribble2007::existKickableOpponent( const WorldModel & wm,
-                                         const Vector2D & ball_pos,
-                                         double * min_opp_dist ) const
-{
-    static const double kickable_area
-        = ServerParam::i().defaultKickableArea() + 0.2;
-
-    const PlayerPtrCont::const_iterator end = wm.opponentsFromSelf().end();
-    for ( PlayerPtrCont::const_iterator it = wm.opponentsFromSelf().begin();
-          it != end;
-          ++it )
-    {
-        if ( (*it)->posCount() > 5 )
-        {
-            continue;
-        }
-
-        if ( (*it)->distFromSelf() > 30.0 )
-        {
-            break;
-        }
-
-        // goalie's catchable check
-        if ( (*it)->goalie() )
-        {
-            if ( ball_pos.x > ServerParam::i().theirPenaltyAreaLineX()
-                 && ball_pos.absY() < ServerParam::i().penaltyAreaHalfWidth() )
-            {
-                double d = (*it)->pos().dist( ball_pos );
-                if ( d < ServerParam::i().catchableArea() )
-                {
-                    return true;
-                }
-
-                d -= ServerParam::i().catchableArea();
-                if ( *min_opp_dist > d )
-                {
-                    *min_opp_dist = d;
-                }
-            }
-        }
-
-        // normal kickable check
-        double d = (*it)->pos().dist( ball_pos );
-        if ( d < kickable_area )
-        {
-            return true;
-        }
-
-        if ( *min_opp_dist > d )
-        {
-            *min_opp_dist = d;
-        }
-    }
-
-    return false;
-}
-
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -238,10 +238,6 @@ private:
                           const int dash_count,
                           std::vector< Vector2D > & self_cache );
 
-    bool existKickableOpponent( const WorldModel & wm,
-                                const Vector2D & ball_pos,
-                                double * min_opp_dist ) const;
-
     /*!
       \brief try to perform new dribble to avoid opponent
       \param agent pointer to the agent itself
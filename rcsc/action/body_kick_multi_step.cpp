@@ -40,6 +40,7 @@
 #include "body_kick_two_step.h"
 #include "body_stop_ball.h"
 #include "body_hold_ball.h"
+#include "kick_table.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/logger.h>
@@ -48,6 +49,66 @@
 
 namespace rcsc {
 
+#ifdef DEBUG_KICK_TABLE
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compare the kick table result with the original simulation
+*/
+void
+debug_compare( const PlayerAgent * agent,
+               const Vector2D & target_point,
+               const double & first_speed,
+               const KickTable::Sequence & seq )
+{
+    const WorldModel & wm = agent->world();
+    const Vector2D target_rpos = target_point - wm.self().pos();
+
+    Vector2D achieved_vel;
+    Vector2D next_vel;
+    int step = 0;
+
+    if ( Body_KickTwoStep::simulate_one_kick( &achieved_vel, NULL, NULL,
+                                              target_rpos, first_speed,
+                                              Vector2D( 0.0, 0.0 ),
+                                              wm.self().vel(), wm.self().body(),
+                                              wm.ball().rpos(), wm.ball().vel(),
+                                              agent, false ) )
+    {
+        step = 1;
+    }
+    else if ( Body_KickTwoStep::simulate_two_kick( &achieved_vel, &next_vel,
+                                                   target_rpos, first_speed,
+                                                   Vector2D( 0.0, 0.0 ),
+                                                   wm.self().vel(), wm.self().body(),
+                                                   wm.ball().rpos(), wm.ball().vel(),
+                                                   agent, false ) )
+    {
+        step = 2;
+    }
+    else if ( Body_KickMultiStep::simulate_three_kick( &achieved_vel, &next_vel,
+                                                       target_rpos, first_speed,
+                                                       Vector2D( 0.0, 0.0 ),
+                                                       wm.self().vel(), wm.self().body(),
+                                                       wm.ball().rpos(), wm.ball().vel(),
+                                                       agent, false ) )
+    {
+        step = 3;
+    }
+
+    dlog.addText( Logger::KICK,
+                  "%s:%d: (debug_compare) table step=%d speed=%.3f"
+                  "  simulation step=%d speed=%.3f%s"
+                  ,__FILE__, __LINE__,
+                  seq.step_, seq.achieved_vel_.r(),
+                  step, achieved_vel.r(),
+                  ( seq.step_ != step ? "  ***DIFFERENT***" : "" ) );
+}
+
+}
+#endif
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -71,125 +132,45 @@ Body_KickMultiStep::execute( PlayerAgent * agent )
     }
 
     //-------------------------------------------
-    Vector2D target_rpos = M_target_point - agent->world().self().pos();
     M_first_speed = std::min( M_first_speed, ServerParam::i().ballSpeedMax() );
 
-    Vector2D achieved_vel;
-
-    dlog.addText( Logger::KICK,
-                  "%s:%d: simulate one kick"
-                  ,__FILE__, __LINE__ );
-    if ( Body_KickTwoStep::simulate_one_kick( &achieved_vel,
-                                              NULL,
-                                              NULL,
-                                              target_rpos,
-                                              M_first_speed,
-                                              Vector2D( 0.0, 0.0 ), // my current pos
-                                              agent->world().self().vel(),
-                                              agent->world().self().body(),
-                                              agent->world().ball().rpos(),
-                                              agent->world().ball().vel(),
-                                              agent,
-                                              false ) ) // not enforce
-    {
-        Vector2D accel = achieved_vel - agent->world().ball().vel();
-        double kick_power = accel.r() / agent->world().self().kickRate();
-        AngleDeg kick_dir = accel.th() - agent->world().self().body();
-
-        dlog.addText( Logger::KICK,
-                      "%s:%d: only one kick"
-                      "   result=(%.3f, %.3f)[r=%.3f]  accel=(%.3f, %.3f)  power=%.1f dir=%.1f"
-                      ,__FILE__, __LINE__,
-                      achieved_vel.x, achieved_vel.y, achieved_vel.r(),
-                      accel.x, accel.y,
-                      kick_power, kick_dir.degree() );
-        M_ball_result_pos = agent->world().ball().pos() + achieved_vel;
-        M_ball_result_vel = achieved_vel * ServerParam::i().ballDecay();;
-        M_kick_step = 1;
-
-        return agent->doKick( kick_power, kick_dir );
-    }
-
-
-    dlog.addText( Logger::KICK,
-                  "%s:%d: simulate two kick"
-                  ,__FILE__, __LINE__ );
-
-    Vector2D next_vel;
-
-    if ( Body_KickTwoStep::simulate_two_kick( &achieved_vel,
-                                              &next_vel,
-                                              target_rpos,
-                                              M_first_speed,
-                                              Vector2D( 0.0, 0.0 ), // my current pos
-                                              agent->world().self().vel(),
-                                              agent->world().self().body(),
-                                              agent->world().ball().rpos(),
-                                              agent->world().ball().vel(),
-                                              agent,
-                                              false ) ) // not enforced
+    KickTable::Sequence seq;
+    if ( KickTable::instance().plan( agent,
+                                     M_target_point,
+                                     M_first_speed,
+                                     3,
+                                     false, // not enforce
+                                     seq ) )
     {
-        Vector2D accel = next_vel - agent->world().ball().vel();
-        double kick_power = accel.r() / agent->world().self().kickRate();
-        AngleDeg kick_dir = accel.th() - agent->world().self().body();
+        const Vector2D accel = seq.first_vel_ - agent->world().ball().vel();
+        const double kick_power = accel.r() / agent->world().self().kickRate();
+        const AngleDeg kick_dir = accel.th() - agent->world().self().body();
 
         dlog.addText( Logger::KICK,
-                      "%s:%d: two kick."
-                      "  result=(%.3f, %.3f)[r=%.3f]  next_bvel=(%.3f, %.3f)[r=%.3f]"
-                      "      accel=(%.3f, %.3f)  power=%.1f dir=%.1f"
-                      ,__FILE__, __LINE__,
-                      achieved_vel.x, achieved_vel.y, achieved_vel.r(),
-                      next_vel.x, next_vel.y, next_vel.r(),
-                      accel.x, accel.y,
-                      kick_power, kick_dir.degree() );
-        agent->debugClient().addCircle( agent->world().ball().pos() + next_vel,
-                                        0.05 );
-        M_ball_result_pos = agent->world().ball().pos() + next_vel;
-        M_ball_result_vel = next_vel * ServerParam::i().ballDecay();;
-        M_kick_step = 2;
-
-        return agent->doKick( kick_power, kick_dir );
-    }
-
-    dlog.addText( Logger::KICK,
-                  "%s:%d: simulate three kick"
-                  ,__FILE__, __LINE__ );
-
-    if ( simulate_three_kick( &achieved_vel,
-                              &next_vel,
-                              target_rpos,
-                              M_first_speed,
-                              Vector2D( 0.0, 0.0 ), // my current pos
-                              agent->world().self().vel(),
-                              agent->world().self().body(),
-                              agent->world().ball().rpos(),
-                              agent->world().ball().vel(),
-                              agent,
-                              false ) )
-    {
-        Vector2D accel = next_vel - agent->world().ball().vel();
-        double kick_power = accel.r() / agent->world().self().kickRate();
-        AngleDeg kick_dir = accel.th() - agent->world().self().body();
-
-        dlog.addText( Logger::KICK,
-                      "%s:%d: three kick."
+                      "%s:%d: kick table. step=%d"
                       "   result=(%.3f, %.3f)[r=%.3f]  next_bvel=(%.3f, %.3f)[r=%.3f]"
                       "   accel=(%.3f, %.3f)  power=%.1f dir=%.1f"
                       ,__FILE__, __LINE__,
-                      achieved_vel.x, achieved_vel.y, achieved_vel.r(),
-                      next_vel.x, next_vel.y, next_vel.r(),
+                      seq.step_,
+                      seq.achieved_vel_.x, seq.achieved_vel_.y, seq.achieved_vel_.r(),
+                      seq.first_vel_.x, seq.first_vel_.y, seq.first_vel_.r(),
                       accel.x, accel.y,
                       kick_power, kick_dir.degree() );
-        agent->debugClient().addCircle( agent->world().ball().pos() + next_vel,
-                                        0.05 );
-        M_ball_result_pos = agent->world().ball().pos() + next_vel;
-        M_ball_result_vel = next_vel * ServerParam::i().ballDecay();;
-        M_kick_step = 3;
+#ifdef DEBUG_KICK_TABLE
+        debug_compare( agent, M_target_point, M_first_speed, seq );
+#endif
+        if ( seq.step_ > 1 )
+        {
+            agent->debugClient().addCircle( agent->world().ball().pos() + seq.first_vel_,
+                                            0.05 );
+        }
+        M_ball_result_pos = agent->world().ball().pos() + seq.first_vel_;
+        M_ball_result_vel = seq.first_vel_ * ServerParam::i().ballDecay();
+        M_kick_step = seq.step_;
 
         return agent->doKick( kick_power, kick_dir );
     }
 
-
     if ( M_enforce_kick )
     {
         dlog.addText( Logger::KICK,
@@ -39,6 +39,7 @@
 #include "body_kick_one_step.h"
 #include "body_hold_ball.h"
 #include "body_kick_to_relative.h"
+#include "kick_table.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/logger.h>
@@ -81,69 +82,34 @@ Body_KickTwoStep::execute( PlayerAgent * agent )
     Vector2D target_rpos = M_target_point - wm.self().pos();
     M_first_speed = std::min( M_first_speed, ServerParam::i().ballSpeedMax() );
 
-    Vector2D achieved_vel;
-
-    if ( simulate_one_kick( &achieved_vel,
-                            NULL,
-                            NULL,
-                            target_rpos,
-                            M_first_speed,
-                            Vector2D( 0.0, 0.0 ), // my current pos
-                            wm.self().vel(),
-                            wm.self().body(),
-                            wm.ball().rpos(),
-                            wm.ball().vel(),
-                            agent,
-                            false ) ) // not enforce
+    KickTable::Sequence seq;
+    if ( KickTable::instance().plan( agent,
+                                     M_target_point,
+                                     M_first_speed,
+                                     2,
+                                     M_enforce_kick,
+                                     seq ) )
     {
-        Vector2D accel = achieved_vel - wm.ball().vel();
-        double kick_power = accel.r() / wm.self().kickRate();
-        AngleDeg kick_dir = accel.th() - wm.self().body();
-
-        dlog.addText( Logger::KICK,
-                      "%s:%d: only one step. result=(%.3f, %.3f) r=%.3f"
-                      " accel=(%.3f, %.3f) power=%.1f dir=%.1f"
-                      ,__FILE__, __LINE__,
-                      achieved_vel.x, achieved_vel.y, achieved_vel.r(),
-                      accel.x, accel.y,
-                      kick_power, kick_dir.degree() );
-        M_ball_result_pos = wm.ball().pos() + achieved_vel;
-        M_ball_result_vel = achieved_vel * ServerParam::i().ballDecay();;
-        M_kick_step = 1;
+        Vector2D next_vel = seq.first_vel_;
+        Vector2D result_vel = seq.achieved_vel_;
+        M_kick_step = seq.step_;
 
-        return agent->doKick( kick_power, kick_dir );
-    }
-
-
-    Vector2D next_vel;
-    if ( simulate_two_kick( &achieved_vel,
-                            &next_vel,
-                            target_rpos,
-                            M_first_speed,
-                            Vector2D( 0.0, 0.0 ), // my current pos
-                            wm.self().vel(),
-                            wm.self().body(),
-                            wm.ball().rpos(),
-                            wm.ball().vel(),
-                            agent,
-                            M_enforce_kick ) )
-    {
-        M_kick_step = 2;
-
-        if ( M_enforce_kick
-             && next_vel.r2() < square( M_first_speed ) )
+        if ( seq.step_ == 2
+             && M_enforce_kick
+             && seq.achieved_vel_.r2() < square( M_first_speed ) )
         {
             Vector2D one_kick_max_vel
                 = Body_KickOneStep::get_max_possible_vel( ( target_rpos - wm.ball().rpos() ).th(),
                                                           wm.self().kickRate(),
                                                           wm.ball().vel() );
-            if ( one_kick_max_vel.r2() > next_vel.r2() )
+            if ( one_kick_max_vel.r2() > result_vel.r2() )
             {
                 next_vel = one_kick_max_vel;
+                result_vel = one_kick_max_vel;
                 M_kick_step = 1;
             }
 
-            if ( next_vel.r() < M_first_speed * 0.9 )
+            if ( result_vel.r() < M_first_speed * 0.9 )
             {
                 dlog.addText( Logger::KICK,
                               "%s:%d: failed enforce kick. hold ball"
@@ -161,16 +127,20 @@ Body_KickTwoStep::execute( PlayerAgent * agent )
         AngleDeg kick_dir = accel.th() - wm.self().body();
 
         dlog.addText( Logger::KICK,
-                      "%s:%d: two step. result=(%.3f, %.3f)r=%.3f"
+                      "%s:%d: step=%d. result=(%.3f, %.3f)r=%.3f"
                       " next_vel=(%.3f, %.3f)r=%.3f"
                       " accel=(%.3f, %.3f) power=%.1f dir=%.1f"
                       ,__FILE__, __LINE__,
-                      achieved_vel.x, achieved_vel.y, achieved_vel.r(),
+                      M_kick_step,
+                      result_vel.x, result_vel.y, result_vel.r(),
                       next_vel.x, next_vel.y, next_vel.r(),
                       accel.x, accel.y,
                       kick_power, kick_dir.degree() );
-        agent->debugClient().addCircle( wm.ball().pos() + next_vel,
-                                        0.05 );
+        if ( M_kick_step > 1 )
+        {
+            agent->debugClient().addCircle( wm.ball().pos() + next_vel,
+                                            0.05 );
+        }
         M_ball_result_pos = wm.ball().pos() + next_vel;
         M_ball_result_vel = next_vel * ServerParam::i().ballDecay();
 
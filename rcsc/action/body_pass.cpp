@@ -40,6 +40,7 @@
 #include "body_kick_multi_step.h"
 #include "body_stop_ball.h"
 #include "body_hold_ball.h"
+#include "kick_oracle.h"
 
 #include <rcsc/player/interception.h>
 #include <rcsc/player/player_agent.h>
@@ -1444,10 +1445,7 @@ Body_Pass::can_kick_by_one_step( const WorldModel & world,
                                  const double & first_speed,
                                  const AngleDeg & target_angle )
 {
-    Vector2D required_accel = Vector2D::polar2vector( first_speed, target_angle );
-    required_accel -= world.ball().vel();
-    return ( world.self().kickRate() * ServerParam::i().maxPower()
-             > required_accel.r() );
+    return KickOracle::get( world ).canKick( first_speed, target_angle );
 }
 
 }
@@ -40,6 +40,7 @@
 #include <rcsc/action/body_kick_one_step.h>
 #include <rcsc/action/body_kick_two_step.h>
 #include <rcsc/action/body_kick_multi_step.h>
+#include <rcsc/action/kick_oracle.h>
 #include <rcsc/action/body_stop_ball.h>
 
 #include <rcsc/player/interception.h>
@@ -107,11 +108,8 @@ Body_Shoot::execute( PlayerAgent * agent )
     agent->debugClient().addMessage( "Shoot" );
     agent->debugClient().setTarget( target_point );
 
-    Vector2D one_step_vel
-        = Body_KickOneStep::get_max_possible_vel( ( target_point - agent->world().ball().pos() ).th(),
-                                                  agent->world().self().kickRate(),
-                                                  agent->world().ball().vel() );
-    double one_step_speed = one_step_vel.r();
+    double one_step_speed
+        = KickOracle::get( agent->world() ).maxSpeed( ( target_point - agent->world().ball().pos() ).th() );
 
     dlog.addText( Logger::SHOOT,
                   "%s:%d: shoot to (%.2f, %.2f) speed=%.2f one_kick_max_speed=%.2f"
@@ -0,0 +1,554 @@
+// -*-c++-*-
+
+/*!
+  \file dribble_planner.cpp
+  \brief time bounded dribble sequence planner
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "dribble_planner.h"
+
+#include "kick_oracle.h"
+#include "kick_table.h"
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/timer.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+const int DribblePlanner::MAX_STEP;
+const int DribblePlanner::BEAM_WIDTH;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DribblePlanner::DribblePlanner()
+    : M_max_samples( 500 )
+    , M_last_time( -1, 0 )
+    , M_last_target( Vector2D::INVALIDATED )
+    , M_elapsed_msec( 0.0 )
+    , M_evaluated_count( 0 )
+    , M_reused_count( 0 )
+{
+    M_beam.reserve( BEAM_WIDTH + 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DribblePlanner &
+DribblePlanner::instance()
+{
+    static DribblePlanner S_instance;
+    return S_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DribblePlanner::plan( const PlayerAgent * agent,
+                      const Vector2D & target_point,
+                      const double & dash_power,
+                      const int dash_count,
+                      const int max_dash,
+                      Plan & result )
+{
+    const MSecTimer timer;
+    const WorldModel & wm = agent->world();
+
+    result = Plan();
+
+    M_evaluated_count = 0;
+    M_reused_count = 0;
+
+    //
+    // self states
+    //
+    SelfStates self_states;
+    create_self_states( wm, dash_power,
+                        std::min( std::max( max_dash, 1 ), MAX_STEP ),
+                        self_states );
+    self_states.last_dash_ = dash_count;
+
+    std::vector< Plan > beam;
+    beam.reserve( BEAM_WIDTH + 1 );
+
+    //
+    // seeds from the previous search
+    //
+    if ( M_last_target.valid()
+         && M_last_target.dist2( target_point ) < 1.0
+         && M_last_time.cycle() + MAX_STEP >= wm.time().cycle() )
+    {
+        for ( std::vector< Plan >::const_iterator p = M_beam.begin();
+              p != M_beam.end();
+              ++p )
+        {
+            Plan candidate;
+            candidate.ball_rel_ = p->ball_rel_;
+            ++M_evaluated_count;
+            if ( simulate( wm, self_states, candidate ) )
+            {
+                ++M_reused_count;
+                insert_beam( candidate, beam );
+            }
+        }
+    }
+
+    //
+    // coarse grid
+    //
+    const KickTable::Table & table = KickTable::instance().table( wm.self().playerType() );
+    for ( std::vector< KickTable::State >::const_iterator k = table.states_.begin();
+          k != table.states_.end();
+          ++k )
+    {
+        Plan candidate;
+        candidate.ball_rel_ = k->pos_;
+        ++M_evaluated_count;
+        if ( simulate( wm, self_states, candidate ) )
+        {
+            insert_beam( candidate, beam );
+        }
+    }
+
+    //
+    // random refinement around the beam, or uniform in the kickable area.
+    // the engine is seeded by the fixed value, so that the result does
+    // not depend on the machine load.
+    //
+    const double min_dist = ( wm.self().playerType().playerSize()
+                              + ServerParam::i().ballSize()
+                              + 0.15 );
+    const double max_dist = wm.self().kickableArea() + 0.2;
+
+    typedef boost::variate_generator< boost::mt19937 &,
+                                      boost::uniform_real<> > RealGen;
+    boost::mt19937 engine( 5489 );
+    RealGen rng_dist( engine, boost::uniform_real<>( min_dist, max_dist ) );
+    RealGen rng_angle( engine, boost::uniform_real<>( -180.0, 180.0 ) );
+    RealGen rng_noise( engine, boost::uniform_real<>( -1.0, 1.0 ) );
+
+    double radius = 0.2;
+    while ( M_evaluated_count < M_max_samples )
+    {
+        for ( int i = 0; i < BEAM_WIDTH; ++i )
+        {
+            Plan candidate;
+            if ( i < static_cast< int >( beam.size() ) )
+            {
+                candidate.ball_rel_ = beam[i].ball_rel_
+                    + Vector2D( rng_noise() * radius, rng_noise() * radius );
+            }
+            else
+            {
+                candidate.ball_rel_ = Vector2D::polar2vector( rng_dist(), rng_angle() );
+            }
+
+            ++M_evaluated_count;
+            if ( simulate( wm, self_states, candidate ) )
+            {
+                insert_beam( candidate, beam );
+            }
+        }
+
+        radius = std::max( 0.02, radius * 0.8 );
+    }
+
+    M_elapsed_msec = timer.elapsedReal();
+    M_last_time = wm.time();
+    M_last_target = target_point;
+    M_beam = beam;
+
+    dlog.addText( Logger::DRIBBLE,
+                  "%s:%d: (plan) elapsed=%.2f[ms] evaluated=%d reused=%d found=%d"
+                  ,__FILE__, __LINE__,
+                  M_elapsed_msec, M_evaluated_count, M_reused_count,
+                  (int)beam.size() );
+
+    if ( beam.empty() )
+    {
+        return false;
+    }
+
+    result = beam.front();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DribblePlanner::create_self_states( const WorldModel & wm,
+                                    const double & dash_power,
+                                    const int dash_count,
+                                    SelfStates & states )
+{
+    const ServerParam & SP = ServerParam::i();
+    const PlayerType & ptype = wm.self().playerType();
+
+    states.last_dash_ = dash_count;
+    states.accel_angle_ = ( dash_power > 0.0
+                            ? wm.self().body()
+                            : wm.self().body() - 180.0 );
+    states.pos_.clear();
+    states.pos_.reserve( dash_count + 1 );
+
+    double my_stamina = wm.self().stamina();
+    double my_effort = wm.self().effort();
+    double my_recovery = wm.self().recovery();
+
+    Vector2D my_pos = wm.self().pos();
+    Vector2D my_vel = wm.self().vel();
+
+    // kick
+    my_pos += my_vel;
+    my_vel *= ptype.playerDecay();
+    states.pos_.push_back( my_pos );
+
+    ptype.predictStaminaAfterWait( SP,
+                                   1,
+                                   &my_stamina,
+                                   &my_effort,
+                                   my_recovery );
+
+    // dashes
+    for ( int i = 0; i < dash_count; ++i )
+    {
+        double available_stamina
+            =  std::max( 0.0,
+                         my_stamina
+                         - SP.recoverDecThrValue()
+                         - 300.0 );
+        double consumed_stamina = ( dash_power > 0.0
+                                    ? dash_power
+                                    : dash_power * -2.0 );
+        consumed_stamina = std::min( available_stamina,
+                                     consumed_stamina );
+        double used_power = ( dash_power > 0.0
+                              ? consumed_stamina
+                              : consumed_stamina * -0.5 );
+        double max_accel_mag = ( std::fabs( used_power )
+                                 * ptype.dashPowerRate()
+                                 * my_effort );
+        double accel_mag = max_accel_mag;
+        if ( ptype.normalizeAccel( my_vel,
+                                   states.accel_angle_,
+                                   &accel_mag ) )
+        {
+            used_power *= accel_mag / max_accel_mag;
+        }
+
+        my_vel += Vector2D::polar2vector( std::fabs( used_power )
+                                          * my_effort
+                                          * ptype.dashPowerRate(),
+                                          states.accel_angle_ );
+        my_pos += my_vel;
+        my_vel *= ptype.playerDecay();
+
+        states.pos_.push_back( my_pos );
+
+        ptype.predictStaminaAfterDash( SP,
+                                       used_power,
+                                       &my_stamina,
+                                       &my_effort,
+                                       &my_recovery );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DribblePlanner::is_collided( const WorldModel & wm,
+                             const Vector2D & ball_pos,
+                             const Vector2D & my_pos,
+                             const double & ball_rel_dist )
+{
+    const double collide_dist
+        = wm.self().playerType().playerSize()
+        + ServerParam::i().ballSize();
+
+    const double ball_travel = ball_pos.dist( wm.ball().pos() );
+    const double my_travel = my_pos.dist( wm.self().pos() );
+
+    const double dist_buf = std::min( 0.02 * ball_travel + 0.03 * my_travel,
+                                      0.1 );
+    return ball_rel_dist < collide_dist - dist_buf + 0.2;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DribblePlanner::simulate( const WorldModel & wm,
+                          const SelfStates & states,
+                          Plan & plan )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    static const Rect2D pitch_rect( - SP.pitchHalfLength() + 1.0,
+                                    - SP.pitchHalfWidth() + 1.0,
+                                    SP.pitchLength() - 1.0,
+                                    SP.pitchWidth() - 1.0 );
+
+    const double kickable_area = wm.self().kickableArea();
+    const double ball_decay = SP.ballDecay();
+
+    const AngleDeg & accel_angle = states.accel_angle_;
+
+    //
+    // first kick
+    //
+    Vector2D ball_pos = states.pos_.front()
+        + plan.ball_rel_.rotatedVector( accel_angle );
+
+    if ( ! pitch_rect.contains( ball_pos ) )
+    {
+        return false;
+    }
+
+    // the player does not move by the kick
+    if ( is_collided( wm, ball_pos, states.pos_.front(),
+                      ball_pos.dist( states.pos_.front() ) ) )
+    {
+        return false;
+    }
+
+    const Vector2D first_ball_vel = ball_pos - wm.ball().pos();
+    const double max_accel = KickOracle::get( wm ).maxAccel();
+
+    if ( first_ball_vel.r2() > SP.ballSpeedMax() * SP.ballSpeedMax()
+         || ( first_ball_vel - wm.ball().vel() ).r2() > max_accel * max_accel )
+    {
+        return false;
+    }
+
+    double min_opp_dist = 1000.0;
+    if ( exist_kickable_opponent( wm, ball_pos, 1, min_opp_dist ) )
+    {
+        return false;
+    }
+
+    //
+    // rollout
+    //
+    Vector2D ball_vel = first_ball_vel * ball_decay;
+    Vector2D ball_move( 0.0, 0.0 );
+    int dash_count = 0;
+
+    const int size = static_cast< int >( states.pos_.size() );
+    for ( int i = 1; i < size; ++i )
+    {
+        const Vector2D & my_pos = states.pos_[i];
+
+        ball_pos += ball_vel;
+
+        if ( ! pitch_rect.contains( ball_pos ) ) break;
+
+        const Vector2D ball_rel = ( ball_pos - my_pos ).rotatedVector( - accel_angle );
+        const double new_ball_dist = ball_rel.r();
+
+        const double ball_travel = ball_pos.dist( wm.ball().pos() );
+        const double my_travel = my_pos.dist( wm.self().pos() );
+
+        // collision
+        if ( is_collided( wm, ball_pos, my_pos, new_ball_dist ) ) break;
+
+        // the last dash must leave the ball comfortably kickable
+        if ( dash_count == states.last_dash_ - 1
+             && ball_rel.x > 0.0
+             && new_ball_dist > kickable_area - 0.25 ) break;
+
+        // kickable
+        if ( new_ball_dist > kickable_area - 0.2 ) break;
+
+        // front x buffer
+        double dist_buf = std::min( 0.02 * ball_travel + 0.04 * my_travel,
+                                    0.2 );
+        if ( ball_rel.x > kickable_area - dist_buf - 0.2 ) break;
+
+        // side y buffer
+        dist_buf = std::min( 0.02 * ball_travel + 0.055 + my_travel,
+                             0.35 );
+        if ( ball_rel.absY() > kickable_area - dist_buf - 0.15 ) break;
+
+        if ( exist_kickable_opponent( wm, ball_pos, i + 1, min_opp_dist ) ) break;
+
+        ball_move = ball_pos - wm.ball().pos();
+        ball_vel *= ball_decay;
+        ++dash_count;
+    }
+
+    if ( dash_count <= 0 )
+    {
+        return false;
+    }
+
+    plan.first_ball_vel_ = first_ball_vel;
+    plan.dash_count_ = dash_count;
+    plan.forward_travel_ = ball_move.rotatedVector( - accel_angle ).x;
+    plan.min_opp_dist_ = min_opp_dist;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DribblePlanner::exist_kickable_opponent( const WorldModel & wm,
+                                         const Vector2D & ball_pos,
+                                         const int step,
+                                         double & min_opp_dist )
+{
+    static const double kickable_area
+        = ServerParam::i().defaultKickableArea() + 0.2;
+
+    const PlayerPtrCont::const_iterator end = wm.opponentsFromSelf().end();
+    for ( PlayerPtrCont::const_iterator it = wm.opponentsFromSelf().begin();
+          it != end;
+          ++it )
+    {
+        if ( (*it)->posCount() > 5 )
+        {
+            continue;
+        }
+
+        if ( (*it)->distFromSelf() > 30.0 )
+        {
+            break;
+        }
+
+        // opponent inertia movement
+        Vector2D opp_pos = (*it)->pos();
+        if ( (*it)->velCount() <= 2
+             && (*it)->playerTypePtr() )
+        {
+            opp_pos += (*it)->playerTypePtr()->inertiaTravel( (*it)->vel(), step );
+        }
+
+        const double d = opp_pos.dist( ball_pos );
+
+        // goalie's catchable check
+        if ( (*it)->goalie()
+             && ball_pos.x > ServerParam::i().theirPenaltyAreaLineX()
+             && ball_pos.absY() < ServerParam::i().penaltyAreaHalfWidth() )
+        {
+            if ( d < ServerParam::i().catchableArea() )
+            {
+                return true;
+            }
+
+            min_opp_dist = std::min( min_opp_dist,
+                                     d - ServerParam::i().catchableArea() );
+        }
+
+        if ( d < kickable_area )
+        {
+            return true;
+        }
+
+        min_opp_dist = std::min( min_opp_dist, d );
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DribblePlanner::is_better( const Plan & lhs,
+                           const Plan & rhs )
+{
+    if ( lhs.dash_count_ != rhs.dash_count_ )
+    {
+        return lhs.dash_count_ > rhs.dash_count_;
+    }
+
+    if ( lhs.min_opp_dist_ > 5.0
+         && rhs.min_opp_dist_ > 5.0 )
+    {
+        return lhs.forward_travel_ > rhs.forward_travel_;
+    }
+
+    return lhs.min_opp_dist_ > rhs.min_opp_dist_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DribblePlanner::insert_beam( const Plan & plan,
+                             std::vector< Plan > & beam )
+{
+    std::vector< Plan >::iterator it = beam.begin();
+    while ( it != beam.end()
+            && ! is_better( plan, *it ) )
+    {
+        ++it;
+    }
+
+    if ( it == beam.end()
+         && static_cast< int >( beam.size() ) >= BEAM_WIDTH )
+    {
+        return;
+    }
+
+    beam.insert( it, plan );
+
+    if ( static_cast< int >( beam.size() ) > BEAM_WIDTH )
+    {
+        beam.pop_back();
+    }
+}
+
+}
@@ -0,0 +1,284 @@
+// -*-c++-*-
+
+/*!
+  \file dribble_planner.h
+  \brief sample bounded dribble sequence planner
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ACTION_DRIBBLE_PLANNER_H
+#define RCSC_ACTION_DRIBBLE_PLANNER_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/angle_deg.h>
+#include <rcsc/game_time.h>
+
+#include <vector>
+
+namespace rcsc {
+
+class PlayerAgent;
+class WorldModel;
+
+/*!
+  \class DribblePlanner
+  \brief searches "kick -> [dash]*" dribble sequences.
+
+  The first kick is represented by the ball position just after the
+  kick, relative to the player position in the next cycle and rotated
+  by the accel angle. Candidates are generated from the coarse grid of
+  KickTable, the best candidates of the previous search, and random
+  samples around the current beam. Each candidate is evaluated by
+  the rollout of the ball and the player dynamics, and the search
+  stops when the sample limit is reached. The random samples are
+  generated from a fixed seed, so the same world state always gives
+  the same plan.
+
+  The beam is kept after the search, and it is used as the seeds of
+  the next search while the same target is dribbled.
+ */
+class DribblePlanner {
+public:
+
+    //! the maximal number of dashes after the kick
+    static const int MAX_STEP = 12;
+    //! the number of candidates kept in the beam
+    static const int BEAM_WIDTH = 8;
+
+    /*!
+      \struct Plan
+      \brief dribble sequence
+     */
+    struct Plan {
+        Vector2D ball_rel_; //!< ball position after kick. relative to the player and rotated by accel angle.
+        Vector2D first_ball_vel_; //!< ball velocity just after the kick
+        int dash_count_; //!< the number of dashes after the kick
+        double forward_travel_; //!< ball travel distance for the accel direction
+        double min_opp_dist_; //!< estimated minimal distance between the ball and opponents
+
+        /*!
+          \brief create an invalid plan
+         */
+        Plan()
+            : ball_rel_( 0.0, 0.0 )
+            , first_ball_vel_( 0.0, 0.0 )
+            , dash_count_( 0 )
+            , forward_travel_( 0.0 )
+            , min_opp_dist_( 0.0 )
+          { }
+    };
+
+private:
+
+    //! the maximal number of evaluated candidates in one search
+    int M_max_samples;
+
+    //! last search time
+    GameTime M_last_time;
+    //! last target point
+    Vector2D M_last_target;
+    //! best candidates of the last search
+    std::vector< Plan > M_beam;
+
+    //! elapsed time of the last search [msec]
+    double M_elapsed_msec;
+    //! the number of candidates evaluated in the last search
+    int M_evaluated_count;
+    //! the number of candidates reused from the previous search
+    int M_reused_count;
+
+    /*!
+      \brief private for singleton
+     */
+    DribblePlanner();
+
+    // not used
+    DribblePlanner( const DribblePlanner & );
+    DribblePlanner & operator=( const DribblePlanner & );
+
+public:
+
+    /*!
+      \brief singleton interface
+      \return reference to the instance
+     */
+    static
+    DribblePlanner & instance();
+
+    /*!
+      \brief set the search limit
+      \param max_samples the maximal number of evaluated candidates
+     */
+    void setLimit( const int max_samples )
+      {
+          M_max_samples = max_samples;
+      }
+
+    /*!
+      \brief discard the beam of the previous search
+     */
+    void clear()
+      {
+          M_beam.clear();
+      }
+
+    /*!
+      \brief search the dribble sequence
+      \param agent const pointer to the agent
+      \param target_point dribble target point
+      \param dash_power dash power. if negative, backward dribble.
+      \param dash_count the requested number of dashes. the ball must
+      be kept well inside the kickable area after the last of them.
+      \param max_dash the maximal number of simulated dashes [1, MAX_STEP]
+      \param result reference to the result variable
+      \return true if at least one dash is possible after the kick
+
+      Longer dash sequence is preferred. Among the sequences with the
+      same length, the one farther from opponents is selected, and if
+      all opponents are far enough, the one with the longest forward
+      travel is selected.
+     */
+    bool plan( const PlayerAgent * agent,
+               const Vector2D & target_point,
+               const double & dash_power,
+               const int dash_count,
+               const int max_dash,
+               Plan & result );
+
+    /*!
+      \brief get the elapsed time of the last search
+      \return milli seconds
+     */
+    double elapsedMSec() const
+      {
+          return M_elapsed_msec;
+      }
+
+    /*!
+      \brief get the number of candidates evaluated in the last search
+      \return candidate count
+     */
+    int evaluatedCount() const
+      {
+          return M_evaluated_count;
+      }
+
+    /*!
+      \brief get the number of candidates reused in the last search
+      \return candidate count
+     */
+    int reusedCount() const
+      {
+          return M_reused_count;
+      }
+
+private:
+
+    /*!
+      \brief self state sequence
+     */
+    struct SelfStates {
+        int last_dash_; //!< the requested number of dashes
+        AngleDeg accel_angle_; //!< dash direction
+        std::vector< Vector2D > pos_; //!< [0]: after kick, [1..]: after each dash
+    };
+
+    /*!
+      \brief create the self state sequence
+      \param wm const reference to the world model
+      \param dash_power dash power
+      \param dash_count the number of dashes
+      \param states reference to the result variable
+     */
+    static
+    void create_self_states( const WorldModel & wm,
+                             const double & dash_power,
+                             const int dash_count,
+                             SelfStates & states );
+
+    /*!
+      \brief simulate the candidate
+      \param wm const reference to the world model
+      \param states self state sequence
+      \param plan reference to the candidate. ball_rel_ must be set.
+      \return true if the candidate is valid
+     */
+    static
+    bool simulate( const WorldModel & wm,
+                   const SelfStates & states,
+                   Plan & plan );
+
+    /*!
+      \brief check if the ball collides with the player
+      \param wm const reference to the world model
+      \param ball_pos ball position
+      \param my_pos player position at the same cycle
+      \param ball_rel_dist distance between the ball and the player
+      \return true if the ball is too near to the player
+     */
+    static
+    bool is_collided( const WorldModel & wm,
+                      const Vector2D & ball_pos,
+                      const Vector2D & my_pos,
+                      const double & ball_rel_dist );
+
+    /*!
+      \brief check if opponent can kick the ball at the step
+      \param wm const reference to the world model
+      \param ball_pos ball position
+      \param step the number of cycles from now
+      \param min_opp_dist reference to the minimal distance margin
+      \return true if opponent can kick the ball
+     */
+    static
+    bool exist_kickable_opponent( const WorldModel & wm,
+                                  const Vector2D & ball_pos,
+                                  const int step,
+                                  double & min_opp_dist );
+
+    /*!
+      \brief compare two candidates
+      \return true if lhs is better than rhs
+     */
+    static
+    bool is_better( const Plan & lhs,
+                    const Plan & rhs );
+
+    /*!
+      \brief insert the candidate into the beam
+      \param plan candidate
+      \param beam reference to the beam sorted by is_better
+     */
+    static
+    void insert_beam( const Plan & plan,
+                      std::vector< Plan > & beam );
+
+};
+
+}
+
+#endif
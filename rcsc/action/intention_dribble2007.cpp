@@ -37,6 +37,7 @@
 
 #include <rcsc/action/basic_actions.h>
 #include <rcsc/action/body_go_to_point.h>
+#include <rcsc/action/dribble_planner.h>
 #include <rcsc/action/neck_scan_field.h>
 #include <rcsc/action/neck_turn_to_goalie_or_scan.h>
 #include <rcsc/action/view_synch.h>
@@ -130,6 +131,8 @@ IntentionDribble2007::execute( PlayerAgent * agent )
         dlog.addText( Logger::DRIBBLE,
                       "%s:%d: execute(). but exist interfere opponent. cancel intention."
                       ,__FILE__, __LINE__ );
+        // the planned sequences are no longer reliable
+        DribblePlanner::instance().clear();
         return false;
     }
 
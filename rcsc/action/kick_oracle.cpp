@@ -0,0 +1,208 @@
+// -*-c++-*-
+
+/*!
+  \file kick_oracle.cpp
+  \brief per cycle one step kick feasibility oracle
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "kick_oracle.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/server_param.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+const int KickOracle::NUM_BINS;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+KickOracle::KickOracle()
+    : M_time( -1, 0 )
+    , M_kick_rate( 0.0 )
+    , M_ball_vel( 0.0, 0.0 )
+    , M_max_accel( 0.0 )
+{
+    std::fill( M_max_speed, M_max_speed + NUM_BINS, 0.0 );
+    std::fill( M_min_speed, M_min_speed + NUM_BINS, 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const
+KickOracle &
+KickOracle::get( const WorldModel & wm )
+{
+    static KickOracle S_instance;
+
+    if ( S_instance.M_time != wm.time()
+         || S_instance.M_kick_rate != wm.self().kickRate()
+         || S_instance.M_ball_vel != wm.ball().vel() )
+    {
+        S_instance.update( wm );
+    }
+
+    return S_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+KickOracle::update( const WorldModel & wm )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    M_time = wm.time();
+    M_kick_rate = wm.self().kickRate();
+    M_ball_vel = wm.ball().vel();
+    M_max_accel = std::min( SP.maxPower() * M_kick_rate,
+                            SP.ballAccelMax() );
+
+    const double speed_max = SP.ballSpeedMax();
+    const double c2 = M_ball_vel.r2();
+    const double r2 = M_max_accel * M_max_accel;
+
+    //
+    // intersection of the ray from the current ball position and
+    // the circle of the reachable next ball position.
+    // same as Body_KickOneStep::get_max_possible_vel().
+    //
+    for ( int i = 0; i < NUM_BINS; ++i )
+    {
+        const double dir = -180.0 + 360.0 * i / NUM_BINS;
+        const double cu = M_ball_vel.x * AngleDeg::cos_deg( dir )
+            + M_ball_vel.y * AngleDeg::sin_deg( dir );
+        const double disc = cu * cu - c2 + r2;
+
+        M_max_speed[i] = 0.0;
+        M_min_speed[i] = speed_max + 1.0;
+
+        if ( disc < 0.0 )
+        {
+            continue;
+        }
+
+        const double t1 = cu + std::sqrt( disc );
+        const double t2 = cu - std::sqrt( disc );
+
+        if ( t1 < 0.0 )
+        {
+            continue;
+        }
+
+        if ( t1 <= speed_max )
+        {
+            M_max_speed[i] = t1;
+        }
+        else if ( t2 <= speed_max )
+        {
+            M_max_speed[i] = speed_max;
+        }
+        else
+        {
+            continue;
+        }
+
+        M_min_speed[i] = std::max( 0.0, t2 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+KickOracle::bin( const AngleDeg & angle,
+                 double & rate )
+{
+    const double d = ( angle.degree() + 180.0 ) * NUM_BINS / 360.0;
+    const double f = std::floor( d );
+
+    rate = d - f;
+    return static_cast< int >( f ) % NUM_BINS;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+KickOracle::maxSpeed( const AngleDeg & angle ) const
+{
+    double rate = 0.0;
+    const int i = bin( angle, rate );
+    const int j = ( i + 1 ) % NUM_BINS;
+
+    // unreachable bins have min_speed > max_speed.
+    // never interpolate across the reachable envelope border.
+    if ( M_min_speed[i] > M_max_speed[i]
+         || M_min_speed[j] > M_max_speed[j] )
+    {
+        return 0.0;
+    }
+
+    return M_max_speed[i] * ( 1.0 - rate ) + M_max_speed[j] * rate;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+KickOracle::canKick( const double & first_speed,
+                     const AngleDeg & angle ) const
+{
+    const double max_speed = maxSpeed( angle );
+    if ( max_speed <= 0.0 )
+    {
+        return false;
+    }
+
+    double rate = 0.0;
+    const int i = bin( angle, rate );
+    const int j = ( i + 1 ) % NUM_BINS;
+
+    const double min_speed = std::max( M_min_speed[i], M_min_speed[j] );
+
+    return ( min_speed <= first_speed
+             && first_speed <= max_speed );
+}
+
+}
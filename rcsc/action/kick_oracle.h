@@ -0,0 +1,165 @@
+// -*-c++-*-
+
+/*!
+  \file kick_oracle.h
+  \brief per cycle one step kick feasibility oracle
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ACTION_KICK_ORACLE_H
+#define RCSC_ACTION_KICK_ORACLE_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/angle_deg.h>
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+
+class WorldModel;
+
+/*!
+  \class KickOracle
+  \brief one step kick envelope shared by all kick behaviors.
+
+  The envelope is the range of the ball speed that can be achieved by
+  one kick for each direction, computed from the current kick rate and
+  ball velocity. It is computed at most once per cycle and every kick
+  behavior reads the same profile.
+
+  Bin i corresponds to the global direction (-180 + i) degree.
+ */
+class KickOracle {
+public:
+
+    //! the number of direction bins
+    static const int NUM_BINS = 360;
+
+private:
+
+    //! last updated time
+    GameTime M_time;
+    //! kick rate used for the last update
+    double M_kick_rate;
+    //! ball velocity used for the last update
+    Vector2D M_ball_vel;
+
+    //! max ball acceleration by one kick
+    double M_max_accel;
+
+    //! max ball first speed for each direction
+    double M_max_speed[NUM_BINS];
+    //! min ball first speed for each direction
+    double M_min_speed[NUM_BINS];
+
+    /*!
+      \brief private for singleton
+     */
+    KickOracle();
+
+    // not used
+    KickOracle( const KickOracle & );
+    KickOracle & operator=( const KickOracle & );
+
+public:
+
+    /*!
+      \brief get the oracle updated for the world model
+      \param wm const reference to the world model
+      \return const reference to the instance
+     */
+    static
+    const KickOracle & get( const WorldModel & wm );
+
+    /*!
+      \brief get the max ball acceleration by one kick
+      \return acceleration length
+     */
+    double maxAccel() const
+      {
+          return M_max_accel;
+      }
+
+    /*!
+      \brief get the max speed profile
+      \return pointer to the array of NUM_BINS elements
+     */
+    const
+    double * maxSpeedProfile() const
+      {
+          return M_max_speed;
+      }
+
+    /*!
+      \brief get the max ball first speed to the direction
+      \param angle global direction
+      \return speed interpolated between the neighbor bins,
+      0 if either neighbor bin is unreachable
+     */
+    double maxSpeed( const AngleDeg & angle ) const;
+
+    /*!
+      \brief get the max ball first velocity to the direction
+      \param angle global direction
+      \return velocity vector
+     */
+    Vector2D maxVel( const AngleDeg & angle ) const
+      {
+          return Vector2D::polar2vector( maxSpeed( angle ), angle );
+      }
+
+    /*!
+      \brief check if the ball can be kicked to the direction by one kick
+      \param first_speed desired ball first speed
+      \param angle global direction
+      \return true if first_speed is within the envelope
+     */
+    bool canKick( const double & first_speed,
+                  const AngleDeg & angle ) const;
+
+private:
+
+    /*!
+      \brief recompute the envelope
+      \param wm const reference to the world model
+     */
+    void update( const WorldModel & wm );
+
+    /*!
+      \brief get the bin index and the interpolation rate
+      \param angle global direction
+      \param rate reference to the rate of the next bin
+      \return lower bin index
+     */
+    static
+    int bin( const AngleDeg & angle,
+             double & rate );
+
+};
+
+}
+
+#endif
@@ -0,0 +1,475 @@
+// -*-c++-*-
+
+/*!
+  \file kick_table.cpp
+  \brief precomputed kick state table for multi step kick planning
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "kick_table.h"
+
+#include "body_kick_one_step.h"
+#include "body_kick_two_step.h"
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/soccer_math.h>
+#include <rcsc/math_util.h>
+
+namespace rcsc {
+
+const int KickTable::NUM_DIST;
+const int KickTable::NUM_ANGLE;
+const int KickTable::NUM_STATE;
+const int KickTable::MAX_STEP;
+
+namespace {
+
+/*!
+  \brief the last kick from one ball state at the desired speed
+*/
+struct FinalKick {
+    AngleDeg angle_; //!< direction to the target from the ball
+    Vector2D vel_; //!< ball velocity required just after the kick
+    bool safe_; //!< true if the kicked ball collides with nobody
+    double opp_dist2_; //!< squared distance to the nearest opponent after the kick
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the ball position just after the last kick
+  \return true if neither the kicker nor opponents touch the ball
+*/
+bool
+is_safe_final_kick( const PlayerAgent * agent,
+                    const Vector2D & ball_pos,
+                    const Vector2D & kicked_vel,
+                    const Vector2D & my_next,
+                    double * opp_dist2 )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const Vector2D next_ball_pos = ball_pos + kicked_vel;
+    if ( next_ball_pos.dist2( my_next )
+         < square( agent->world().self().playerType().playerSize()
+                   + SP.ballSize()
+                   + 0.1 ) )
+    {
+        return false;
+    }
+
+    *opp_dist2 = Body_KickTwoStep::DEFAULT_MIN_DIST2;
+    return ! Body_KickTwoStep::is_opp_kickable( agent, next_ball_pos, opp_dist2 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the last kick at the desired speed from the ball state.
+  The result does not depend on the incoming ball velocity, so the
+  collision and opponent checks are done once per state.
+*/
+void
+create_final_kick( const PlayerAgent * agent,
+                   const Vector2D & ball_pos,
+                   const Vector2D & my_next,
+                   const Vector2D & target_rpos,
+                   const double & first_speed,
+                   FinalKick & final_kick )
+{
+    final_kick.angle_ = ( target_rpos - ball_pos ).th();
+    final_kick.vel_ = Vector2D::polar2vector( first_speed, final_kick.angle_ );
+    final_kick.safe_ = is_safe_final_kick( agent,
+                                           ball_pos, final_kick.vel_, my_next,
+                                           &final_kick.opp_dist2_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the last kick to the target
+  \return true if the kick is possible
+
+  Only the enforced kick, whose velocity depends on the incoming ball
+  velocity, is checked for opponents here.
+*/
+bool
+simulate_final_kick( const PlayerAgent * agent,
+                     const Vector2D & ball_pos,
+                     const Vector2D & ball_vel,
+                     const double & krate,
+                     const double & max_accel,
+                     const Vector2D & my_next,
+                     const FinalKick & final_kick,
+                     const bool enforce,
+                     KickTable::Sequence & seq )
+{
+    Vector2D required_vel = final_kick.vel_;
+    bool safe = final_kick.safe_;
+    double opp_dist2 = final_kick.opp_dist2_;
+
+    if ( ( required_vel - ball_vel ).r2() > max_accel * max_accel )
+    {
+        if ( ! enforce )
+        {
+            return false;
+        }
+
+        required_vel = Body_KickOneStep::get_max_possible_vel( final_kick.angle_,
+                                                               krate,
+                                                               ball_vel );
+        safe = is_safe_final_kick( agent,
+                                   ball_pos, required_vel, my_next,
+                                   &opp_dist2 );
+    }
+
+    if ( ! safe )
+    {
+        return false;
+    }
+
+    seq.achieved_vel_ = required_vel;
+    seq.final_power_ = ( required_vel - ball_vel ).r() / krate;
+    seq.opp_dist2_ = std::min( seq.opp_dist2_, opp_dist2 );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compare two sequences that have the same step
+  \return true if lhs is better than rhs
+*/
+bool
+is_better( const KickTable::Sequence & lhs,
+           const KickTable::Sequence & rhs,
+           const bool enforce )
+{
+    if ( rhs.step_ == 0 )
+    {
+        return true;
+    }
+
+    if ( enforce )
+    {
+        const double diff = lhs.achieved_vel_.r2() - rhs.achieved_vel_.r2();
+        if ( diff > 1.0e-4 ) return true;
+        if ( diff < -1.0e-4 ) return false;
+    }
+
+    if ( lhs.opp_dist2_ != rhs.opp_dist2_ )
+    {
+        return lhs.opp_dist2_ > rhs.opp_dist2_;
+    }
+
+    return lhs.final_power_ < rhs.final_power_;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+KickTable::KickTable()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+KickTable &
+KickTable::instance()
+{
+    static KickTable S_instance;
+    return S_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const
+KickTable::Table &
+KickTable::table( const PlayerType & ptype )
+{
+    Table & t = M_tables[ptype.id()];
+
+    if ( t.states_.empty()
+         || t.player_size_ != ptype.playerSize()
+         || t.kickable_margin_ != ptype.kickableMargin() )
+    {
+        create_table( ptype, t );
+    }
+
+    return t;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+KickTable::create_table( const PlayerType & ptype,
+                         Table & table )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    table.player_size_ = ptype.playerSize();
+    table.kickable_margin_ = ptype.kickableMargin();
+    table.states_.resize( NUM_STATE );
+
+    // keep the margin for the collision and the noise
+    const double near_dist = ptype.playerSize() + SP.ballSize() + 0.15;
+    const double far_dist = ptype.kickableArea() - 0.15;
+    const double dist_step = ( far_dist - near_dist ) / ( NUM_DIST - 1 );
+    const double angle_step = 360.0 / NUM_ANGLE;
+
+    for ( int d = 0; d < NUM_DIST; ++d )
+    {
+        const double dist = near_dist + dist_step * d;
+        for ( int a = 0; a < NUM_ANGLE; ++a )
+        {
+            const double angle = -180.0 + angle_step * a;
+
+            State & s = table.states_[d * NUM_ANGLE + a];
+            s.pos_ = Vector2D::polar2vector( dist, angle );
+            s.kick_rate_ = kick_rate( dist,
+                                      angle,
+                                      SP.kickPowerRate(),
+                                      SP.ballSize(),
+                                      ptype.playerSize(),
+                                      ptype.kickableMargin() );
+            s.max_accel_ = std::min( SP.maxPower() * s.kick_rate_,
+                                     SP.ballAccelMax() );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+KickTable::plan( const PlayerAgent * agent,
+                 const Vector2D & target_point,
+                 const double & first_speed,
+                 const int max_step,
+                 const bool enforce,
+                 Sequence & result )
+{
+    const ServerParam & SP = ServerParam::i();
+    const WorldModel & wm = agent->world();
+    const Table & t = table( wm.self().playerType() );
+
+    result = Sequence();
+
+    const int n_step = std::min( std::max( max_step, 1 ), MAX_STEP );
+    const double speed = std::min( first_speed, SP.ballSpeedMax() );
+    const double speed_max2 = square( SP.ballSpeedMax() );
+    const Vector2D target_rpos = target_point - wm.self().pos();
+
+    //
+    // player positions relative to the current position
+    //
+    Vector2D my_pos[MAX_STEP + 1];
+    {
+        Vector2D my_vel = wm.self().vel();
+        my_pos[0].assign( 0.0, 0.0 );
+        for ( int k = 1; k <= MAX_STEP; ++k )
+        {
+            my_pos[k] = my_pos[k - 1] + my_vel;
+            my_vel *= wm.self().playerType().playerDecay();
+        }
+    }
+
+    const Vector2D ball_pos = wm.ball().rpos();
+    const Vector2D ball_vel = wm.ball().vel();
+    const double krate = wm.self().kickRate();
+    const double max_accel = std::min( SP.maxPower() * krate,
+                                       SP.ballAccelMax() );
+
+    //
+    // one step
+    //
+    {
+        FinalKick final_kick;
+        create_final_kick( agent, ball_pos, my_pos[1], target_rpos, speed,
+                           final_kick );
+
+        Sequence seq;
+        seq.opp_dist2_ = Body_KickTwoStep::DEFAULT_MIN_DIST2;
+        if ( simulate_final_kick( agent,
+                                  ball_pos, ball_vel, krate, max_accel,
+                                  my_pos[1], final_kick,
+                                  enforce && n_step == 1,
+                                  seq ) )
+        {
+            seq.step_ = 1;
+            seq.first_vel_ = seq.achieved_vel_;
+            result = seq;
+            return true;
+        }
+    }
+
+    if ( n_step < 2 )
+    {
+        return false;
+    }
+
+    //
+    // state positions, opponent distance and the last kick from
+    // each state at step 1 and 2
+    //
+    Vector2D state_pos[2][NUM_STATE];
+    double state_opp_dist2[2][NUM_STATE];
+    bool state_valid[2][NUM_STATE];
+    FinalKick state_final_kick[2][NUM_STATE];
+
+    for ( int k = 0; k < n_step - 1; ++k )
+    {
+        for ( int i = 0; i < NUM_STATE; ++i )
+        {
+            state_pos[k][i] = my_pos[k + 1]
+                + t.states_[i].pos_.rotatedVector( wm.self().body() );
+            state_opp_dist2[k][i] = Body_KickTwoStep::DEFAULT_MIN_DIST2;
+            state_valid[k][i]
+                = ! Body_KickTwoStep::is_opp_kickable( agent,
+                                                       state_pos[k][i],
+                                                       &state_opp_dist2[k][i] );
+            if ( state_valid[k][i] )
+            {
+                create_final_kick( agent,
+                                   state_pos[k][i], my_pos[k + 2],
+                                   target_rpos, speed,
+                                   state_final_kick[k][i] );
+            }
+        }
+    }
+
+    //
+    // two step
+    //
+    {
+        const bool final_enforce = ( enforce && n_step == 2 );
+
+        for ( int i = 0; i < NUM_STATE; ++i )
+        {
+            if ( ! state_valid[0][i] ) continue;
+
+            const Vector2D vel1 = state_pos[0][i] - ball_pos;
+            if ( vel1.r2() > speed_max2
+                 || ( vel1 - ball_vel ).r2() > max_accel * max_accel )
+            {
+                continue;
+            }
+
+            Sequence seq;
+            seq.opp_dist2_ = state_opp_dist2[0][i];
+            if ( simulate_final_kick( agent,
+                                      state_pos[0][i], vel1 * SP.ballDecay(),
+                                      t.states_[i].kick_rate_,
+                                      t.states_[i].max_accel_,
+                                      my_pos[2], state_final_kick[0][i],
+                                      final_enforce,
+                                      seq ) )
+            {
+                seq.step_ = 2;
+                seq.first_vel_ = vel1;
+                if ( is_better( seq, result, final_enforce ) )
+                {
+                    result = seq;
+                }
+            }
+        }
+
+        if ( result.step_ > 0 )
+        {
+            return true;
+        }
+    }
+
+    if ( n_step < 3 )
+    {
+        return false;
+    }
+
+    //
+    // three step
+    //
+    for ( int i = 0; i < NUM_STATE; ++i )
+    {
+        if ( ! state_valid[0][i] ) continue;
+
+        const Vector2D vel1 = state_pos[0][i] - ball_pos;
+        if ( vel1.r2() > speed_max2
+             || ( vel1 - ball_vel ).r2() > max_accel * max_accel )
+        {
+            continue;
+        }
+
+        const Vector2D ball_vel1 = vel1 * SP.ballDecay();
+        const double max_accel1 = t.states_[i].max_accel_;
+
+        for ( int j = 0; j < NUM_STATE; ++j )
+        {
+            if ( ! state_valid[1][j] ) continue;
+
+            const Vector2D vel2 = state_pos[1][j] - state_pos[0][i];
+            if ( vel2.r2() > speed_max2
+                 || ( vel2 - ball_vel1 ).r2() > max_accel1 * max_accel1 )
+            {
+                continue;
+            }
+
+            Sequence seq;
+            seq.opp_dist2_ = std::min( state_opp_dist2[0][i],
+                                       state_opp_dist2[1][j] );
+            if ( simulate_final_kick( agent,
+                                      state_pos[1][j], vel2 * SP.ballDecay(),
+                                      t.states_[j].kick_rate_,
+                                      t.states_[j].max_accel_,
+                                      my_pos[3], state_final_kick[1][j],
+                                      enforce,
+                                      seq ) )
+            {
+                seq.step_ = 3;
+                seq.first_vel_ = vel1;
+                if ( is_better( seq, result, enforce ) )
+                {
+                    result = seq;
+                }
+            }
+        }
+    }
+
+    return ( result.step_ > 0 );
+}
+
+}
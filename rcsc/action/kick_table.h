@@ -0,0 +1,187 @@
+// -*-c++-*-
+
+/*!
+  \file kick_table.h
+  \brief precomputed kick state table for multi step kick planning
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+#ifndef RCSC_ACTION_KICK_TABLE_H
+#define RCSC_ACTION_KICK_TABLE_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/angle_deg.h>
+
+#include <map>
+#include <vector>
+
+namespace rcsc {
+
+class PlayerType;
+class PlayerAgent;
+
+/*!
+  \class KickTable
+  \brief kick planner that searches the precomputed ball states.
+
+  Ball states are the grid points in the kickable area of the player,
+  defined by NUM_DIST distance layers and NUM_ANGLE directions relative
+  to the body angle. The position and the kick rate of each state only
+  depend on the player type, so they are computed once per player type.
+
+  plan() searches 1, 2 and 3 step kick sequences through the states.
+  Because the body angle does not change while kicking, every kick
+  from an intermediate state is checked by one vector comparison with
+  the precomputed max acceleration. The opponent checks of the
+  intermediate states and of the last kick at the desired speed are
+  done once per state and step. Only the enforced last kick, whose
+  velocity depends on the incoming ball velocity, is checked for each
+  sequence.
+ */
+class KickTable {
+public:
+
+    //! the number of distance layers
+    static const int NUM_DIST = 3;
+    //! the number of directions
+    static const int NUM_ANGLE = 24;
+    //! the number of states
+    static const int NUM_STATE = NUM_DIST * NUM_ANGLE;
+    //! the maximal number of kicks
+    static const int MAX_STEP = 3;
+
+    /*!
+      \struct State
+      \brief ball state relative to the player
+     */
+    struct State {
+        Vector2D pos_; //!< ball position relative to the player. body angle is 0.
+        double kick_rate_; //!< kick rate at this position
+        double max_accel_; //!< max ball acceleration by one kick
+    };
+
+    /*!
+      \struct Table
+      \brief state set for one player type
+     */
+    struct Table {
+        double player_size_; //!< player size used to create this table
+        double kickable_margin_; //!< kickable margin used to create this table
+        std::vector< State > states_; //!< state set
+    };
+
+    /*!
+      \struct Sequence
+      \brief result of the kick planning
+     */
+    struct Sequence {
+        int step_; //!< the number of kicks. 0 if not found.
+        Vector2D first_vel_; //!< ball velocity just after the first kick
+        Vector2D achieved_vel_; //!< ball velocity just after the last kick
+        double final_power_; //!< kick power of the last kick
+        double opp_dist2_; //!< squared distance to the nearest opponent on the path
+
+        /*!
+          \brief create an invalid sequence
+         */
+        Sequence()
+            : step_( 0 )
+            , first_vel_( 0.0, 0.0 )
+            , achieved_vel_( 0.0, 0.0 )
+            , final_power_( 0.0 )
+            , opp_dist2_( 0.0 )
+          { }
+    };
+
+private:
+
+    //! key: player type id, value: state table
+    std::map< int, Table > M_tables;
+
+    /*!
+      \brief private for singleton
+     */
+    KickTable();
+
+    // not used
+    KickTable( const KickTable & );
+    KickTable & operator=( const KickTable & );
+
+public:
+
+    /*!
+      \brief singleton interface
+      \return reference to the instance
+     */
+    static
+    KickTable & instance();
+
+    /*!
+      \brief get the state table for the player type. created if not exist.
+      \param ptype player type
+      \return const reference to the table
+     */
+    const
+    Table & table( const PlayerType & ptype );
+
+    /*!
+      \brief search the kick sequence that sends the ball to the target
+      \param agent const pointer to the agent
+      \param target_point global target point
+      \param first_speed desired ball first speed
+      \param max_step the maximal number of kicks [1, MAX_STEP]
+      \param enforce if true, the sequence with the max speed is
+      returned even if the desired speed cannot be achieved.
+      \param result reference to the result variable
+      \return true if found
+
+      Fewer kicks are always preferred. Among the sequences with the
+      same step, the one farthest from opponents, then the one with
+      the smallest final kick power, is selected. In enforce mode, the
+      achieved speed is compared first.
+     */
+    bool plan( const PlayerAgent * agent,
+               const Vector2D & target_point,
+               const double & first_speed,
+               const int max_step,
+               const bool enforce,
+               Sequence & result );
+
+private:
+
+    /*!
+      \brief create the state table
+      \param ptype player type
+      \param table reference to the result table
+     */
+    static
+    void create_table( const PlayerType & ptype,
+                       Table & table );
+
+};
+
+}
+
+#endif
@@ -0,0 +1,354 @@
+// -*-c++-*-
+
+/*!
+  \file kick_table_test.cpp
+  \brief test code for rcsc::KickTable
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/random.hpp>
+
+#include "kick_table.h"
+#include "body_kick_two_step.h"
+#include "body_kick_multi_step.h"
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/fullstate_sensor.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/soccer_math.h>
+
+#include <cstdio>
+
+using namespace boost::unit_test_framework;
+
+namespace {
+
+//! the number of sampled ball states
+const int N_SAMPLES = 1000;
+
+const double EPS = 1.0e-6;
+
+/*!
+  \class TestAgent
+  \brief player agent whose world model is set by fullstate messages
+ */
+class TestAgent
+    : public rcsc::PlayerAgent {
+private:
+    long M_cycle;
+
+public:
+
+    TestAgent()
+        : M_cycle( 0 )
+      {
+          M_worldmodel.initTeamInfo( "test", rcsc::LEFT, 10, false );
+      }
+
+    /*!
+      \brief set the world state. the kicker is placed at (0, 0).
+      \param body kicker's body angle
+      \param my_vel kicker's velocity
+      \param ball_rpos ball position relative to the kicker
+      \param ball_vel ball velocity
+      \param opp_rpos opponent position relative to the kicker.
+      if invalidated, no opponent is placed.
+     */
+    void setState( const double & body,
+                   const rcsc::Vector2D & my_vel,
+                   const rcsc::Vector2D & ball_rpos,
+                   const rcsc::Vector2D & ball_vel,
+                   const rcsc::Vector2D & opp_rpos )
+      {
+          ++M_cycle;
+
+          char msg[1024];
+          int n = std::snprintf( msg, 1024,
+                                 "(fullstate %ld (pmode play_on) (vmode high normal)"
+                                 " (count 0 0 0 0 0 0 0 0)"
+                                 " (arm (movable 0) (expires 0) (target 0 0) (count 0))"
+                                 " (score 0 0)"
+                                 " ((b) %.6f %.6f %.6f %.6f)"
+                                 " ((p l 10 0) 0 0 %.6f %.6f %.6f 0 (8000 1 1))",
+                                 M_cycle,
+                                 ball_rpos.x, ball_rpos.y, ball_vel.x, ball_vel.y,
+                                 my_vel.x, my_vel.y, body );
+          if ( opp_rpos.valid() )
+          {
+              n += std::snprintf( msg + n, 1024 - n,
+                                  " ((p r 5 0) %.6f %.6f 0 0 180 0 (8000 1 1))",
+                                  opp_rpos.x, opp_rpos.y );
+          }
+          std::snprintf( msg + n, 1024 - n, ")" );
+
+          const rcsc::GameTime current( M_cycle, 0 );
+
+          rcsc::FullstateSensor fullstate;
+          fullstate.parse( msg, 8.0, current );
+
+          M_worldmodel.updateAfterFullstate( fullstate, M_effector, current );
+          M_worldmodel.updateJustBeforeDecision( M_effector, current );
+      }
+
+protected:
+
+    void actionImpl()
+      { }
+};
+
+typedef boost::variate_generator< boost::mt19937 &,
+                                  boost::uniform_real<> > RealGen;
+
+boost::mt19937 &
+random_engine()
+{
+    static boost::mt19937 s_engine( 5489 );
+    return s_engine;
+}
+
+double
+random_real( const double & min_v,
+             const double & max_v )
+{
+    RealGen gen( random_engine(),
+                 boost::uniform_real<>( min_v, max_v ) );
+    return gen();
+}
+
+/*!
+  \brief get the step of the original recursive simulation
+  \return the number of kicks. 0 if not found.
+ */
+int
+simulate_old( const rcsc::PlayerAgent * agent,
+              const rcsc::Vector2D & target_point,
+              const double & first_speed )
+{
+    const rcsc::WorldModel & wm = agent->world();
+    const rcsc::Vector2D target_rpos = target_point - wm.self().pos();
+
+    rcsc::Vector2D achieved_vel;
+    rcsc::Vector2D next_vel;
+
+    if ( rcsc::Body_KickTwoStep::simulate_one_kick( &achieved_vel, NULL, NULL,
+                                                    target_rpos, first_speed,
+                                                    rcsc::Vector2D( 0.0, 0.0 ),
+                                                    wm.self().vel(), wm.self().body(),
+                                                    wm.ball().rpos(), wm.ball().vel(),
+                                                    agent, false ) )
+    {
+        return 1;
+    }
+
+    if ( rcsc::Body_KickTwoStep::simulate_two_kick( &achieved_vel, &next_vel,
+                                                    target_rpos, first_speed,
+                                                    rcsc::Vector2D( 0.0, 0.0 ),
+                                                    wm.self().vel(), wm.self().body(),
+                                                    wm.ball().rpos(), wm.ball().vel(),
+                                                    agent, false ) )
+    {
+        return 2;
+    }
+
+    if ( rcsc::Body_KickMultiStep::simulate_three_kick( &achieved_vel, &next_vel,
+                                                        target_rpos, first_speed,
+                                                        rcsc::Vector2D( 0.0, 0.0 ),
+                                                        wm.self().vel(), wm.self().body(),
+                                                        wm.ball().rpos(), wm.ball().vel(),
+                                                        agent, false ) )
+    {
+        return 3;
+    }
+
+    return 0;
+}
+
+/*!
+  \brief check that the planned sequence is physically possible
+ */
+void
+check_sequence( const rcsc::PlayerAgent * agent,
+                const rcsc::Vector2D & target_point,
+                const double & first_speed,
+                const rcsc::KickTable::Sequence & seq )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const rcsc::WorldModel & wm = agent->world();
+
+    // the first kick is possible from the current state
+    const double max_accel = std::min( SP.maxPower() * wm.self().kickRate(),
+                                       SP.ballAccelMax() );
+    BOOST_CHECK( ( seq.first_vel_ - wm.ball().vel() ).r() < max_accel + EPS );
+    BOOST_CHECK( seq.first_vel_.r() < SP.ballSpeedMax() + EPS );
+
+    // the desired speed is achieved by the last kick
+    BOOST_CHECK_SMALL( seq.achieved_vel_.r() - first_speed, 1.0e-3 );
+    BOOST_CHECK( seq.final_power_ < SP.maxPower() + EPS );
+
+    if ( seq.step_ == 1 )
+    {
+        // the ball goes to the target
+        const rcsc::Vector2D target_rpos = target_point - wm.self().pos();
+        const rcsc::AngleDeg target_angle = ( target_rpos - wm.ball().rpos() ).th();
+        BOOST_CHECK_SMALL( ( seq.first_vel_.th() - target_angle ).abs(), 1.0e-3 );
+    }
+    else
+    {
+        // the ball is kept in the kickable area after the first kick
+        const rcsc::Vector2D next_ball_rpos = wm.ball().rpos() + seq.first_vel_;
+        const rcsc::Vector2D my_next = wm.self().vel();
+        BOOST_CHECK( next_ball_rpos.dist( my_next )
+                     < wm.self().playerType().kickableArea() );
+
+        // opponents cannot kick the ball after the first kick
+        double opp_dist2 = 0.0;
+        BOOST_CHECK( ! rcsc::Body_KickTwoStep::is_opp_kickable( agent,
+                                                                next_ball_rpos,
+                                                                &opp_dist2 ) );
+    }
+}
+
+/*!
+  \brief compare the kick table and the original simulation on sampled states
+ */
+void
+compare_sampled_states( const bool with_opponent )
+{
+    TestAgent agent;
+
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    int n_old = 0;
+    int n_new = 0;
+    int n_both = 0;
+    int n_one_step_diff = 0;
+    int n_fewer_step = 0;
+
+    for ( int i = 0; i < N_SAMPLES; ++i )
+    {
+        const double body = random_real( -180.0, 180.0 );
+        const rcsc::Vector2D my_vel
+            = rcsc::Vector2D::polar2vector( random_real( 0.0, 0.3 ),
+                                            random_real( -180.0, 180.0 ) );
+
+        // kickable ball at the current cycle
+        const double near_dist = 0.3 + SP.ballSize() + 0.05;
+        const double far_dist = SP.defaultKickableArea() - 0.1;
+        const rcsc::Vector2D ball_rpos
+            = rcsc::Vector2D::polar2vector( random_real( near_dist, far_dist ),
+                                            random_real( -180.0, 180.0 ) );
+        const rcsc::Vector2D ball_vel
+            = rcsc::Vector2D::polar2vector( random_real( 0.0, 0.5 ),
+                                            random_real( -180.0, 180.0 ) );
+
+        const rcsc::Vector2D opp_rpos
+            = ( with_opponent
+                ? rcsc::Vector2D::polar2vector( random_real( 1.5, 3.0 ),
+                                                random_real( -180.0, 180.0 ) )
+                : rcsc::Vector2D::INVALIDATED );
+
+        agent.setState( body, my_vel, ball_rpos, ball_vel, opp_rpos );
+
+        BOOST_REQUIRE( agent.world().self().isKickable() );
+
+        const rcsc::Vector2D target_point
+            = rcsc::Vector2D::polar2vector( 20.0, random_real( -180.0, 180.0 ) );
+        const double first_speed = random_real( 1.5, SP.ballSpeedMax() );
+
+        const int old_step = simulate_old( &agent, target_point, first_speed );
+
+        rcsc::KickTable::Sequence seq;
+        const bool found = rcsc::KickTable::instance().plan( &agent,
+                                                             target_point,
+                                                             first_speed,
+                                                             3,
+                                                             false,
+                                                             seq );
+        BOOST_CHECK_EQUAL( found, ( seq.step_ > 0 ) );
+
+        if ( old_step > 0 ) ++n_old;
+        if ( found ) ++n_new;
+        if ( old_step > 0 && found ) ++n_both;
+
+        // the one step kick is checked in the same way
+        if ( ( old_step == 1 ) != ( seq.step_ == 1 ) ) ++n_one_step_diff;
+
+        if ( found && old_step > 0 && seq.step_ < old_step ) ++n_fewer_step;
+
+        if ( found )
+        {
+            check_sequence( &agent, target_point, first_speed, seq );
+        }
+    }
+
+    BOOST_TEST_MESSAGE( ( with_opponent ? "with opponent:" : "no opponent:" )
+                        << " samples=" << N_SAMPLES
+                        << " old=" << n_old
+                        << " table=" << n_new
+                        << " both=" << n_both
+                        << " fewer_steps=" << n_fewer_step );
+
+    BOOST_CHECK_EQUAL( n_one_step_diff, 0 );
+
+    // the table finds almost all sequences found by the original simulation
+    BOOST_CHECK( n_both >= n_old * 0.95 );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkKickTableNoOpponent()
+{
+    compare_sampled_states( false );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkKickTableWithOpponent()
+{
+    compare_sampled_states( true );
+}
+
+
+test_suite *
+init_unit_test_suite( int argc, char * argv[] )
+{
+    test_suite * test = BOOST_TEST_SUITE( "rcsc::KickTable test" );
+
+    test -> add( BOOST_TEST_CASE( &checkKickTableNoOpponent ) );
+    test -> add( BOOST_TEST_CASE( &checkKickTableWithOpponent ) );
+
+    return test;
+}
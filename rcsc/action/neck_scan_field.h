@@ -3,6 +3,9 @@
 /*!
   \file neck_scan_field.h
   \brief scan field with neck evenly
+
+  The face direction is planned by PerceptionScheduler for the queued
+  view width.
 */
 
 /*
@@ -43,6 +46,9 @@ namespace rcsc {
 /*!
   \class Neck_ScanField
   \brief scan field with neck evenly
+
+  The face direction is planned by PerceptionScheduler for the queued
+  view width.
 */
 class Neck_ScanField
     : public NeckAction {
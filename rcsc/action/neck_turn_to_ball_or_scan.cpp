@@ -38,6 +38,7 @@
 #include "basic_actions.h"
 #include "bhv_scan_field.h"
 #include "neck_scan_field.h"
+#include "perception_scheduler.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/logger.h>
@@ -87,7 +88,7 @@ Neck_TurnToBallOrScan::execute( PlayerAgent * agent )
         dlog.addText( Logger::ACTION,
                       "%s:%d: simply face ball"
                       ,__FILE__, __LINE__ );
-        return Neck_TurnToBall().execute( agent );
+        return doFaceBall( agent, ball_next );
     }
 
     // ball is seen at current
@@ -110,7 +111,7 @@ Neck_TurnToBallOrScan::execute( PlayerAgent * agent )
         dlog.addText( Logger::ACTION,
                       "%s:%d: ball close. check ball."
                       ,__FILE__, __LINE__ );
-        return Neck_TurnToPoint( ball_next ).execute( agent );
+        return doFaceBall( agent, ball_next );
     }
 
     // consider ball reachable dist after 2step
@@ -137,7 +138,29 @@ Neck_TurnToBallOrScan::execute( PlayerAgent * agent )
                   ,__FILE__, __LINE__,
                   reachable_angle, ball_next.x, ball_next.y );
 
-    return Neck_TurnToPoint( ball_next ).execute( agent );
+    return doFaceBall( agent, ball_next );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Neck_TurnToBallOrScan::doFaceBall( PlayerAgent * agent,
+                                   const Vector2D & ball_next )
+{
+    PerceptionScheduler::Candidate best;
+    if ( ! PerceptionScheduler::instance().planWithPoint( agent,
+                                                          agent->effector().queuedNextViewWidth(),
+                                                          ball_next,
+                                                          best ) )
+    {
+        return Neck_TurnToPoint( ball_next ).execute( agent );
+    }
+
+    return agent->doTurnNeck( best.face_
+                              - agent->effector().queuedNextMyBody()
+                              - agent->world().self().neck() );
 }
 
 }
@@ -33,6 +33,7 @@
 #define RCSC_ACTION_NECK_TURN_TO_BALL_OR_SCAN_H
 
 #include <rcsc/player/soccer_action.h>
+#include <rcsc/geom/vector_2d.h>
 
 namespace rcsc {
 
@@ -68,6 +69,18 @@ public:
       {
           return new Neck_TurnToBallOrScan;
       }
+
+private:
+    /*!
+      \brief face to the direction that keeps the ball in the view and
+      scans the most informative area
+      \param agent pointer to the agent itself
+      \param ball_next estimated ball position at the next cycle
+      \return true if action is performed
+     */
+    static
+    bool doFaceBall( PlayerAgent * agent,
+                     const Vector2D & ball_next );
 };
 
 }
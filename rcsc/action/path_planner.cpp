@@ -0,0 +1,685 @@
+// -*-c++-*-
+
+/*!
+  \file path_planner.cpp
+  \brief incremental local path planner on the occupancy grid
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "path_planner.h"
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/timer.h>
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+namespace rcsc {
+
+const int PathPlanner::GRID_SIZE;
+const int PathPlanner::NUM_CELLS;
+const double PathPlanner::CELL_SIZE = 0.8;
+
+namespace {
+
+//! infinite cost
+const double INF_COST = 1.0e10;
+//! the cell cost that means the cell is blocked
+const double BLOCKED = 1000.0;
+
+//! radius of the potential field around players
+const double INFLUENCE_RADIUS = 2.5;
+//! maximal potential field penalty of one player
+const double PENALTY_WEIGHT = 2.0;
+//! distance to the waypoint along the path
+const double LOOKAHEAD_DIST = 2.5;
+//! players with the larger accuracy count are ignored
+const int VALID_COUNT_THR = 10;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the indices of the adjacent cells
+  \param index cell index
+  \param result array of at least 8 elements to store the indices
+  \return the number of the adjacent cells
+ */
+int
+neighbors( const int index,
+           int * result )
+{
+    const int x = index % PathPlanner::GRID_SIZE;
+    const int y = index / PathPlanner::GRID_SIZE;
+
+    int n = 0;
+    for ( int dy = -1; dy <= 1; ++dy )
+    {
+        const int ny = y + dy;
+        if ( ny < 0 || PathPlanner::GRID_SIZE <= ny ) continue;
+
+        for ( int dx = -1; dx <= 1; ++dx )
+        {
+            const int nx = x + dx;
+            if ( ( dx == 0 && dy == 0 )
+                 || nx < 0 || PathPlanner::GRID_SIZE <= nx )
+            {
+                continue;
+            }
+
+            result[n++] = ny * PathPlanner::GRID_SIZE + nx;
+        }
+    }
+
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compare the priority keys without the cell index
+ */
+template < typename K >
+inline
+bool
+key_less( const K & lhs,
+          const K & rhs )
+{
+    return ( lhs.k1_ < rhs.k1_
+             || ( lhs.k1_ == rhs.k1_
+                  && lhs.k2_ < rhs.k2_ ) );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PathPlanner::PathPlanner()
+    : M_time_limit( 1.0 )
+    , M_max_expand( 2000 )
+    , M_time( -1, 0 )
+    , M_target( 0.0, 0.0 )
+    , M_goal_point( 0.0, 0.0 )
+    , M_origin( 0.0, 0.0 )
+    , M_goal( -1 )
+    , M_start( -1 )
+    , M_last_start( -1 )
+    , M_km( 0.0 )
+    , M_expand_count( 0 )
+    , M_changed_count( 0 )
+    , M_elapsed_msec( 0.0 )
+{
+    for ( int i = 0; i < NUM_CELLS; ++i )
+    {
+        M_cost[i] = 0.0;
+        M_g[i] = INF_COST;
+        M_rhs[i] = INF_COST;
+        M_in_open[i] = false;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PathPlanner &
+PathPlanner::instance()
+{
+    static PathPlanner s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PathPlanner::cellIndex( const Vector2D & point ) const
+{
+    const int x = static_cast< int >( std::floor( ( point.x - M_origin.x ) / CELL_SIZE ) );
+    const int y = static_cast< int >( std::floor( ( point.y - M_origin.y ) / CELL_SIZE ) );
+
+    if ( x < 0 || GRID_SIZE <= x
+         || y < 0 || GRID_SIZE <= y )
+    {
+        return -1;
+    }
+
+    return y * GRID_SIZE + x;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+PathPlanner::cellCenter( const int index ) const
+{
+    return Vector2D( M_origin.x + ( index % GRID_SIZE + 0.5 ) * CELL_SIZE,
+                     M_origin.y + ( index / GRID_SIZE + 0.5 ) * CELL_SIZE );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PathPlanner::heuristic( const int a,
+                        const int b ) const
+{
+    const int dx = std::abs( a % GRID_SIZE - b % GRID_SIZE );
+    const int dy = std::abs( a / GRID_SIZE - b / GRID_SIZE );
+
+    return CELL_SIZE * ( std::max( dx, dy )
+                         + ( std::sqrt( 2.0 ) - 1.0 ) * std::min( dx, dy ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PathPlanner::edgeCost( const int from,
+                       const int to ) const
+{
+    if ( M_cost[from] >= BLOCKED
+         || M_cost[to] >= BLOCKED )
+    {
+        return INF_COST;
+    }
+
+    const int fx = from % GRID_SIZE;
+    const int fy = from / GRID_SIZE;
+    const int tx = to % GRID_SIZE;
+    const int ty = to / GRID_SIZE;
+
+    double len = CELL_SIZE;
+    if ( fx != tx && fy != ty )
+    {
+        // never cut the corner of the blocked cell
+        if ( M_cost[fy * GRID_SIZE + tx] >= BLOCKED
+             || M_cost[ty * GRID_SIZE + fx] >= BLOCKED )
+        {
+            return INF_COST;
+        }
+        len *= std::sqrt( 2.0 );
+    }
+
+    return len * ( 1.0 + 0.5 * ( M_cost[from] + M_cost[to] ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PathPlanner::Key
+PathPlanner::calcKey( const int index ) const
+{
+    const double m = std::min( M_g[index], M_rhs[index] );
+    if ( m >= INF_COST )
+    {
+        return Key( INF_COST, INF_COST, index );
+    }
+
+    return Key( m + heuristic( M_start, index ) + M_km, m, index );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PathPlanner::updateVertex( const int index )
+{
+    if ( index != M_goal )
+    {
+        int adj[8];
+        const int n = neighbors( index, adj );
+
+        double rhs = INF_COST;
+        for ( int i = 0; i < n; ++i )
+        {
+            rhs = std::min( rhs, edgeCost( index, adj[i] ) + M_g[adj[i]] );
+        }
+        M_rhs[index] = rhs;
+    }
+
+    if ( M_in_open[index] )
+    {
+        M_open.erase( M_open_key[index] );
+        M_in_open[index] = false;
+    }
+
+    if ( M_g[index] != M_rhs[index] )
+    {
+        M_open_key[index] = calcKey( index );
+        M_open.insert( M_open_key[index] );
+        M_in_open[index] = true;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PathPlanner::computeShortestPath()
+{
+    const MSecTimer timer;
+
+    int count = 0;
+    while ( ! M_open.empty() )
+    {
+        const Key top = *M_open.begin();
+        if ( ! key_less( top, calcKey( M_start ) )
+             && M_rhs[M_start] == M_g[M_start] )
+        {
+            break;
+        }
+
+        if ( count >= M_max_expand
+             || ( count % 32 == 31
+                  && timer.elapsedReal() > M_time_limit ) )
+        {
+            M_expand_count += count;
+            return false;
+        }
+        ++count;
+
+        const int u = top.index_;
+        const Key new_key = calcKey( u );
+
+        M_open.erase( M_open.begin() );
+        M_in_open[u] = false;
+
+        if ( key_less( top, new_key ) )
+        {
+            // the key became larger by the moved start
+            M_open_key[u] = new_key;
+            M_open.insert( new_key );
+            M_in_open[u] = true;
+            continue;
+        }
+
+        int adj[8];
+        const int n = neighbors( u, adj );
+
+        if ( M_g[u] > M_rhs[u] )
+        {
+            M_g[u] = M_rhs[u];
+        }
+        else
+        {
+            M_g[u] = INF_COST;
+            updateVertex( u );
+        }
+
+        for ( int i = 0; i < n; ++i )
+        {
+            updateVertex( adj[i] );
+        }
+    }
+
+    M_expand_count += count;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PathPlanner::anchor( const Vector2D & self_pos,
+                     const Vector2D & target_point )
+{
+    const double range = GRID_SIZE * CELL_SIZE;
+
+    M_target = target_point;
+    M_goal_point = target_point;
+    if ( self_pos.dist( target_point ) > range * 0.5 - CELL_SIZE )
+    {
+        // the goal is the intermediate point on the way to the target
+        M_goal_point = self_pos
+            + ( target_point - self_pos ).setLengthVector( range * 0.5 - CELL_SIZE );
+    }
+
+    M_origin = ( self_pos + M_goal_point ) * 0.5 - Vector2D( range * 0.5, range * 0.5 );
+
+    M_goal = cellIndex( M_goal_point );
+    M_start = cellIndex( self_pos );
+    M_last_start = M_start;
+    M_km = 0.0;
+
+    M_time.assign( -1, 0 );
+    M_open.clear();
+    for ( int i = 0; i < NUM_CELLS; ++i )
+    {
+        M_cost[i] = 0.0;
+        M_g[i] = INF_COST;
+        M_rhs[i] = INF_COST;
+        M_in_open[i] = false;
+    }
+
+    M_rhs[M_goal] = 0.0;
+    M_open_key[M_goal] = calcKey( M_goal );
+    M_open.insert( M_open_key[M_goal] );
+    M_in_open[M_goal] = true;
+
+    dlog.addText( Logger::ACTION,
+                  "%s:%d: anchor grid. origin=(%.1f %.1f) goal=(%.1f %.1f)"
+                  ,__FILE__, __LINE__,
+                  M_origin.x, M_origin.y,
+                  M_goal_point.x, M_goal_point.y );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PathPlanner::createCost( const WorldModel & wm,
+                         double * cost ) const
+{
+    const double block_radius = ServerParam::i().defaultPlayerSize() * 2.0 + 0.3;
+    const double range = GRID_SIZE * CELL_SIZE;
+
+    std::fill( cost, cost + NUM_CELLS, 0.0 );
+
+    std::vector< Vector2D > obstacles;
+    obstacles.reserve( 22 );
+
+    const PlayerPtrCont * players[2] = { &wm.teammatesFromSelf(),
+                                         &wm.opponentsFromSelf() };
+    for ( int t = 0; t < 2; ++t )
+    {
+        const PlayerPtrCont::const_iterator end = players[t]->end();
+        for ( PlayerPtrCont::const_iterator it = players[t]->begin();
+              it != end;
+              ++it )
+        {
+            if ( (*it)->distFromSelf() > range ) break;
+            if ( (*it)->isGhost()
+                 || (*it)->posCount() > VALID_COUNT_THR )
+            {
+                continue;
+            }
+
+            obstacles.push_back( (*it)->pos() + (*it)->vel() );
+        }
+    }
+
+    // the ball must not be touched in the set play
+    if ( wm.gameMode().type() != GameMode::PlayOn
+         && wm.ball().posValid() )
+    {
+        obstacles.push_back( wm.ball().pos() );
+    }
+
+    const int cell_range = static_cast< int >( std::ceil( INFLUENCE_RADIUS / CELL_SIZE ) );
+
+    for ( std::vector< Vector2D >::const_iterator p = obstacles.begin();
+          p != obstacles.end();
+          ++p )
+    {
+        const int cx = static_cast< int >( std::floor( ( p->x - M_origin.x ) / CELL_SIZE ) );
+        const int cy = static_cast< int >( std::floor( ( p->y - M_origin.y ) / CELL_SIZE ) );
+
+        for ( int y = std::max( 0, cy - cell_range );
+              y <= std::min( GRID_SIZE - 1, cy + cell_range );
+              ++y )
+        {
+            for ( int x = std::max( 0, cx - cell_range );
+                  x <= std::min( GRID_SIZE - 1, cx + cell_range );
+                  ++x )
+            {
+                const int i = y * GRID_SIZE + x;
+                const double d = cellCenter( i ).dist( *p );
+                if ( d < block_radius )
+                {
+                    cost[i] = BLOCKED;
+                }
+                else if ( d < INFLUENCE_RADIUS )
+                {
+                    const double r = ( INFLUENCE_RADIUS - d )
+                        / ( INFLUENCE_RADIUS - block_radius );
+                    cost[i] = std::min( BLOCKED * 0.5,
+                                        cost[i] + PENALTY_WEIGHT * r * r );
+                }
+            }
+        }
+    }
+
+    // the start and the goal are always reachable
+    cost[M_start] = std::min( cost[M_start], PENALTY_WEIGHT );
+    cost[M_goal] = std::min( cost[M_goal], PENALTY_WEIGHT );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PathPlanner::updateCost( const WorldModel & wm )
+{
+    double cost[NUM_CELLS];
+    createCost( wm, cost );
+
+    std::vector< int > changed;
+    for ( int i = 0; i < NUM_CELLS; ++i )
+    {
+        if ( std::fabs( cost[i] - M_cost[i] ) > 1.0e-3 )
+        {
+            M_cost[i] = cost[i];
+            changed.push_back( i );
+        }
+    }
+
+    M_changed_count = static_cast< int >( changed.size() );
+
+    for ( std::vector< int >::const_iterator it = changed.begin();
+          it != changed.end();
+          ++it )
+    {
+        int adj[8];
+        const int n = neighbors( *it, adj );
+
+        updateVertex( *it );
+        for ( int i = 0; i < n; ++i )
+        {
+            updateVertex( adj[i] );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PathPlanner::plan( const PlayerAgent * agent,
+                   const Vector2D & target_point,
+                   Vector2D * waypoint )
+{
+    const MSecTimer timer;
+    const WorldModel & wm = agent->world();
+    const Vector2D self_pos = wm.self().pos();
+
+    *waypoint = target_point;
+    M_expand_count = 0;
+    M_changed_count = 0;
+    M_elapsed_msec = 0.0;
+
+    if ( self_pos.dist( target_point ) < CELL_SIZE * 1.5 )
+    {
+        return true;
+    }
+
+    //
+    // anchor the grid, or reuse the current grid
+    //
+    int start = -1;
+    if ( M_goal >= 0
+         && M_target.dist2( target_point ) < 1.0 )
+    {
+        start = cellIndex( self_pos );
+        if ( start >= 0 )
+        {
+            const int x = start % GRID_SIZE;
+            const int y = start / GRID_SIZE;
+            if ( x < 1 || GRID_SIZE - 1 <= x
+                 || y < 1 || GRID_SIZE - 1 <= y
+                 || ( start == M_goal
+                      && M_goal_point.dist2( target_point ) > 1.0e-6 ) )
+            {
+                start = -1;
+            }
+        }
+    }
+
+    if ( start < 0 )
+    {
+        anchor( self_pos, target_point );
+    }
+    else if ( start != M_start )
+    {
+        M_km += heuristic( M_last_start, start );
+        M_last_start = start;
+        M_start = start;
+        M_time.assign( -1, 0 );
+    }
+
+    if ( M_time != wm.time() )
+    {
+        M_time = wm.time();
+        updateCost( wm );
+    }
+
+    //
+    // if no blocked cell is on the straight line, go directly
+    //
+    {
+        const double check_dist = std::min( self_pos.dist( target_point ),
+                                            LOOKAHEAD_DIST + CELL_SIZE );
+        const Vector2D step = ( target_point - self_pos ).setLengthVector( CELL_SIZE * 0.5 );
+        bool free = true;
+        Vector2D p = self_pos;
+        for ( double d = 0.0; d < check_dist; d += CELL_SIZE * 0.5 )
+        {
+            p += step;
+            const int i = cellIndex( p );
+            if ( i >= 0
+                 && i != M_start
+                 && M_cost[i] >= BLOCKED )
+            {
+                free = false;
+                break;
+            }
+        }
+
+        if ( free )
+        {
+            M_elapsed_msec = timer.elapsedReal();
+            return true;
+        }
+    }
+
+    //
+    // search
+    //
+    if ( ! computeShortestPath() )
+    {
+        M_elapsed_msec = timer.elapsedReal();
+        dlog.addText( Logger::ACTION,
+                      "%s:%d: search is not completed. expand=%d changed=%d"
+                      ,__FILE__, __LINE__,
+                      M_expand_count, M_changed_count );
+        return false;
+    }
+
+    if ( M_g[M_start] >= INF_COST )
+    {
+        M_elapsed_msec = timer.elapsedReal();
+        dlog.addText( Logger::ACTION,
+                      "%s:%d: no path."
+                      ,__FILE__, __LINE__ );
+        return false;
+    }
+
+    //
+    // follow the path until the lookahead distance
+    //
+    int s = M_start;
+    for ( int step = 0; step < NUM_CELLS && s != M_goal; ++step )
+    {
+        int adj[8];
+        const int n = neighbors( s, adj );
+
+        int next = -1;
+        double min_cost = INF_COST;
+        for ( int i = 0; i < n; ++i )
+        {
+            const double c = edgeCost( s, adj[i] ) + M_g[adj[i]];
+            if ( c < min_cost )
+            {
+                min_cost = c;
+                next = adj[i];
+            }
+        }
+
+        if ( next < 0 )
+        {
+            M_elapsed_msec = timer.elapsedReal();
+            return false;
+        }
+
+        s = next;
+        if ( cellCenter( s ).dist( self_pos ) >= LOOKAHEAD_DIST )
+        {
+            break;
+        }
+    }
+
+    *waypoint = ( s == M_goal
+                  ? M_goal_point
+                  : cellCenter( s ) );
+
+    M_elapsed_msec = timer.elapsedReal();
+    dlog.addText( Logger::ACTION,
+                  "%s:%d: waypoint=(%.2f %.2f) expand=%d changed=%d elapsed=%.3f"
+                  ,__FILE__, __LINE__,
+                  waypoint->x, waypoint->y,
+                  M_expand_count, M_changed_count, M_elapsed_msec );
+    return true;
+}
+
+}
@@ -0,0 +1,301 @@
+// -*-c++-*-
+
+/*!
+  \file path_planner.h
+  \brief incremental local path planner on the occupancy grid
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ACTION_PATH_PLANNER_H
+#define RCSC_ACTION_PATH_PLANNER_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+#include <set>
+
+namespace rcsc {
+
+class PlayerAgent;
+class WorldModel;
+
+/*!
+  \class PathPlanner
+  \brief local path planner for the player movement.
+
+  The planner uses the coarse occupancy grid around the player and the
+  target point. The cost of each cell is built from the player snapshot
+  of the current cycle: the cells near the players' next positions are
+  blocked, and the surrounding cells get the potential field penalty.
+
+  The shortest path is searched by D* Lite from the goal cell to the
+  player's cell. While the grid is anchored at the same place, the
+  search state is kept across cycles and only the vertices affected by
+  the changed cells and by the player's movement are updated. The
+  search is also resumed in the next cycle if the time limit is
+  reached.
+ */
+class PathPlanner {
+public:
+
+    //! the number of cells for each axis
+    static const int GRID_SIZE = 32;
+    //! the total number of cells
+    static const int NUM_CELLS = GRID_SIZE * GRID_SIZE;
+
+    //! cell size [m]
+    static const double CELL_SIZE;
+
+private:
+
+    /*!
+      \struct Key
+      \brief priority of the open list element
+     */
+    struct Key {
+        double k1_; //!< primary key
+        double k2_; //!< secondary key
+        int index_; //!< cell index
+
+        Key()
+            : k1_( 0.0 )
+            , k2_( 0.0 )
+            , index_( -1 )
+          { }
+
+        Key( const double & k1,
+             const double & k2,
+             const int index )
+            : k1_( k1 )
+            , k2_( k2 )
+            , index_( index )
+          { }
+
+        bool operator<( const Key & rhs ) const
+          {
+              return ( k1_ < rhs.k1_
+                       || ( k1_ == rhs.k1_
+                            && ( k2_ < rhs.k2_
+                                 || ( k2_ == rhs.k2_
+                                      && index_ < rhs.index_ ) ) ) );
+          }
+    };
+
+    //! time limit of one search [msec]
+    double M_time_limit;
+    //! the maximal number of expanded cells in one search
+    int M_max_expand;
+
+    //! last cost update time
+    GameTime M_time;
+
+    //! original target point of the current grid
+    Vector2D M_target;
+    //! goal point in the current grid
+    Vector2D M_goal_point;
+    //! global coordinate of the grid corner
+    Vector2D M_origin;
+
+    //! goal cell index, or -1 if the grid is not anchored
+    int M_goal;
+    //! start cell index
+    int M_start;
+    //! start cell index of the last heuristic update
+    int M_last_start;
+    //! heuristic offset for the moved start
+    double M_km;
+
+    //! cell penalty. the value greater than BLOCKED means the cell is blocked.
+    double M_cost[NUM_CELLS];
+    //! cost to the goal
+    double M_g[NUM_CELLS];
+    //! one step lookahead cost to the goal
+    double M_rhs[NUM_CELLS];
+
+    //! open list
+    std::set< Key > M_open;
+    //! key of the open list element for each cell
+    Key M_open_key[NUM_CELLS];
+    //! true if the cell is in the open list
+    bool M_in_open[NUM_CELLS];
+
+    //! the number of expanded cells in the last search
+    int M_expand_count;
+    //! the number of cells whose cost changed in the last update
+    int M_changed_count;
+    //! elapsed time of the last search [msec]
+    double M_elapsed_msec;
+
+    /*!
+      \brief private for singleton
+     */
+    PathPlanner();
+
+    // not used
+    PathPlanner( const PathPlanner & );
+    PathPlanner & operator=( const PathPlanner & );
+
+public:
+
+    /*!
+      \brief singleton interface
+      \return reference to the instance
+     */
+    static
+    PathPlanner & instance();
+
+    /*!
+      \brief set the search limits
+      \param msec time limit of one search
+      \param max_expand the maximal number of expanded cells
+     */
+    void setLimit( const double & msec,
+                   const int max_expand )
+      {
+          M_time_limit = msec;
+          M_max_expand = max_expand;
+      }
+
+    /*!
+      \brief get the next waypoint to the target point
+      \param agent const pointer to the agent
+      \param target_point final target point
+      \param waypoint pointer to the variable to store the result
+      \return true if the path is found. if no obstacle is on the way,
+      target_point itself is returned.
+     */
+    bool plan( const PlayerAgent * agent,
+               const Vector2D & target_point,
+               Vector2D * waypoint );
+
+    /*!
+      \brief get the number of expanded cells in the last search
+      \return the number of cells
+     */
+    int expandCount() const
+      {
+          return M_expand_count;
+      }
+
+    /*!
+      \brief get the number of changed cells in the last update
+      \return the number of cells
+     */
+    int changedCount() const
+      {
+          return M_changed_count;
+      }
+
+    /*!
+      \brief get the elapsed time of the last search
+      \return milli seconds
+     */
+    double elapsedMSec() const
+      {
+          return M_elapsed_msec;
+      }
+
+private:
+
+    /*!
+      \brief anchor the grid and initialize the search state
+      \param self_pos current player position
+      \param target_point final target point
+     */
+    void anchor( const Vector2D & self_pos,
+                 const Vector2D & target_point );
+
+    /*!
+      \brief create the cell cost from the world model
+      \param wm const reference to the world model
+      \param cost array to store the result
+     */
+    void createCost( const WorldModel & wm,
+                     double * cost ) const;
+
+    /*!
+      \brief update the cell cost and the affected vertices
+      \param wm const reference to the world model
+     */
+    void updateCost( const WorldModel & wm );
+
+    /*!
+      \brief run D* Lite until the start cell is consistent
+      \return true if the search is completed
+     */
+    bool computeShortestPath();
+
+    /*!
+      \brief update rhs value and the open list element of the cell
+      \param index cell index
+     */
+    void updateVertex( const int index );
+
+    /*!
+      \brief get the priority key of the cell
+      \param index cell index
+      \return key value
+     */
+    Key calcKey( const int index ) const;
+
+    /*!
+      \brief get the cost of moving between the adjacent cells
+      \param from cell index
+      \param to cell index
+      \return edge cost
+     */
+    double edgeCost( const int from,
+                     const int to ) const;
+
+    /*!
+      \brief get the heuristic distance between the cells
+      \param a cell index
+      \param b cell index
+      \return octile distance
+     */
+    double heuristic( const int a,
+                      const int b ) const;
+
+    /*!
+      \brief get the cell index of the point
+      \param point global coordinate
+      \return cell index, or -1 if out of the grid
+     */
+    int cellIndex( const Vector2D & point ) const;
+
+    /*!
+      \brief get the center point of the cell
+      \param index cell index
+      \return global coordinate
+     */
+    Vector2D cellCenter( const int index ) const;
+
+};
+
+}
+
+#endif
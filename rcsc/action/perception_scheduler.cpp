@@ -0,0 +1,457 @@
+// -*-c++-*-
+
+/*!
+  \file perception_scheduler.cpp
+  \brief information gain based view width and neck angle scheduler
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "perception_scheduler.h"
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/see_state.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/geom/rect_2d.h>
+
+#include <cmath>
+
+namespace rcsc {
+
+const int PerceptionScheduler::NUM_BINS;
+
+namespace {
+
+//! confidence decay rate of one cycle
+const double CONF_DECAY = 0.9;
+
+//! weight of the direction confidence
+const double DIR_WEIGHT = 0.1;
+//! weight of the ball
+const double BALL_WEIGHT = 1.5;
+//! weight of the ball when some player can kick it
+const double KICKABLE_BALL_WEIGHT = 3.0;
+//! weight of the players
+const double PLAYER_WEIGHT = 1.0;
+
+//! cost of one extra cycle without see
+const double LATENCY_COST = 0.5;
+//! cost of one extra cycle without see when some player can kick the ball
+const double KICKABLE_LATENCY_COST = 2.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the expected confidence gain of the object
+  \param count accuracy count of the object
+  \return gain value [0, 1)
+ */
+inline
+double
+confidence_gain( const int count )
+{
+    return 1.0 - std::pow( CONF_DECAY, count );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PerceptionScheduler::PerceptionScheduler()
+    : M_time( -1, 0 )
+    , M_next_body( 0.0 )
+    , M_next_pos( 0.0, 0.0 )
+{
+    for ( int i = 0; i < NUM_BINS; ++i ) M_gain[i] = 0.0;
+    for ( int i = 0; i < NUM_BINS * 2 + 1; ++i ) M_prefix[i] = 0.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PerceptionScheduler &
+PerceptionScheduler::instance()
+{
+    static PerceptionScheduler s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PerceptionScheduler::bin_index( const AngleDeg & angle )
+{
+    int idx = static_cast< int >( std::floor( ( angle.degree() + 180.0 )
+                                              / WorldModel::DIR_STEP ) );
+    idx %= NUM_BINS;
+    if ( idx < 0 ) idx += NUM_BINS;
+    return idx;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PerceptionScheduler::see_period( const ViewWidth & width )
+{
+    if ( SeeState::synch_see_mode() )
+    {
+        switch ( width.type() ) {
+        case ViewWidth::NARROW:
+            return 1.0;
+        case ViewWidth::NORMAL:
+            return 2.0;
+        default:
+            break;
+        }
+        return 3.0;
+    }
+
+    double factor = 2.0;
+    switch ( width.type() ) {
+    case ViewWidth::NARROW:
+        factor = 0.5;
+        break;
+    case ViewWidth::NORMAL:
+        factor = 1.0;
+        break;
+    default:
+        break;
+    }
+
+    return ServerParam::i().sendStep() * factor
+        / static_cast< double >( ServerParam::i().simulatorStep() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PerceptionScheduler::update( const PlayerAgent * agent )
+{
+    static const Rect2D pitch_rect( -ServerParam::i().pitchHalfLength(),
+                                    -ServerParam::i().pitchHalfWidth(),
+                                    ServerParam::i().pitchLength(),
+                                    ServerParam::i().pitchWidth() );
+    static const Rect2D goalie_rect( ServerParam::i().pitchHalfLength() - 3.0,
+                                     -15.0,
+                                     10.0,
+                                     30.0 );
+
+    const WorldModel & wm = agent->world();
+    const AngleDeg next_body = agent->effector().queuedNextMyBody();
+    const Vector2D next_pos = agent->effector().queuedNextMyPos();
+
+    if ( M_time == wm.time()
+         && ( M_next_body - next_body ).abs() < 0.5
+         && M_next_pos.dist2( next_pos ) < 1.0e-6 )
+    {
+        return;
+    }
+
+    M_time = wm.time();
+    M_next_body = next_body;
+    M_next_pos = next_pos;
+
+    for ( int w = 0; w < ViewWidth::ILLEGAL; ++w )
+    {
+        M_best[w] = Candidate();
+    }
+
+    //
+    // direction confidence
+    //
+    for ( int i = 0; i < NUM_BINS; ++i )
+    {
+        const AngleDeg angle = -180.0 + ( i + 0.5 ) * WorldModel::DIR_STEP;
+        const Vector2D face_point = next_pos + Vector2D::polar2vector( 20.0, angle );
+        if ( ! pitch_rect.contains( face_point )
+             && ! goalie_rect.contains( face_point ) )
+        {
+            M_gain[i] = 0.0;
+        }
+        else
+        {
+            M_gain[i] = DIR_WEIGHT * confidence_gain( wm.dirCount( angle ) );
+        }
+    }
+
+    const double visible_dist = ServerParam::i().visibleDistance();
+    const bool exist_kickable = ( wm.existKickableTeammate()
+                                  || wm.existKickableOpponent() );
+
+    //
+    // ball
+    //
+    if ( wm.ball().posValid() )
+    {
+        const Vector2D rel = wm.ball().pos() + wm.ball().vel() - next_pos;
+        if ( rel.r() > visible_dist )
+        {
+            M_gain[ bin_index( rel.th() ) ]
+                += ( exist_kickable ? KICKABLE_BALL_WEIGHT : BALL_WEIGHT )
+                * confidence_gain( wm.ball().posCount() + 1 );
+        }
+    }
+
+    //
+    // players
+    //
+    const PlayerPtrCont * players[2] = { &wm.teammatesFromSelf(),
+                                         &wm.opponentsFromSelf() };
+    for ( int t = 0; t < 2; ++t )
+    {
+        const PlayerPtrCont::const_iterator end = players[t]->end();
+        for ( PlayerPtrCont::const_iterator it = players[t]->begin();
+              it != end;
+              ++it )
+        {
+            if ( (*it)->isGhost() ) continue;
+
+            const Vector2D rel = (*it)->pos() + (*it)->vel() - next_pos;
+            if ( rel.r() < visible_dist ) continue;
+
+            const double relevance
+                = 1.0 / ( 1.0 + 0.1 * (*it)->distFromBall() )
+                + 0.5 / ( 1.0 + 0.1 * (*it)->distFromSelf() );
+
+            M_gain[ bin_index( rel.th() ) ]
+                += PLAYER_WEIGHT * relevance
+                * confidence_gain( (*it)->posCount() + 1 );
+        }
+    }
+
+    M_prefix[0] = 0.0;
+    for ( int i = 0; i < NUM_BINS * 2; ++i )
+    {
+        M_prefix[i + 1] = M_prefix[i] + M_gain[i % NUM_BINS];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PerceptionScheduler::coneGain( const AngleDeg & face,
+                               const int size ) const
+{
+    const int n = std::min( std::max( size, 1 ), static_cast< int >( NUM_BINS ) );
+    const int start = bin_index( face
+                                 - n * WorldModel::DIR_STEP * 0.5
+                                 + WorldModel::DIR_STEP * 0.5 );
+    return M_prefix[start + n] - M_prefix[start];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PerceptionScheduler::search( const PlayerAgent * agent,
+                             const ViewWidth & width,
+                             const Vector2D * point,
+                             Candidate & result ) const
+{
+    const ServerParam & param = ServerParam::i();
+    const WorldModel & wm = agent->world();
+
+    const double view_width = width.width();
+    const int size = static_cast< int >
+        ( rint( ( view_width - WorldModel::DIR_STEP * 1.5 ) / WorldModel::DIR_STEP ) );
+
+    const double latency_cost = ( wm.existKickableTeammate()
+                                  || wm.existKickableOpponent()
+                                  ? KICKABLE_LATENCY_COST
+                                  : LATENCY_COST );
+    const double period = see_period( width );
+
+    AngleDeg point_angle( 0.0 );
+    if ( point )
+    {
+        point_angle = ( *point - M_next_pos ).th();
+    }
+
+    bool found = false;
+    result = Candidate();
+
+    for ( double neck = param.minNeckAngle();
+          neck < param.maxNeckAngle() + WorldModel::DIR_STEP * 0.5;
+          neck += WorldModel::DIR_STEP )
+    {
+        const AngleDeg face = M_next_body + std::min( neck, param.maxNeckAngle() );
+
+        if ( point
+             && ( point_angle - face ).abs() > view_width * 0.5 - 5.0 )
+        {
+            continue;
+        }
+
+        const double score = ( coneGain( face, size )
+                               - latency_cost * std::max( 0.0, period - 1.0 ) )
+            / period;
+
+        if ( score > result.score_
+             || ! found )
+        {
+            found = true;
+            result.width_ = width;
+            result.face_ = face;
+            result.score_ = score;
+        }
+    }
+
+    return found;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const
+PerceptionScheduler::Candidate &
+PerceptionScheduler::plan( const PlayerAgent * agent,
+                           const ViewWidth & width )
+{
+    static const Candidate s_illegal;
+
+    if ( width.type() == ViewWidth::ILLEGAL )
+    {
+        return s_illegal;
+    }
+
+    update( agent );
+
+    Candidate & best = M_best[width.type()];
+    if ( best.width_.type() == ViewWidth::ILLEGAL )
+    {
+        search( agent, width, static_cast< const Vector2D * >( 0 ), best );
+
+        dlog.addText( Logger::ACTION,
+                      "%s:%d: plan width=%.0f face=%.0f score=%.3f"
+                      ,__FILE__, __LINE__,
+                      width.width(), best.face_.degree(), best.score_ );
+    }
+
+    return best;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PerceptionScheduler::Candidate
+PerceptionScheduler::planJoint( const PlayerAgent * agent,
+                                const ViewWidth & default_width )
+{
+    if ( ! SeeState::synch_see_mode()
+         && ! agent->seeState().isSynch() )
+    {
+        return plan( agent, agent->effector().queuedNextViewWidth() );
+    }
+
+    Candidate result;
+
+    for ( int w = 0; w < ViewWidth::ILLEGAL; ++w )
+    {
+        const ViewWidth width( static_cast< ViewWidth::Type >( w ) );
+        if ( ! agent->seeState().canChangeViewTo( width, agent->world().time() ) )
+        {
+            continue;
+        }
+
+        const Candidate & c = plan( agent, width );
+        if ( c.width_.type() != ViewWidth::ILLEGAL
+             && ( result.width_.type() == ViewWidth::ILLEGAL
+                  || c.score_ > result.score_ ) )
+        {
+            result = c;
+        }
+    }
+
+    if ( result.width_.type() == ViewWidth::ILLEGAL )
+    {
+        dlog.addText( Logger::ACTION,
+                      "%s:%d: no width keeps synch. use the default width %.0f"
+                      ,__FILE__, __LINE__,
+                      default_width.width() );
+        return plan( agent, default_width );
+    }
+
+    dlog.addText( Logger::ACTION,
+                  "%s:%d: joint plan width=%.0f face=%.0f score=%.3f"
+                  ,__FILE__, __LINE__,
+                  result.width_.width(), result.face_.degree(), result.score_ );
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PerceptionScheduler::planWithPoint( const PlayerAgent * agent,
+                                    const ViewWidth & width,
+                                    const Vector2D & point,
+                                    Candidate & result )
+{
+    if ( width.type() == ViewWidth::ILLEGAL )
+    {
+        return false;
+    }
+
+    update( agent );
+
+    if ( ! search( agent, width, &point, result ) )
+    {
+        dlog.addText( Logger::ACTION,
+                      "%s:%d: cannot keep (%.1f %.1f) in the view"
+                      ,__FILE__, __LINE__,
+                      point.x, point.y );
+        return false;
+    }
+
+    dlog.addText( Logger::ACTION,
+                  "%s:%d: plan with (%.1f %.1f) face=%.0f score=%.3f"
+                  ,__FILE__, __LINE__,
+                  point.x, point.y,
+                  result.face_.degree(), result.score_ );
+    return true;
+}
+
+}
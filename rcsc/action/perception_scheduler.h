@@ -0,0 +1,214 @@
+// -*-c++-*-
+
+/*!
+  \file perception_scheduler.h
+  \brief information gain based view width and neck angle scheduler
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ACTION_PERCEPTION_SCHEDULER_H
+#define RCSC_ACTION_PERCEPTION_SCHEDULER_H
+
+#include <rcsc/player/view_mode.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/angle_deg.h>
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+
+class PlayerAgent;
+
+/*!
+  \class PerceptionScheduler
+  \brief joint planner of the view width and the face direction.
+
+  The expected confidence gain of the next see message is accumulated
+  into the direction bins of WorldModel. Each bin holds the gain of the
+  direction confidence and the gain of the ball and players that will be
+  in that direction, weighted by their relevance to the current
+  decision. The circular prefix sum of the bins is built once per cycle,
+  so the gain of any view cone is evaluated in constant time.
+
+  A candidate (view width, face angle) is scored by the cone gain
+  divided by the see period of that view width.
+ */
+class PerceptionScheduler {
+public:
+
+    //! the number of direction bins
+    static const int NUM_BINS = 72;
+
+    /*!
+      \struct Candidate
+      \brief planned view width and face direction
+     */
+    struct Candidate {
+        ViewWidth width_; //!< view width
+        AngleDeg face_; //!< global face angle
+        double score_; //!< gain per cycle
+
+        /*!
+          \brief initialize with the illegal value
+         */
+        Candidate()
+            : width_( ViewWidth::ILLEGAL )
+            , face_( 0.0 )
+            , score_( -1.0 )
+          { }
+    };
+
+private:
+
+    //! last updated time
+    GameTime M_time;
+    //! queued next body angle used for the last update
+    AngleDeg M_next_body;
+    //! queued next self position used for the last update
+    Vector2D M_next_pos;
+
+    //! expected gain of each direction bin
+    double M_gain[NUM_BINS];
+    //! circular prefix sum. M_prefix[i] is the sum of the first i bins.
+    double M_prefix[NUM_BINS * 2 + 1];
+
+    //! cached best candidate for each view width
+    Candidate M_best[ViewWidth::ILLEGAL];
+
+    /*!
+      \brief private for singleton
+     */
+    PerceptionScheduler();
+
+    // not used
+    PerceptionScheduler( const PerceptionScheduler & );
+    PerceptionScheduler & operator=( const PerceptionScheduler & );
+
+public:
+
+    /*!
+      \brief get the singleton instance
+      \return reference to the instance
+     */
+    static
+    PerceptionScheduler & instance();
+
+    /*!
+      \brief get the best face angle for the given view width
+      \param agent const pointer to the agent
+      \param width view width
+      \return const reference to the result
+     */
+    const
+    Candidate & plan( const PlayerAgent * agent,
+                      const ViewWidth & width );
+
+    /*!
+      \brief get the best pair of the view width and the face angle
+      \param agent const pointer to the agent
+      \param default_width view width used if no width can keep see
+      synchronization
+      \return best candidate among the view widths that keep see
+      synchronization. if not synchronized, the queued view width is
+      used.
+     */
+    Candidate planJoint( const PlayerAgent * agent,
+                         const ViewWidth & default_width );
+
+    /*!
+      \brief get the best face angle that keeps the point in the view
+      \param agent const pointer to the agent
+      \param width view width
+      \param point global coordinate of the point
+      \param result reference to the variable to store the result
+      \return true if the point can be kept in the view
+     */
+    bool planWithPoint( const PlayerAgent * agent,
+                        const ViewWidth & width,
+                        const Vector2D & point,
+                        Candidate & result );
+
+    /*!
+      \brief get the expected gain of the direction bin
+      \param angle global angle
+      \return gain value
+     */
+    double gain( const AngleDeg & angle ) const
+      {
+          return M_gain[ bin_index( angle ) ];
+      }
+
+private:
+
+    /*!
+      \brief build the gain table if not yet done for the current state
+      \param agent const pointer to the agent
+     */
+    void update( const PlayerAgent * agent );
+
+    /*!
+      \brief get the sum of the gain in the cone
+      \param face global center angle
+      \param size the number of bins in the cone
+      \return sum of the gain
+     */
+    double coneGain( const AngleDeg & face,
+                     const int size ) const;
+
+    /*!
+      \brief evaluate all face angles for the view width
+      \param agent const pointer to the agent
+      \param width view width
+      \param point pointer to the point that must be kept in the view, or NULL
+      \param result reference to the variable to store the result
+      \return true if at least one face angle is found
+     */
+    bool search( const PlayerAgent * agent,
+                 const ViewWidth & width,
+                 const Vector2D * point,
+                 Candidate & result ) const;
+
+    /*!
+      \brief get the direction bin index
+      \param angle global angle
+      \return index [0, NUM_BINS)
+     */
+    static
+    int bin_index( const AngleDeg & angle );
+
+    /*!
+      \brief get the estimated see period
+      \param width view width
+      \return the number of cycles between see messages
+     */
+    static
+    double see_period( const ViewWidth & width );
+
+};
+
+}
+
+#endif
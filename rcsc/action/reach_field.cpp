@@ -0,0 +1,352 @@
+// -*-c++-*-
+
+/*!
+  \file reach_field.cpp
+  \brief per cycle player reach time field Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "reach_field.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/timer.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+const int ReachField::GRID_X;
+const int ReachField::GRID_Y;
+const double ReachField::CELL_SIZE = 2.0;
+const double ReachField::MAX_STEP = 30.0;
+const double ReachField::STEP_TABLE_RES = 0.25;
+const int ReachField::STEP_TABLE_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ReachField::ReachField()
+    : M_time( -1, 0 )
+    , M_elapsed_msec( 0.0 )
+{
+    std::fill( M_our, M_our + GRID_X * GRID_Y, static_cast< float >( MAX_STEP ) );
+    std::fill( M_their, M_their + GRID_X * GRID_Y, static_cast< float >( MAX_STEP ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const
+ReachField &
+ReachField::get( const WorldModel & wm )
+{
+    static ReachField S_instance;
+
+    if ( S_instance.M_time != wm.time() )
+    {
+        S_instance.update( wm );
+    }
+
+    return S_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReachField::update( const WorldModel & wm )
+{
+    const MSecTimer timer;
+
+    M_time = wm.time();
+
+    std::fill( M_our, M_our + GRID_X * GRID_Y, static_cast< float >( MAX_STEP ) );
+    std::fill( M_their, M_their + GRID_X * GRID_Y, static_cast< float >( MAX_STEP ) );
+
+    const AbstractPlayerCont::const_iterator t_end = wm.allTeammates().end();
+    for ( AbstractPlayerCont::const_iterator t = wm.allTeammates().begin();
+          t != t_end;
+          ++t )
+    {
+        addPlayer( **t, false, M_our );
+    }
+
+    const AbstractPlayerCont::const_iterator o_end = wm.allOpponents().end();
+    for ( AbstractPlayerCont::const_iterator o = wm.allOpponents().begin();
+          o != o_end;
+          ++o )
+    {
+        addPlayer( **o, true, M_their );
+    }
+
+    M_elapsed_msec = timer.elapsedReal();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const
+std::vector< float > &
+ReachField::stepTable( const PlayerType & ptype )
+{
+    for ( std::vector< StepTable >::const_iterator it = M_step_tables.begin();
+          it != M_step_tables.end();
+          ++it )
+    {
+        if ( it->first == &ptype )
+        {
+            return it->second;
+        }
+    }
+
+    // create the table by the dash distance table.
+    // element i is the fractional step to move i * STEP_TABLE_RES.
+
+    const std::vector< double > & dash_table = ptype.dashDistanceTable();
+    const double speed_max = std::max( 0.1, ptype.realSpeedMax() );
+
+    std::vector< float > table( STEP_TABLE_SIZE );
+    for ( int i = 0; i < STEP_TABLE_SIZE; ++i )
+    {
+        const double dist = i * STEP_TABLE_RES;
+        double step = 0.0;
+
+        std::vector< double >::const_iterator it
+            = std::lower_bound( dash_table.begin(), dash_table.end(), dist );
+        if ( it == dash_table.end() )
+        {
+            const double last = ( dash_table.empty() ? 0.0 : dash_table.back() );
+            step = dash_table.size() + ( dist - last ) / speed_max;
+        }
+        else
+        {
+            const int n = it - dash_table.begin();
+            const double prev = ( n == 0 ? 0.0 : dash_table[n - 1] );
+            step = n + ( dist - prev ) / std::max( 1.0e-3, *it - prev );
+        }
+
+        table[i] = static_cast< float >( std::min( step, MAX_STEP ) );
+    }
+
+    M_step_tables.push_back( StepTable( &ptype, table ) );
+    return M_step_tables.back().second;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReachField::addPlayer( const AbstractPlayerObject & p,
+                       const bool their,
+                       float * field )
+{
+    if ( p.isGhost()
+         || p.posCount() > 30 )
+    {
+        return;
+    }
+
+    const ServerParam & SP = ServerParam::i();
+
+    const PlayerType * ptype = p.playerTypePtr();
+    if ( ! ptype )
+    {
+        ptype = PlayerTypeSet::i().get( Hetero_Default );
+        if ( ! ptype )
+        {
+            return;
+        }
+    }
+
+    const std::vector< float > & table = stepTable( *ptype );
+
+    const Vector2D start = p.pos() + p.vel();
+    const double error = std::min( p.posCount(), 5 ) * ptype->realSpeedMax() * 0.5;
+    const double kickable = ptype->kickableArea() + error;
+    const double catchable = std::max( SP.catchableArea(), ptype->kickableArea() ) + error;
+
+    // the goalie can catch the ball within his own penalty area
+    const bool goalie = p.goalie();
+    const double penalty_x = ( their
+                               ? SP.theirPenaltyAreaLineX()
+                               : SP.ourPenaltyAreaLineX() );
+
+    // one turn is added if the target is not in front of the body
+    const bool body_valid = ( p.bodyCount() <= 3 );
+    const Vector2D body_unit = Vector2D::polar2vector( 1.0, p.body() );
+    const double turn_cos = 0.866; // cos( 30 )
+
+    const double inv_res = 1.0 / STEP_TABLE_RES;
+    const double offset_x = ( GRID_X - 1 ) * 0.5;
+    const double offset_y = ( GRID_Y - 1 ) * 0.5;
+
+    // cells farther than MAX_STEP are never updated
+    const double max_dist
+        = ( std::lower_bound( table.begin(), table.end(),
+                              static_cast< float >( MAX_STEP ) ) - table.begin() )
+        * STEP_TABLE_RES
+        + std::max( kickable, catchable );
+
+    const int min_ix = std::max( 0,
+                                 static_cast< int >( std::floor( ( start.x - max_dist )
+                                                                 / CELL_SIZE
+                                                                 + offset_x ) ) );
+    const int max_ix = std::min( GRID_X - 1,
+                                 static_cast< int >( std::ceil( ( start.x + max_dist )
+                                                                / CELL_SIZE
+                                                                + offset_x ) ) );
+    const int min_iy = std::max( 0,
+                                 static_cast< int >( std::floor( ( start.y - max_dist )
+                                                                 / CELL_SIZE
+                                                                 + offset_y ) ) );
+    const int max_iy = std::min( GRID_Y - 1,
+                                 static_cast< int >( std::ceil( ( start.y + max_dist )
+                                                                / CELL_SIZE
+                                                                + offset_y ) ) );
+
+    for ( int ix = min_ix; ix <= max_ix; ++ix )
+    {
+        const double x = ( ix - offset_x ) * CELL_SIZE;
+        const double dx = x - start.x;
+        const bool in_penalty_x = ( their
+                                    ? x > penalty_x
+                                    : x < penalty_x );
+
+        float * column = field + ix * GRID_Y;
+
+        for ( int iy = min_iy; iy <= max_iy; ++iy )
+        {
+            const double y = ( iy - offset_y ) * CELL_SIZE;
+            const double dy = y - start.y;
+            const double d = std::sqrt( dx * dx + dy * dy );
+
+            const double control = ( goalie
+                                     && in_penalty_x
+                                     && std::fabs( y ) < SP.penaltyAreaHalfWidth()
+                                     ? catchable
+                                     : kickable );
+            const double dist = d - control;
+
+            double step = 0.0;
+            if ( dist > 0.0 )
+            {
+                const double fi = dist * inv_res;
+                const int i = static_cast< int >( fi );
+                if ( i >= STEP_TABLE_SIZE - 1 )
+                {
+                    step = MAX_STEP;
+                }
+                else
+                {
+                    step = table[i] + ( table[i + 1] - table[i] ) * ( fi - i );
+                }
+
+                if ( ! body_valid
+                     || dx * body_unit.x + dy * body_unit.y < turn_cos * d )
+                {
+                    step += 1.0;
+                }
+            }
+
+            if ( step < column[iy] )
+            {
+                column[iy] = static_cast< float >( step );
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+ReachField::value( const float * field,
+                   const Vector2D & point ) const
+{
+    double fx = point.x / CELL_SIZE + ( GRID_X - 1 ) * 0.5;
+    double fy = point.y / CELL_SIZE + ( GRID_Y - 1 ) * 0.5;
+
+    fx = std::min( std::max( fx, 0.0 ), GRID_X - 1.0 );
+    fy = std::min( std::max( fy, 0.0 ), GRID_Y - 1.0 );
+
+    const int ix = std::min( static_cast< int >( fx ), GRID_X - 2 );
+    const int iy = std::min( static_cast< int >( fy ), GRID_Y - 2 );
+    const double rx = fx - ix;
+    const double ry = fy - iy;
+
+    const float * c0 = field + ix * GRID_Y + iy;
+    const float * c1 = c0 + GRID_Y;
+
+    return ( ( c0[0] * ( 1.0 - ry ) + c0[1] * ry ) * ( 1.0 - rx )
+             + ( c1[0] * ( 1.0 - ry ) + c1[1] * ry ) * rx );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+ReachField::interceptStep( const float * field,
+                           const Vector2D & ball_pos,
+                           const Vector2D & ball_vel,
+                           const int max_step ) const
+{
+    const double decay = ServerParam::i().ballDecay();
+    const int last = std::min( max_step, static_cast< int >( MAX_STEP ) );
+
+    Vector2D pos = ball_pos;
+    Vector2D vel = ball_vel;
+
+    for ( int n = 1; n <= last; ++n )
+    {
+        pos += vel;
+        vel *= decay;
+
+        if ( value( field, pos ) <= n )
+        {
+            return n;
+        }
+    }
+
+    return -1;
+}
+
+}
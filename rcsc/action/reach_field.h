@@ -0,0 +1,237 @@
+// -*-c++-*-
+
+/*!
+  \file reach_field.h
+  \brief per cycle player reach time field Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ACTION_REACH_FIELD_H
+#define RCSC_ACTION_REACH_FIELD_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+#include <vector>
+#include <utility>
+
+namespace rcsc {
+
+class AbstractPlayerObject;
+class PlayerType;
+class WorldModel;
+
+/*!
+  \class ReachField
+  \brief earliest arrival step of each team over the pitch.
+
+  The field is a grid that covers the pitch with a small margin. Each
+  cell holds the min estimated step for any player of the team to
+  control the ball at the cell center. The estimation uses the dash
+  distance table of each player type, the turn to the target, the
+  kickable (or catchable) area and the position accuracy.
+
+  The field is computed at most once per cycle. A point query is a
+  bilinear interpolation of four cells, and a ray query samples the
+  field once for each ball step.
+ */
+class ReachField {
+public:
+
+    //! the number of cells along the x axis
+    static const int GRID_X = 59;
+    //! the number of cells along the y axis
+    static const int GRID_Y = 39;
+    //! the length of the cell side
+    static const double CELL_SIZE;
+
+    //! the max step value stored in the field
+    static const double MAX_STEP;
+
+private:
+
+    //! dash distance resolution of the step table
+    static const double STEP_TABLE_RES;
+    //! the number of step table elements
+    static const int STEP_TABLE_SIZE = 600;
+
+    //! step table for each player type. index is the dash distance.
+    typedef std::pair< const PlayerType *, std::vector< float > > StepTable;
+
+    //! last updated time
+    GameTime M_time;
+
+    //! arrival steps of our team, including self
+    float M_our[GRID_X * GRID_Y];
+    //! arrival steps of their team
+    float M_their[GRID_X * GRID_Y];
+
+    //! time to build the field [msec]
+    double M_elapsed_msec;
+
+    //! cached step tables
+    std::vector< StepTable > M_step_tables;
+
+    /*!
+      \brief private for singleton
+     */
+    ReachField();
+
+    // not used
+    ReachField( const ReachField & );
+    ReachField & operator=( const ReachField & );
+
+public:
+
+    /*!
+      \brief get the field updated for the world model
+      \param wm const reference to the world model
+      \return const reference to the instance
+     */
+    static
+    const ReachField & get( const WorldModel & wm );
+
+    /*!
+      \brief get the earliest arrival step of our team
+      \param point global coordinate
+      \return estimated step
+     */
+    double ourStep( const Vector2D & point ) const
+      {
+          return value( M_our, point );
+      }
+
+    /*!
+      \brief get the earliest arrival step of their team
+      \param point global coordinate
+      \return estimated step
+     */
+    double theirStep( const Vector2D & point ) const
+      {
+          return value( M_their, point );
+      }
+
+    /*!
+      \brief get the dominance of our team at the point
+      \param point global coordinate
+      \return step difference. positive if our team arrives earlier.
+     */
+    double dominance( const Vector2D & point ) const
+      {
+          return theirStep( point ) - ourStep( point );
+      }
+
+    /*!
+      \brief get the first step when our team can intercept the moving ball
+      \param ball_pos ball first position
+      \param ball_vel ball first velocity
+      \param max_step the number of simulated steps
+      \return intercept step, or -1 if not found
+     */
+    int ourInterceptStep( const Vector2D & ball_pos,
+                          const Vector2D & ball_vel,
+                          const int max_step ) const
+      {
+          return interceptStep( M_our, ball_pos, ball_vel, max_step );
+      }
+
+    /*!
+      \brief get the first step when their team can intercept the moving ball
+      \param ball_pos ball first position
+      \param ball_vel ball first velocity
+      \param max_step the number of simulated steps
+      \return intercept step, or -1 if not found
+     */
+    int theirInterceptStep( const Vector2D & ball_pos,
+                            const Vector2D & ball_vel,
+                            const int max_step ) const
+      {
+          return interceptStep( M_their, ball_pos, ball_vel, max_step );
+      }
+
+    /*!
+      \brief get the time to build the field in the last update
+      \return milli second
+     */
+    double elapsedMSec() const
+      {
+          return M_elapsed_msec;
+      }
+
+private:
+
+    /*!
+      \brief recompute the field
+      \param wm const reference to the world model
+     */
+    void update( const WorldModel & wm );
+
+    /*!
+      \brief get the step table of the player type
+      \param ptype const reference to the player type
+      \return const reference to the table
+     */
+    const
+    std::vector< float > & stepTable( const PlayerType & ptype );
+
+    /*!
+      \brief merge the arrival steps of one player into the field
+      \param p const reference to the player
+      \param their true if the player is an opponent
+      \param field pointer to the field of the player's team
+     */
+    void addPlayer( const AbstractPlayerObject & p,
+                    const bool their,
+                    float * field );
+
+    /*!
+      \brief get the interpolated value
+      \param field pointer to the field
+      \param point global coordinate
+      \return interpolated step
+     */
+    double value( const float * field,
+                  const Vector2D & point ) const;
+
+    /*!
+      \brief simulate the ball and get the first reachable step
+      \param field pointer to the field
+      \param ball_pos ball first position
+      \param ball_vel ball first velocity
+      \param max_step the number of simulated steps
+      \return intercept step, or -1 if not found
+     */
+    int interceptStep( const float * field,
+                       const Vector2D & ball_pos,
+                       const Vector2D & ball_vel,
+                       const int max_step ) const;
+
+};
+
+}
+
+#endif
@@ -35,7 +35,7 @@
 
 #include "shoot_table.h"
 
-#include <rcsc/action/body_kick_one_step.h>
+#include <rcsc/action/kick_oracle.h>
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/player/interception.h>
@@ -137,11 +137,7 @@ ShootTable::calculateShotPoint( const WorldModel & wm,
 
     double shot_dist = shot_rel.r();
 
-    Vector2D one_step_vel
-        = Body_KickOneStep::get_max_possible_vel( shot_angle,
-                                                  wm.self().kickRate(),
-                                                  wm.ball().vel() );
-    double max_one_step_speed = one_step_vel.r();
+    double max_one_step_speed = KickOracle::get( wm ).maxSpeed( shot_angle );
 
     double shot_first_speed
         = ( shot_dist + 5.0 ) * ( 1.0 - ServerParam::i().ballDecay() );
@@ -35,6 +35,8 @@
 
 #include "view_synch.h"
 
+#include "perception_scheduler.h"
+
 #include <rcsc/player/player_agent.h>
 #include <rcsc/player/see_state.h>
 #include <rcsc/common/logger.h>
@@ -51,10 +53,7 @@ View_Synch::execute( PlayerAgent * agent )
 {
     if ( SeeState::synch_see_mode() )
     {
-        dlog.addText( Logger::ACTION,
-                      "%s:%d: change to narrow"
-                      ,__FILE__, __LINE__ );
-        return agent->doChangeView( ViewWidth::NARROW );
+        return doPlannedView( agent, ViewWidth::NARROW );
     }
 
     if ( ! agent->seeState().isSynch() )
@@ -76,20 +75,37 @@ View_Synch::execute( PlayerAgent * agent )
 
     if ( agent->seeState().lastTiming() == SeeState::TIME_0_00 )
     {
-        dlog.addText( Logger::ACTION,
-                      "%s:%d: change to normal"
-                      ,__FILE__, __LINE__ );
-        return agent->doChangeView( ViewWidth::NORMAL );
+        return doPlannedView( agent, ViewWidth::NORMAL );
     }
-    else
+
+    return doPlannedView( agent, ViewWidth::NARROW );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+View_Synch::doPlannedView( PlayerAgent * agent,
+                           const ViewWidth & default_width )
+{
+    const PerceptionScheduler::Candidate best
+        = PerceptionScheduler::instance().planJoint( agent, default_width );
+
+    if ( best.width_.type() == ViewWidth::ILLEGAL )
     {
         dlog.addText( Logger::ACTION,
-                      "%s:%d: change to narrow"
-                      ,__FILE__, __LINE__ );
-        return agent->doChangeView( ViewWidth::NARROW );
+                      "%s:%d: no planned view. change to %.0f"
+                      ,__FILE__, __LINE__,
+                      default_width.width() );
+        return agent->doChangeView( default_width );
     }
 
-    return false;
+    dlog.addText( Logger::ACTION,
+                  "%s:%d: change to planned view %.0f. face=%.0f score=%.3f"
+                  ,__FILE__, __LINE__,
+                  best.width_.width(), best.face_.degree(), best.score_ );
+    return agent->doChangeView( best.width_ );
 }
 
 /*-------------------------------------------------------------------*/
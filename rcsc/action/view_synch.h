@@ -33,6 +33,7 @@
 #define RCSC_ACTION_VIEW_SYNCH_H
 
 #include <rcsc/player/soccer_action.h>
+#include <rcsc/player/view_mode.h>
 
 namespace rcsc {
 
@@ -69,6 +70,15 @@ public:
 
 private:
     bool doTimerSynchView( PlayerAgent * agent );
+
+    /*!
+      \brief change view width to the one planned by PerceptionScheduler
+      \param agent pointer to the agent itself
+      \param default_width view width used if no plan is available
+      \return true if action is performed
+     */
+    bool doPlannedView( PlayerAgent * agent,
+                        const ViewWidth & default_width );
 };
 
 }
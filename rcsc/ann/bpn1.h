@@ -35,7 +35,6 @@
 #include <boost/array.hpp>
 
 #include <algorithm>
-#include <numeric> // inner_product
 #include <iostream>
 #include <cmath>
 
@@ -178,11 +177,8 @@ private:
     //! delta weight between hidden and output layer. bias weight is included.
     boost::array< value_type, HIDDEN + 1 > M_delta_weight_h_to_o[OUTPUT];
 
-    /*!
-      internal value holder.
-      last point value is used as bias input, so back value must be 1.
-    */
-    mutable boost::array< value_type, HIDDEN + 1 > M_hidden_layer;
+    //! typedef of the hidden layer values. the last element is the bias input.
+    typedef boost::array< value_type, HIDDEN + 1 > hidden_array;
 
 public:
     /*!
@@ -232,8 +228,6 @@ public:
      */
     void init()
       {
-          M_hidden_layer.assign( 0 );
-          M_hidden_layer.back() = 1;
           for ( std::size_t i = 0; i < HIDDEN; ++i )
           {
               M_weight_i_to_h[i].assign( 0 );
@@ -275,29 +269,8 @@ public:
     void propagate( const input_array & input,
                     output_array & output ) const
       {
-          // Input to Hidden
-          FuncH func_h;
-          for ( std::size_t i = 0; i < HIDDEN; ++i )
-          {
-              value_type sum = std::inner_product( input.begin(),
-                                                   input.end(),
-                                                   M_weight_i_to_h[i].begin(),
-                                                   static_cast< value_type >( 0 ) );
-              // add bias
-              sum += M_weight_i_to_h[i].back();
-              M_hidden_layer[i] = func_h( sum );
-          }
-          // Hidden to Output
-          FuncO func_o;
-          for ( std::size_t i = 0; i < OUTPUT; ++i )
-          {
-              value_type sum = std::inner_product( M_hidden_layer.begin(),
-                                                   M_hidden_layer.end(),
-                                                   M_weight_h_to_o[i].begin(),
-                                                   static_cast< value_type >( 0 ) );
-              // bias is already added
-              output[i] = func_o( sum );
-          }
+          hidden_array hidden;
+          propagate( input, hidden, output );
       }
 
     /*!
@@ -308,8 +281,9 @@ public:
     value_type train( const input_array & input,
                       const output_array & teacher )
       {
+          hidden_array hidden;
           output_array output;
-          propagate( input, output );
+          propagate( input, hidden, output );
 
           // error value mulitiplied by differential
           output_array output_back;
@@ -332,7 +306,7 @@ public:
               {
                   sum += output_back[j] * M_weight_h_to_o[j][i];
               }
-              hidden_back[i] = sum * func_h.diffAtY( M_hidden_layer[i] );
+              hidden_back[i] = sum * func_h.diffAtY( hidden[i] );
           }
 
           // update weights hidden to out
@@ -341,15 +315,14 @@ public:
               for ( std::size_t j = 0; j < HIDDEN + 1; ++j )
               {
                   M_delta_weight_h_to_o[i][j]
-                      = M_eta * M_hidden_layer[j] * output_back[i]
+                      = M_eta * hidden[j] * output_back[i]
                       + M_alpha * M_delta_weight_h_to_o[i][j];
                   M_weight_h_to_o[i][j]
                       += M_delta_weight_h_to_o[i][j];
-                  //+= M_epsilon * ( M_hidden_layer[i] * output_back[j] );
               }
           }
 
-          // update weights input to hidden
+          // update weights input to hidden. input layer bias is the last element.
           for ( std::size_t i = 0; i < HIDDEN; ++i )
           {
               for ( std::size_t j = 0; j < INPUT; ++j )
@@ -359,32 +332,26 @@ public:
                       + M_alpha * M_delta_weight_i_to_h[i][j];
                   M_weight_i_to_h[i][j]
                       += M_delta_weight_i_to_h[i][j];
-                  //+= M_epsilon * ( input[j] * hidden_back[i] );
               }
-          }
-          // update input layer bias
-          for ( std::size_t i = 0; i < HIDDEN; ++i )
-          {
               M_delta_weight_i_to_h[i][INPUT]
-                  = M_eta * 1.0 * hidden_back[i]
+                  = M_eta * hidden_back[i]
                   + M_alpha * M_delta_weight_i_to_h[i][INPUT];
               M_weight_i_to_h[i][INPUT]
                   += M_delta_weight_i_to_h[i][INPUT];
-              //+= M_epsilon * ( input[j] * hidden_back[i] );
           }
 
           // calcluate error after training
           value_type total_error = 0;
-          propagate( input, output );
+          propagate( input, hidden, output );
           for ( std::size_t i = 0; i < OUTPUT; ++i )
           {
-              total_error += std::pow( teacher[i] - output[i], 2.0 );
+              value_type err = teacher[i] - output[i];
+              total_error += err * err;
           }
           //std::cout << "  error = " << total_error << std::endl;
           return total_error;
       }
 
-
     ///////////////////////////////////////////////////
     // stream I/O
 
@@ -435,6 +402,52 @@ public:
           }
           return os;
       }
+
+private:
+
+    /*!
+      \brief simulate network and keep the hidden layer values.
+      \param input input data
+      \param hidden reference to the hidden layer values
+      \param output reference to the data holder variable
+
+      All loop counts are the template parameters, so the compiler can
+      unroll the loops for the small networks.
+    */
+    void propagate( const input_array & input,
+                    hidden_array & hidden,
+                    output_array & output ) const
+      {
+          // Input to Hidden
+          FuncH func_h;
+          for ( std::size_t i = 0; i < HIDDEN; ++i )
+          {
+              const value_type * w = M_weight_i_to_h[i].data();
+              value_type sum = 0;
+              for ( std::size_t j = 0; j < INPUT; ++j )
+              {
+                  sum += input[j] * w[j];
+              }
+              // add bias
+              sum += w[INPUT];
+              hidden[i] = func_h( sum );
+          }
+          hidden[HIDDEN] = 1;
+
+          // Hidden to Output
+          FuncO func_o;
+          for ( std::size_t i = 0; i < OUTPUT; ++i )
+          {
+              const value_type * w = M_weight_h_to_o[i].data();
+              value_type sum = 0;
+              // bias is the last element of the hidden layer
+              for ( std::size_t j = 0; j < HIDDEN + 1; ++j )
+              {
+                  sum += hidden[j] * w[j];
+              }
+              output[i] = func_o( sum );
+          }
+      }
 };
 
 }
@@ -43,6 +43,7 @@
 
 #include <rcsc/common/basic_client.h>
 #include <rcsc/common/logger.h>
+#include <rcsc/common/param_snapshot.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/player_type.h>
@@ -85,6 +86,9 @@ struct CoachAgentImpl {
     //! audio sensor
     CoachAudioSensor audio_;
 
+    //! binary cache of the server parameter messages
+    ParamSnapshot param_snapshot_;
+
     /*!
       \brief initialize all members
     */
@@ -277,6 +281,8 @@ CoachAgent::initImpl( CmdLineParser & cmd_parser )
     // analyze command line for coach options
     cmd_parser.parse( coach_param_map );
 
+    M_impl->param_snapshot_.open( config().paramSnapshot() );
+
     //if ( ! cmd_parser.invalidOptions().empty() )
     //{
     //    std::cerr << "coach: ***WARNING*** detected invalid options: ";
@@ -871,9 +877,7 @@ CoachAgent::analyzeChangePlayerType( const char * msg )
 void
 CoachAgent::analyzePlayerType( const char * msg )
 {
-    PlayerType player_type( ServerParam::i(),
-                            msg, config().version() );
-    PlayerTypeSet::instance().insert( player_type );
+    M_impl->param_snapshot_.parsePlayerType( msg, config().version() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -883,7 +887,7 @@ CoachAgent::analyzePlayerType( const char * msg )
 void
 CoachAgent::analyzePlayerParam( const char * msg )
 {
-    PlayerParam::instance().parse( msg, config().version() );
+    M_impl->param_snapshot_.parsePlayerParam( msg, config().version() );
     //PlayerParam::i().print( std::cout );
 }
 
@@ -894,7 +898,7 @@ CoachAgent::analyzePlayerParam( const char * msg )
 void
 CoachAgent::analyzeServerParam( const char * msg )
 {
-    ServerParam::instance().parse( msg, config().version() );
+    M_impl->param_snapshot_.parseServerParam( msg, config().version() );
     PlayerTypeSet::instance().resetDefaultType( ServerParam::i() );
 
     M_worldmodel.initFreeformCount();
@@ -94,6 +94,8 @@ CoachConfig::setDefaultParam()
 
     M_max_team_graphic_per_cycle = 32;
 
+    M_param_snapshot = "";
+
     //
     // debug
     //
@@ -151,6 +153,8 @@ CoachConfig::createParamMap( ParamMap & param_map )
         ( "use_team_graphic", "", &M_use_team_graphic )
         ( "max_team_graphic_per_cycle", "", &M_max_team_graphic_per_cycle )
 
+        ( "param_snapshot", "", &M_param_snapshot )
+
         ( "log_dir", "", &M_log_dir )
         ( "log_ext", "", &M_log_ext )
 
@@ -90,6 +90,9 @@ private:
     //! maximum number of team_graphic command per cycle
     int M_max_team_graphic_per_cycle;
 
+    //! binary snapshot file of the server parameters. if empty, not used.
+    std::string M_param_snapshot;
+
     //
     // debug
     //
@@ -231,6 +234,12 @@ public:
           return M_max_team_graphic_per_cycle;
       }
 
+    const
+    std::string & paramSnapshot() const
+      {
+          return M_param_snapshot;
+      }
+
 
     const
     std::string & logDir() const
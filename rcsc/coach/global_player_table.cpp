@@ -0,0 +1,137 @@
+// -*-c++-*-
+
+/*!
+  \file global_player_table.cpp
+  \brief fixed size player state table with history Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "global_player_table.h"
+
+#include "global_object.h"
+
+#include <algorithm>
+
+namespace rcsc {
+
+const int GlobalPlayerTable::MAX_SLOT;
+const int GlobalPlayerTable::HISTORY_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+GlobalPlayerTable::Frame::Frame()
+    : time_( -1, 0 )
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GlobalPlayerTable::Frame::clear()
+{
+    std::fill( valid_, valid_ + MAX_SLOT, false );
+    std::fill( pos_x_, pos_x_ + MAX_SLOT, 0.0 );
+    std::fill( pos_y_, pos_y_ + MAX_SLOT, 0.0 );
+    std::fill( vel_x_, vel_x_ + MAX_SLOT, 0.0 );
+    std::fill( vel_y_, vel_y_ + MAX_SLOT, 0.0 );
+    std::fill( body_, body_ + MAX_SLOT, 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+GlobalPlayerTable::GlobalPlayerTable()
+    : M_latest( 0 )
+    , M_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GlobalPlayerTable::clear()
+{
+    for ( int i = 0; i < HISTORY_SIZE; ++i )
+    {
+        M_frames[i].time_.assign( -1, 0 );
+        M_frames[i].clear();
+    }
+
+    M_latest = 0;
+    M_size = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GlobalPlayerTable::update( const GameTime & time,
+                           const std::vector< GlobalPlayerObject > & players )
+{
+    if ( M_size == 0
+         || M_frames[M_latest].time_ != time )
+    {
+        M_latest = ( M_latest + 1 ) % HISTORY_SIZE;
+        M_size = std::min( M_size + 1, static_cast< int >( HISTORY_SIZE ) );
+    }
+
+    Frame & f = M_frames[M_latest];
+
+    f.time_ = time;
+    f.clear();
+
+    const std::vector< GlobalPlayerObject >::const_iterator end = players.end();
+    for ( std::vector< GlobalPlayerObject >::const_iterator p = players.begin();
+          p != end;
+          ++p )
+    {
+        const int i = slot( p->side(), p->unum() );
+        if ( i < 0 ) continue;
+
+        f.valid_[i] = true;
+        f.pos_x_[i] = p->pos().x;
+        f.pos_y_[i] = p->pos().y;
+        f.vel_x_[i] = p->vel().x;
+        f.vel_y_[i] = p->vel().y;
+        f.body_[i] = p->body().degree();
+    }
+}
+
+}
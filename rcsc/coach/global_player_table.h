@@ -0,0 +1,173 @@
+// -*-c++-*-
+
+/*!
+  \file global_player_table.h
+  \brief fixed size player state table with history Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COACH_GLOBAL_PLAYER_TABLE_H
+#define RCSC_COACH_GLOBAL_PLAYER_TABLE_H
+
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <vector>
+
+namespace rcsc {
+
+class GlobalPlayerObject;
+
+/*!
+  \class GlobalPlayerTable
+  \brief player states of the last several see_global messages.
+
+  Each frame stores all players in the fixed 22 slots as separate
+  arrays of each state element, so that the analyzer can check all
+  players by simple loops over contiguous arrays. The slot of the left
+  team player is [0,10], and the slot of the right team player is
+  [11,21]. Frames are kept in a ring buffer.
+ */
+class GlobalPlayerTable {
+public:
+
+    //! the number of player slots
+    static const int MAX_SLOT = 22;
+
+    //! the number of stored frames
+    static const int HISTORY_SIZE = 8;
+
+    /*!
+      \struct Frame
+      \brief player states at one cycle
+     */
+    struct Frame {
+        GameTime time_; //!< see_global time
+        bool valid_[MAX_SLOT]; //!< true if the player is seen
+        double pos_x_[MAX_SLOT]; //!< position x
+        double pos_y_[MAX_SLOT]; //!< position y
+        double vel_x_[MAX_SLOT]; //!< velocity x
+        double vel_y_[MAX_SLOT]; //!< velocity y
+        double body_[MAX_SLOT]; //!< body angle in degree
+
+        /*!
+          \brief create an empty frame
+         */
+        Frame();
+
+        /*!
+          \brief invalidate all slots
+         */
+        void clear();
+    };
+
+private:
+
+    //! frame ring buffer
+    Frame M_frames[HISTORY_SIZE];
+
+    //! index of the latest frame
+    int M_latest;
+
+    //! the number of stored frames
+    int M_size;
+
+public:
+
+    /*!
+      \brief create an empty table
+     */
+    GlobalPlayerTable();
+
+    /*!
+      \brief get the slot index of the specified player
+      \param side player's side
+      \param unum player's uniform number
+      \return slot index, or -1 if illegal player is given.
+     */
+    static
+    int slot( const SideID side,
+              const int unum )
+      {
+          if ( unum < 1 || 11 < unum ) return -1;
+          if ( side == LEFT ) return unum - 1;
+          if ( side == RIGHT ) return unum + 10;
+          return -1;
+      }
+
+    /*!
+      \brief get the first slot index of the team
+      \param side team side
+      \return 0 for the left team, 11 for the right team
+     */
+    static
+    int first_slot( const SideID side )
+      {
+          return ( side == RIGHT ? 11 : 0 );
+      }
+
+    /*!
+      \brief remove all frames
+     */
+    void clear();
+
+    /*!
+      \brief store the new player states.
+      \param time see_global time
+      \param players seen players
+
+      If the time is same as the latest frame, the latest frame is
+      overwritten.
+     */
+    void update( const GameTime & time,
+                 const std::vector< GlobalPlayerObject > & players );
+
+    /*!
+      \brief get the number of stored frames
+      \return the number of stored frames
+     */
+    int size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief get the stored frame
+      \param age 0 means the latest frame, 1 means the previous frame.
+      the value must be less than size().
+      \return const reference to the frame
+     */
+    const
+    Frame & frame( const int age = 0 ) const
+      {
+          return M_frames[( M_latest - age + HISTORY_SIZE ) % HISTORY_SIZE];
+      }
+
+};
+
+}
+
+#endif
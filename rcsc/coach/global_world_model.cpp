@@ -336,6 +336,8 @@ GlobalWorldModel::updateAfterSeeGlobal( const GlobalVisualSensor & see_global,
     M_players.clear();
     M_players.splice( M_players.end(), new_players );
 
+    M_player_table.update( current, see_global.players() );
+
     //
     // update the vector of player's pointer
     //
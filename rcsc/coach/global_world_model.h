@@ -33,6 +33,7 @@
 #define RCSC_COACH_GLOBAL_WORLD_MODEL_H
 
 #include <rcsc/coach/global_object.h>
+#include <rcsc/coach/global_player_table.h>
 #include <rcsc/coach/player_type_analyzer.h>
 #include <rcsc/game_mode.h>
 #include <rcsc/game_time.h>
@@ -92,6 +93,9 @@ private:
     //! the container of player's pointer for the right team
     std::vector< const GlobalPlayerObject * > M_players_right;
 
+    //! player states of the recent cycles in the fixed slots
+    GlobalPlayerTable M_player_table;
+
     //
     // player type management
     //
@@ -330,6 +334,16 @@ public:
           return M_players;
       }
 
+    /*!
+      \brief get the player state table with history
+      \return const reference to the table
+     */
+    const
+    GlobalPlayerTable & playerTable() const
+      {
+          return M_player_table;
+      }
+
     /*!
       \brief get left players' pointer
       \return const reference to the data container
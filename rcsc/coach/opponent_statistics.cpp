@@ -0,0 +1,456 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_statistics.cpp
+  \brief incremental opponent team statistics Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "opponent_statistics.h"
+
+#include "global_world_model.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/game_mode.h>
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+namespace rcsc {
+
+const int OpponentStatistics::SPEED_BINS;
+const double OpponentStatistics::SPEED_BIN_WIDTH = 0.1;
+const int OpponentStatistics::LINE_BINS;
+const double OpponentStatistics::LINE_BIN_WIDTH = 4.5;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+OpponentStatistics::Player::Player()
+    : count_( 0 )
+    , sum_pos_( 0.0, 0.0 )
+    , sum_pos2_( 0.0, 0.0 )
+    , sum_speed_( 0.0 )
+    , max_speed_( 0.0 )
+{
+    std::fill( speed_hist_, speed_hist_ + SPEED_BINS, 0L );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+OpponentStatistics::Player::meanPos() const
+{
+    if ( count_ <= 0 )
+    {
+        return Vector2D( 0.0, 0.0 );
+    }
+
+    return sum_pos_ / static_cast< double >( count_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+OpponentStatistics::Player::stddevPos() const
+{
+    if ( count_ <= 0 )
+    {
+        return Vector2D( 0.0, 0.0 );
+    }
+
+    const Vector2D mean = meanPos();
+    const double n = static_cast< double >( count_ );
+    return Vector2D( std::sqrt( std::max( 0.0, sum_pos2_.x / n - mean.x * mean.x ) ),
+                     std::sqrt( std::max( 0.0, sum_pos2_.y / n - mean.y * mean.y ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+OpponentStatistics::Player::meanSpeed() const
+{
+    if ( count_ <= 0 )
+    {
+        return 0.0;
+    }
+
+    return sum_speed_ / static_cast< double >( count_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+OpponentStatistics::OpponentStatistics()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+OpponentStatistics::clear()
+{
+    M_updated_time.assign( -1, 0 );
+    M_count = 0;
+    M_sum_centroid.assign( 0.0, 0.0 );
+
+    for ( int i = 0; i < 11; ++i )
+    {
+        M_players[i] = Player();
+        std::fill( M_pass_count[i], M_pass_count[i] + 11, 0L );
+    }
+
+    M_last_holder = -1;
+
+    M_line_count = 0;
+    M_sum_line = 0.0;
+    M_sum_line2 = 0.0;
+    std::fill( M_line_hist, M_line_hist + LINE_BINS, 0L );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+OpponentStatistics::update( const GlobalWorldModel & world )
+{
+    if ( M_updated_time == world.time() )
+    {
+        return;
+    }
+    M_updated_time = world.time();
+
+    if ( world.gameMode().type() != GameMode::PlayOn
+         || world.playerTable().size() == 0 )
+    {
+        M_last_holder = -1;
+        return;
+    }
+
+    const GlobalPlayerTable::Frame & cur = world.playerTable().frame( 0 );
+    const int opp = GlobalPlayerTable::first_slot( world.theirSide() );
+    const double reverse = ( world.ourSide() == RIGHT ? -1.0 : 1.0 );
+
+    //
+    // player positions and speed profiles
+    //
+
+    Vector2D centroid( 0.0, 0.0 );
+    int n = 0;
+    double first_x = -1000.0;
+    double second_x = -1000.0;
+
+    for ( int i = 0; i < 11; ++i )
+    {
+        const int o = opp + i;
+        if ( ! cur.valid_[o] ) continue;
+
+        const double x = cur.pos_x_[o] * reverse;
+        const double y = cur.pos_y_[o] * reverse;
+        const double speed = std::sqrt( cur.vel_x_[o] * cur.vel_x_[o]
+                                        + cur.vel_y_[o] * cur.vel_y_[o] );
+
+        Player & p = M_players[i];
+        ++p.count_;
+        p.sum_pos_.x += x;
+        p.sum_pos_.y += y;
+        p.sum_pos2_.x += x * x;
+        p.sum_pos2_.y += y * y;
+        p.sum_speed_ += speed;
+        p.max_speed_ = std::max( p.max_speed_, speed );
+        p.speed_hist_[ std::min( static_cast< int >( speed / SPEED_BIN_WIDTH ),
+                                 SPEED_BINS - 1 ) ] += 1;
+
+        centroid.x += x;
+        centroid.y += y;
+        ++n;
+
+        // their goal is at the positive x side
+        if ( x > first_x )
+        {
+            second_x = first_x;
+            first_x = x;
+        }
+        else if ( x > second_x )
+        {
+            second_x = x;
+        }
+    }
+
+    if ( n == 0 )
+    {
+        return;
+    }
+
+    ++M_count;
+    M_sum_centroid += centroid / static_cast< double >( n );
+
+    //
+    // defense line
+    //
+
+    if ( n >= 2 )
+    {
+        ++M_line_count;
+        M_sum_line += second_x;
+        M_sum_line2 += second_x * second_x;
+        M_line_hist[ std::min( std::max( 0,
+                                         static_cast< int >( second_x / LINE_BIN_WIDTH ) ),
+                               LINE_BINS - 1 ) ] += 1;
+    }
+
+    //
+    // pass graph
+    //
+
+    updatePass( world );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+OpponentStatistics::updatePass( const GlobalWorldModel & world )
+{
+    const GlobalPlayerTable::Frame & cur = world.playerTable().frame( 0 );
+    const double ball_x = world.ball().pos().x;
+    const double ball_y = world.ball().pos().y;
+
+    // find the nearest player to the ball
+    int nearest = -1;
+    double min_dist2 = 1.0e10;
+    for ( int i = 0; i < GlobalPlayerTable::MAX_SLOT; ++i )
+    {
+        const double dx = cur.pos_x_[i] - ball_x;
+        const double dy = cur.pos_y_[i] - ball_y;
+        const double d2 = dx * dx + dy * dy;
+        if ( cur.valid_[i]
+             && d2 < min_dist2 )
+        {
+            min_dist2 = d2;
+            nearest = i;
+        }
+    }
+
+    if ( nearest < 0 )
+    {
+        return;
+    }
+
+    const SideID side = ( nearest < 11 ? LEFT : RIGHT );
+    const int unum = nearest % 11 + 1;
+
+    const PlayerType * ptype = PlayerTypeSet::i().get( world.heteroID( side, unum ) );
+    const double kickable_area = ( ptype
+                                   ? ptype->kickableArea()
+                                   : ServerParam::i().defaultKickableArea() );
+
+    if ( min_dist2 > kickable_area * kickable_area )
+    {
+        // ball is free
+        return;
+    }
+
+    if ( side != world.theirSide() )
+    {
+        // our team player has the ball
+        M_last_holder = -1;
+        return;
+    }
+
+    const int holder = unum - 1;
+    if ( M_last_holder >= 0
+         && M_last_holder != holder )
+    {
+        M_pass_count[M_last_holder][holder] += 1;
+    }
+
+    M_last_holder = holder;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+long
+OpponentStatistics::passCount( const int sender,
+                               const int receiver ) const
+{
+    if ( sender < 1 || 11 < sender
+         || receiver < 1 || 11 < receiver )
+    {
+        return 0;
+    }
+
+    return M_pass_count[sender - 1][receiver - 1];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+OpponentStatistics::stddevDefenseLine() const
+{
+    if ( M_line_count <= 0 )
+    {
+        return 0.0;
+    }
+
+    const double mean = meanDefenseLine();
+    return std::sqrt( std::max( 0.0,
+                                M_sum_line2 / static_cast< double >( M_line_count )
+                                - mean * mean ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+OpponentStatistics::makeSummary( const std::size_t max_length,
+                                 std::string & msg ) const
+{
+    msg.clear();
+
+    if ( M_count == 0 )
+    {
+        return false;
+    }
+
+    char buf[64];
+
+    const Vector2D centroid = meanCentroid();
+    std::snprintf( buf, 64, "(opp_stat (line %.1f %.1f) (centroid %.1f %.1f)",
+                   meanDefenseLine(), stddevDefenseLine(),
+                   centroid.x, centroid.y );
+    msg = buf;
+
+    // keep the space for " (speed )" and " (pass ))"
+    const std::size_t closing = 18;
+    if ( msg.length() + closing > max_length )
+    {
+        msg.clear();
+        return false;
+    }
+
+    //
+    // players sorted by the max speed
+    //
+
+    std::vector< std::pair< double, int > > speeds;
+    speeds.reserve( 11 );
+    for ( int i = 0; i < 11; ++i )
+    {
+        if ( M_players[i].count_ > 0 )
+        {
+            speeds.push_back( std::make_pair( M_players[i].max_speed_, i + 1 ) );
+        }
+    }
+    std::sort( speeds.begin(), speeds.end(),
+               std::greater< std::pair< double, int > >() );
+
+    std::string list;
+    for ( std::vector< std::pair< double, int > >::const_iterator it = speeds.begin();
+          it != speeds.end();
+          ++it )
+    {
+        std::snprintf( buf, 64, "(%d %.2f)", it->second, it->first );
+        if ( msg.length() + list.length() + std::strlen( buf ) + closing
+             > max_length )
+        {
+            break;
+        }
+        list += buf;
+    }
+
+    msg += " (speed ";
+    msg += list;
+    msg += ')';
+
+    //
+    // pass edges sorted by the count
+    //
+
+    std::vector< std::pair< long, int > > passes;
+    for ( int s = 0; s < 11; ++s )
+    {
+        for ( int r = 0; r < 11; ++r )
+        {
+            if ( M_pass_count[s][r] > 0 )
+            {
+                passes.push_back( std::make_pair( M_pass_count[s][r], s * 11 + r ) );
+            }
+        }
+    }
+    std::sort( passes.begin(), passes.end(),
+               std::greater< std::pair< long, int > >() );
+
+    list.clear();
+    for ( std::vector< std::pair< long, int > >::const_iterator it = passes.begin();
+          it != passes.end();
+          ++it )
+    {
+        std::snprintf( buf, 64, "(%d %d %ld)",
+                       it->second / 11 + 1, it->second % 11 + 1, it->first );
+        if ( msg.length() + list.length() + std::strlen( buf ) + 9
+             > max_length )
+        {
+            break;
+        }
+        list += buf;
+    }
+
+    msg += " (pass ";
+    msg += list;
+    msg += "))";
+
+    return true;
+}
+
+}
@@ -0,0 +1,251 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_statistics.h
+  \brief incremental opponent team statistics Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COACH_OPPONENT_STATISTICS_H
+#define RCSC_COACH_OPPONENT_STATISTICS_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+#include <algorithm>
+#include <string>
+
+namespace rcsc {
+
+class GlobalWorldModel;
+
+/*!
+  \class OpponentStatistics
+  \brief incremental statistics of the opponent team play.
+
+  All statistics are updated by the running sums over the play_on
+  cycles, so the memory size is fixed and the cost of one update is
+  proportional to the number of players.
+
+  Coordinates are converted so that our team always attacks to the
+  positive x direction.
+ */
+class OpponentStatistics {
+public:
+
+    //! the number of speed histogram bins
+    static const int SPEED_BINS = 12;
+    //! the width of a speed histogram bin
+    static const double SPEED_BIN_WIDTH;
+
+    //! the number of defense line histogram bins
+    static const int LINE_BINS = 12;
+    //! the width of a defense line histogram bin
+    static const double LINE_BIN_WIDTH;
+
+    /*!
+      \struct Player
+      \brief statistics of one opponent player
+     */
+    struct Player {
+        long count_; //!< the number of samples
+        Vector2D sum_pos_; //!< sum of the positions
+        Vector2D sum_pos2_; //!< sum of the squared position elements
+        double sum_speed_; //!< sum of the speed
+        double max_speed_; //!< maximal observed speed
+        long speed_hist_[SPEED_BINS]; //!< speed histogram
+
+        /*!
+          \brief clear all values
+         */
+        Player();
+
+        /*!
+          \brief get the mean position
+          \return mean position. if no sample, (0,0) is returned.
+         */
+        Vector2D meanPos() const;
+
+        /*!
+          \brief get the standard deviation of the position
+          \return (sd of x, sd of y)
+         */
+        Vector2D stddevPos() const;
+
+        /*!
+          \brief get the mean speed
+          \return mean speed
+         */
+        double meanSpeed() const;
+    };
+
+private:
+
+    //! last updated time
+    GameTime M_updated_time;
+
+    //! the number of analyzed cycles
+    long M_count;
+
+    //! sum of the team centroid
+    Vector2D M_sum_centroid;
+
+    //! player statistics
+    Player M_players[11];
+
+    //! pass graph. [sender][receiver]
+    long M_pass_count[11][11];
+
+    //! index of the last opponent ball holder, or -1
+    int M_last_holder;
+
+    //! the number of defense line samples
+    long M_line_count;
+    //! sum of the defense line
+    double M_sum_line;
+    //! sum of the squared defense line
+    double M_sum_line2;
+    //! defense line histogram
+    long M_line_hist[LINE_BINS];
+
+public:
+
+    /*!
+      \brief clear all statistics
+     */
+    OpponentStatistics();
+
+    /*!
+      \brief clear all statistics
+     */
+    void clear();
+
+    /*!
+      \brief add the current state in the world model
+      \param world const reference to the world model
+
+      Only play_on cycles are analyzed. Nothing is done if the world
+      model has already been analyzed at the current time.
+     */
+    void update( const GlobalWorldModel & world );
+
+    /*!
+      \brief get the number of analyzed cycles
+      \return cycle count
+     */
+    long count() const
+      {
+          return M_count;
+      }
+
+    /*!
+      \brief get the mean of the team centroid
+      \return mean centroid
+     */
+    Vector2D meanCentroid() const
+      {
+          return ( M_count > 0
+                   ? M_sum_centroid / static_cast< double >( M_count )
+                   : Vector2D( 0.0, 0.0 ) );
+      }
+
+    /*!
+      \brief get the player statistics
+      \param unum uniform number [1,11]
+      \return const reference to the statistics
+     */
+    const
+    Player & player( const int unum ) const
+      {
+          return M_players[ std::min( std::max( unum, 1 ), 11 ) - 1 ];
+      }
+
+    /*!
+      \brief get the number of detected passes
+      \param sender sender's uniform number [1,11]
+      \param receiver receiver's uniform number [1,11]
+      \return pass count
+     */
+    long passCount( const int sender,
+                    const int receiver ) const;
+
+    /*!
+      \brief get the mean defense line
+      \return mean x coordinate of the defense line
+     */
+    double meanDefenseLine() const
+      {
+          return ( M_line_count > 0
+                   ? M_sum_line / static_cast< double >( M_line_count )
+                   : 0.0 );
+      }
+
+    /*!
+      \brief get the standard deviation of the defense line
+      \return standard deviation
+     */
+    double stddevDefenseLine() const;
+
+    /*!
+      \brief get the defense line histogram
+      \return pointer to the array of LINE_BINS elements.
+      bin i counts lines in [i * LINE_BIN_WIDTH, (i + 1) * LINE_BIN_WIDTH).
+     */
+    const
+    long * defenseLineHistogram() const
+      {
+          return M_line_hist;
+      }
+
+    /*!
+      \brief create the summary message for the freeform message
+      \param max_length the maximal message length
+      \param msg reference to the result string
+      \return true if the message is created.
+
+      format:
+      "(opp_stat (line <mean> <sd>) (centroid <x> <y>)
+      (speed (<unum> <max_speed>)...) (pass (<sender> <receiver> <count>)...))"
+
+      speed and pass lists are sorted by the value, and are truncated
+      at max_length.
+     */
+    bool makeSummary( const std::size_t max_length,
+                      std::string & msg ) const;
+
+private:
+
+    /*!
+      \brief update the pass graph by the ball holder
+      \param world const reference to the world model
+     */
+    void updatePass( const GlobalWorldModel & world );
+
+};
+
+}
+
+#endif
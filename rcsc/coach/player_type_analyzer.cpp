@@ -54,9 +54,6 @@ PlayerTypeAnalyzer::Data::Data()
     , maybe_referee_( false )
     , maybe_collide_( false )
     , maybe_kick_( false )
-    , pos_( Vector2D::INVALIDATED )
-    , vel_( 0.0, 0.0 )
-    , body_( -360 )
     , invalid_flags_( PlayerParam::i().playerTypes(), 0 )
     , type_( Hetero_Default )
 {
@@ -208,51 +205,8 @@ PlayerTypeAnalyzer::reset( const int unum )
 void
 PlayerTypeAnalyzer::updateLastData()
 {
+    // player states are kept by GlobalPlayerTable
     M_prev_ball = M_world.ball();
-
-    const std::vector< const GlobalPlayerObject * > & teammates
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersLeft()
-            : M_world.playersRight() );
-    const std::vector< const GlobalPlayerObject * > & opponents
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersRight()
-            : M_world.playersLeft() );
-
-
-    const std::vector< const GlobalPlayerObject * >::const_iterator tend
-            = teammates.end();
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = teammates.begin();
-          p != tend;
-          ++p )
-    {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_teammate_data[(*p)->unum() - 1];
-
-        data.pos_ = (*p)->pos();
-        data.vel_ = (*p)->vel();
-        data.body_ = (*p)->body().degree();
-    }
-
-
-    const std::vector< const GlobalPlayerObject * >::const_iterator oend
-            = opponents.end();
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = opponents.begin();
-          p != oend;
-          ++p )
-    {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
-
-        data.pos_ = (*p)->pos();
-        data.vel_ = (*p)->vel();
-        data.body_ = (*p)->body().degree();
-    }
-
 }
 
 /*-------------------------------------------------------------------*/
@@ -355,59 +309,24 @@ PlayerTypeAnalyzer::analyze()
 void
 PlayerTypeAnalyzer::checkTurn()
 {
-    for ( int i = 0; i < 11 ; ++i )
-    {
-        M_teammate_data[i].turned_ = false;
-        M_opponent_data[i].turned_ = false;
-    }
+    const GlobalPlayerTable::Frame & cur = M_world.playerTable().frame( 0 );
+    const GlobalPlayerTable::Frame & prev = M_world.playerTable().frame( 1 );
 
-    const std::vector< const GlobalPlayerObject * > & teammates
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersLeft()
-            : M_world.playersRight() );
-    const std::vector< const GlobalPlayerObject * > & opponents
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersRight()
-            : M_world.playersLeft() );
+    const int opp = ( M_world.ourSide() == LEFT ? 11 : 0 );
+    const int mate = 11 - opp;
 
-
-    const std::vector< const GlobalPlayerObject * >::const_iterator tend
-            = teammates.end();
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = teammates.begin();
-          p != tend;
-          ++p )
-    {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_teammate_data[(*p)->unum() - 1];
-
-        if ( data.body_ != -360.0
-             && std::fabs( data.body_ - (*p)->body().degree() ) > 0.5 )
-        {
-            data.turned_ = true;
-        }
-    }
-
-
-    const std::vector< const GlobalPlayerObject * >::const_iterator oend
-            = opponents.end();
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = opponents.begin();
-          p != oend;
-          ++p )
+    for ( int i = 0; i < 11; ++i )
     {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
-
-        if ( data.body_ != -360.0
-             && std::fabs( data.body_ - (*p)->body().degree() ) > 0.5 )
-        {
-            data.turned_ = true;
-        }
+        const int t = mate + i;
+        M_teammate_data[i].turned_ = ( prev.valid_[t]
+                                       && cur.valid_[t]
+                                       && std::fabs( prev.body_[t] - cur.body_[t] ) > 0.5 );
+
+        const int o = opp + i;
+        M_opponent_data[i].turned_ = ( prev.valid_[o]
+                                       && cur.valid_[o]
+                                       && std::fabs( prev.body_[o] - cur.body_[o] ) > 0.5 );
     }
-
 }
 
 /*-------------------------------------------------------------------*/
@@ -417,11 +336,6 @@ PlayerTypeAnalyzer::checkTurn()
 void
 PlayerTypeAnalyzer::checkReferee()
 {
-    for ( int i = 0; i < 11; ++i )
-    {
-        M_opponent_data[i].maybe_referee_ = false;
-    }
-
     const double penalty_x
         = ServerParam::i().pitchHalfLength()
         - ServerParam::i().penaltyAreaLength()
@@ -429,42 +343,38 @@ PlayerTypeAnalyzer::checkReferee()
     const double penalty_y
         = ServerParam::i().penaltyAreaWidth() * 0.5
         + 2.0;
+    const double field_x = ServerParam::i().pitchHalfLength() + 3.0;
+    const double field_y = ServerParam::i().pitchHalfWidth() + 3.0;
 
     const bool our_set_play = M_world.gameMode().isOurSetPlay( M_world.ourSide() );
+    const bool goal_kick = ( M_world.gameMode().type() == GameMode::GoalKick_ );
+    const double ball_x = M_world.ball().pos().x;
+    const double ball_y = M_world.ball().pos().y;
 
-    const std::vector< const GlobalPlayerObject * > & players
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersRight()
-            : M_world.playersLeft() );
+    const GlobalPlayerTable::Frame & cur = M_world.playerTable().frame( 0 );
+    const int opp = ( M_world.ourSide() == LEFT ? 11 : 0 );
 
-    const std::vector< const GlobalPlayerObject * >::const_iterator end = players.end();
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p = players.begin();
-          p != end;
-          ++p )
+    for ( int i = 0; i < 11; ++i )
     {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
+        const int o = opp + i;
+        const double abs_x = std::fabs( cur.pos_x_[o] );
+        const double abs_y = std::fabs( cur.pos_y_[o] );
+        const double dx = cur.pos_x_[o] - ball_x;
+        const double dy = cur.pos_y_[o] - ball_y;
 
         // player may be moved by referee
-        if ( our_set_play )
-        {
-            if ( (*p)->pos().dist2( M_world.ball().pos() ) < 12.0 * 12.0
-                 || ( M_world.gameMode().type() == GameMode::GoalKick_
-                      && (*p)->pos().absX() > penalty_x
-                      && (*p)->pos().absY() < penalty_y )
-                 )
-            {
-                data.maybe_referee_ = true;
-            }
-        }
-
+        const bool moved_by_referee
+            = ( our_set_play
+                && ( dx * dx + dy * dy < 12.0 * 12.0
+                     || ( goal_kick
+                          && abs_x > penalty_x
+                          && abs_y < penalty_y ) ) );
         // player may be moved by simulator
-        if ( (*p)->pos().absX() > ServerParam::i().pitchHalfLength() + 3.0
-             || (*p)->pos().absY() > ServerParam::i().pitchHalfWidth() + 3.0 )
-        {
-            data.maybe_referee_ = true;
-        }
+        const bool moved_by_simulator = ( abs_x > field_x || abs_y > field_y );
+
+        M_opponent_data[i].maybe_referee_ = ( cur.valid_[o]
+                                              && ( moved_by_referee
+                                                   || moved_by_simulator ) );
     }
 }
 
@@ -475,11 +385,6 @@ PlayerTypeAnalyzer::checkReferee()
 void
 PlayerTypeAnalyzer::checkCollisions()
 {
-    for ( int i = 0; i < 11; ++i )
-    {
-        M_opponent_data[i].maybe_collide_ = false;
-    }
-
     const double ball_collide_dist2
         = std::pow( ServerParam::i().defaultPlayerSize()
                     + ServerParam::i().ballSize()
@@ -487,122 +392,79 @@ PlayerTypeAnalyzer::checkCollisions()
                     2.0 );
     const double player_collide_dist2
         = std::pow( ServerParam::i().defaultPlayerSize() * 2.0 + 0.02, 2.0 );
-    const Vector2D pole_pos( ServerParam::i().pitchHalfLength()
-                             - ServerParam::i().goalPostRadius(),
-                             ServerParam::i().goalHalfWidth()
-                             + ServerParam::i().goalPostRadius() );
+    const double pole_x = ( ServerParam::i().pitchHalfLength()
+                            - ServerParam::i().goalPostRadius() );
+    const double pole_y = ( ServerParam::i().goalHalfWidth()
+                            + ServerParam::i().goalPostRadius() );
     const double pole_collide_dist2
         = std::pow( ServerParam::i().defaultPlayerSize()
                     + ServerParam::i().goalPostRadius()
                     + 2.0,
                     2.0 );
 
+    const double ball_x = M_world.ball().pos().x;
+    const double ball_y = M_world.ball().pos().y;
 
-    const std::list< GlobalPlayerObject >::const_iterator all_end
-        = M_world.players().end();
+    const GlobalPlayerTable::Frame & cur = M_world.playerTable().frame( 0 );
+    const int opp = ( M_world.ourSide() == LEFT ? 11 : 0 );
+    const int mate = 11 - opp;
 
-    const std::vector< const GlobalPlayerObject * > & players
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersRight()
-            : M_world.playersLeft() );
-    const std::vector< const GlobalPlayerObject * >::const_iterator end
-        = players.end();
+    bool collide[11];
 
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = players.begin();
-          p != end;
-          ++p )
+    // check ball and goal post
+    for ( int i = 0; i < 11; ++i )
     {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
-
-        // check ball
-        if ( (*p)->pos().dist2( M_world.ball().pos() ) < ball_collide_dist2 )
-        {
-            data.maybe_collide_ = true;
-        }
+        const int o = opp + i;
+        const double bx = cur.pos_x_[o] - ball_x;
+        const double by = cur.pos_y_[o] - ball_y;
+        const double px = std::fabs( cur.pos_x_[o] ) - pole_x;
+        const double py = std::fabs( cur.pos_y_[o] ) - pole_y;
+
+        collide[i] = ( bx * bx + by * by < ball_collide_dist2
+                       || px * px + py * py < pole_collide_dist2 );
     }
 
-    // check other opponent players
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = players.begin();
-          p != end;
-          ++p )
+    // check other players
+    for ( int i = 0; i < 11; ++i )
     {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
+        const int o = opp + i;
+        if ( ! cur.valid_[o] ) continue;
 
-        Data & data = M_opponent_data[(*p)->unum() - 1];
-
-        for ( std::vector< const GlobalPlayerObject * >::const_iterator pp = p + 1;
-              pp != end;
-              ++pp )
+        // other opponent players
+        for ( int j = i + 1; j < 11; ++j )
         {
-            if ( (*pp)->unum() == (*p)->unum() ) continue;
-
-            if ( (*pp)->pos().dist2( (*p)->pos() ) < player_collide_dist2 )
+            const int oo = opp + j;
+            const double dx = cur.pos_x_[oo] - cur.pos_x_[o];
+            const double dy = cur.pos_y_[oo] - cur.pos_y_[o];
+            if ( cur.valid_[oo]
+                 && dx * dx + dy * dy < player_collide_dist2 )
             {
-                data.maybe_collide_ = true;
-                if ( 1 <= (*pp)->unum()
-                     && (*pp)->unum() <= 11 )
-                {
-                    M_opponent_data[(*pp)->unum() - 1].maybe_collide_ = true;
-                }
+                collide[i] = true;
+                collide[j] = true;
             }
         }
-    }
 
-    // check teammate players
-    const std::vector< const GlobalPlayerObject * > & teammates
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersLeft()
-            : M_world.playersRight() );
-    const std::vector< const GlobalPlayerObject * >::const_iterator t_end
-        = teammates.end();
+        if ( collide[i] ) continue;
 
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = players.begin();
-          p != end;
-          ++p )
-    {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
-
-        if ( data.maybe_collide_ ) continue;
-
-        for ( std::vector< const GlobalPlayerObject * >::const_iterator pp
-                  = teammates.begin();
-              pp != t_end;
-              ++pp )
+        // teammate players
+        for ( int j = 0; j < 11; ++j )
         {
-            if ( (*pp)->pos().dist2( (*p)->pos() ) < player_collide_dist2 )
+            const int t = mate + j;
+            const double dx = cur.pos_x_[t] - cur.pos_x_[o];
+            const double dy = cur.pos_y_[t] - cur.pos_y_[o];
+            if ( cur.valid_[t]
+                 && dx * dx + dy * dy < player_collide_dist2 )
             {
-                data.maybe_collide_ = true;
+                collide[i] = true;
                 break;
             }
         }
     }
 
-    // check goal post
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = players.begin();
-          p != end;
-          ++p )
+    for ( int i = 0; i < 11; ++i )
     {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
-
-        if ( data.maybe_collide_ ) continue;
-
-        Vector2D abs_pos( (*p)->pos().absX(), (*p)->pos().absY() );
-        if ( abs_pos.dist2( pole_pos ) < pole_collide_dist2 )
-        {
-            data.maybe_collide_ = true;
-        }
+        M_opponent_data[i].maybe_collide_ = ( cur.valid_[opp + i] && collide[i] );
     }
-
 }
 
 /*-------------------------------------------------------------------*/
@@ -664,6 +526,12 @@ PlayerTypeAnalyzer::checkKick()
         return;
     }
 
+    const GlobalPlayerTable::Frame & prev = M_world.playerTable().frame( 1 );
+    const int opp = ( M_world.ourSide() == LEFT ? 11 : 0 );
+    const int mate = 11 - opp;
+
+    const double ball_x = M_prev_ball.pos().x;
+    const double ball_y = M_prev_ball.pos().y;
 
     int count = 0;
     int kicker_idx = -1;
@@ -671,27 +539,27 @@ PlayerTypeAnalyzer::checkKick()
     // update kick possibility
     for ( int i = 0; i < 11; ++i )
     {
+        const int t = mate + i;
+        const double tx = prev.pos_x_[t] - ball_x;
+        const double ty = prev.pos_y_[t] - ball_y;
         if ( ! M_teammate_data[i].turned_
-             && M_teammate_data[i].pos_.valid() )
+             && prev.valid_[t]
+             && tx * tx + ty * ty < S_max_kickable_area2 )
         {
-            if ( M_prev_ball.pos().dist2( M_teammate_data[i].pos_ )
-                 < S_max_kickable_area2 )
-            {
-                M_teammate_data[i].maybe_kick_ = true;
-                ++count;
-            }
+            M_teammate_data[i].maybe_kick_ = true;
+            ++count;
         }
 
+        const int o = opp + i;
+        const double ox = prev.pos_x_[o] - ball_x;
+        const double oy = prev.pos_y_[o] - ball_y;
         if ( ! M_opponent_data[i].turned_
-             && M_opponent_data[i].pos_.valid() )
+             && prev.valid_[o]
+             && ox * ox + oy * oy < S_max_kickable_area2 )
         {
-            if ( M_prev_ball.pos().dist2( M_opponent_data[i].pos_ )
-                 < S_max_kickable_area2 )
-            {
-                M_opponent_data[i].maybe_kick_ = true;
-                ++count;
-                kicker_idx = i;
-            }
+            M_opponent_data[i].maybe_kick_ = true;
+            ++count;
+            kicker_idx = i;
         }
     }
 
@@ -699,7 +567,7 @@ PlayerTypeAnalyzer::checkKick()
     {
         // ball may be tackled
     }
-    else if ( count == 1 && kicker_idx != 0 )
+    else if ( count == 1 && kicker_idx > 0 )
     {
         Data & data = M_opponent_data[kicker_idx];
 
@@ -709,7 +577,10 @@ PlayerTypeAnalyzer::checkKick()
         }
         else
         {
-            const double ball_dist = M_prev_ball.pos().dist( data.pos_ );
+            const int o = opp + kicker_idx;
+            const double ball_dist
+                = std::sqrt( std::pow( prev.pos_x_[o] - ball_x, 2 )
+                             + std::pow( prev.pos_y_[o] - ball_y, 2 ) );
 
             for ( int t = 0; t < max_types; ++t )
             {
@@ -749,28 +620,28 @@ PlayerTypeAnalyzer::checkPlayerDecay()
 {
     const int max_types = PlayerParam::i().playerTypes();
 
-    const std::vector< const GlobalPlayerObject * > & players
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersRight()
-            : M_world.playersLeft() );
+    const GlobalPlayerTable::Frame & cur = M_world.playerTable().frame( 0 );
+    const GlobalPlayerTable::Frame & prev = M_world.playerTable().frame( 1 );
+    const int opp = ( M_world.ourSide() == LEFT ? 11 : 0 );
 
-    const std::vector< const GlobalPlayerObject * >::const_iterator end
-        = players.end();
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = players.begin();
-          p != end;
-          ++p )
+    for ( int i = 0; i < 11; ++i )
     {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
+        const int o = opp + i;
+        Data & data = M_opponent_data[i];
 
+        if ( ! cur.valid_[o] || ! prev.valid_[o] ) continue;
         if ( data.maybe_collide_ || data.maybe_kick_ ) continue;
         if ( ! data.turned_ ) continue;
-        if ( ! data.pos_.valid() ) continue;
-        if ( data.pos_.dist2( (*p)->pos() ) < 0.0001 ) continue;
 
-        double rand_max = data.vel_.r() * ServerParam::i().playerRand();
+        const double move_x = cur.pos_x_[o] - prev.pos_x_[o];
+        const double move_y = cur.pos_y_[o] - prev.pos_y_[o];
+        if ( move_x * move_x + move_y * move_y < 0.0001 ) continue;
+
+        const double prev_vx = prev.vel_x_[o];
+        const double prev_vy = prev.vel_y_[o];
+        const double rand_max
+            = std::sqrt( prev_vx * prev_vx + prev_vy * prev_vy )
+            * ServerParam::i().playerRand();
         if ( rand_max < 0.00001 ) continue;
 
         for ( int t = 0; t < max_types; ++t )
@@ -780,15 +651,11 @@ PlayerTypeAnalyzer::checkPlayerDecay()
             const PlayerType * player_type = PlayerTypeSet::i().get( t );
             if ( ! player_type ) continue;
 
-            double rand_x
-                = std::fabs( ( (*p)->vel().x
-                               - data.vel_.x * player_type->playerDecay() )
-                             / player_type->playerDecay() );
-
-            double rand_y
-                = std::fabs( ( (*p)->vel().y
-                               - data.vel_.y * player_type->playerDecay() )
-                             / player_type->playerDecay() );
+            const double decay = player_type->playerDecay();
+            const double rand_x
+                = std::fabs( ( cur.vel_x_[o] - prev_vx * decay ) / decay );
+            const double rand_y
+                = std::fabs( ( cur.vel_y_[o] - prev_vy * decay ) / decay );
 
             if ( rand_x > rand_max + 0.0000001
                  || rand_y > rand_max + 0.0000001 )
@@ -797,7 +664,7 @@ PlayerTypeAnalyzer::checkPlayerDecay()
 #ifdef DEBUG
                 std::cout << M_world.time()
                           << ' ' << M_world.ourTeamName()
-                          << " Coach: opponent " << (*p)->unum()
+                          << " Coach: opponent " << i + 1
                           << "  detect invalid decay. type = "
                           << t
                           << std::endl;
@@ -816,27 +683,20 @@ PlayerTypeAnalyzer::checkPlayerSpeedMax()
 {
     const int max_types = PlayerParam::i().playerTypes();
 
-    const std::vector< const GlobalPlayerObject * > & players
-        = ( M_world.ourSide() == LEFT
-            ? M_world.playersRight()
-            : M_world.playersLeft() );
+    const GlobalPlayerTable::Frame & cur = M_world.playerTable().frame( 0 );
+    const GlobalPlayerTable::Frame & prev = M_world.playerTable().frame( 1 );
+    const int opp = ( M_world.ourSide() == LEFT ? 11 : 0 );
 
-    const std::vector< const GlobalPlayerObject * >::const_iterator end
-        = players.end();
-    for ( std::vector< const GlobalPlayerObject * >::const_iterator p
-              = players.begin();
-          p != end;
-          ++p )
+    for ( int i = 0; i < 11; ++i )
     {
-        if ( (*p)->unum() < 1 || 11 < (*p)->unum() ) continue;
-
-        Data & data = M_opponent_data[(*p)->unum() - 1];
+        const int o = opp + i;
+        Data & data = M_opponent_data[i];
 
+        if ( ! cur.valid_[o] || ! prev.valid_[o] ) continue;
         if ( data.maybe_collide_ ) continue;
-        if ( ! data.pos_.valid() ) continue;
 
-        double x_move = std::fabs( (*p)->pos().x - data.pos_.x );
-        double y_move = std::fabs( (*p)->pos().y - data.pos_.y );
+        const double x_move = std::fabs( cur.pos_x_[o] - prev.pos_x_[o] );
+        const double y_move = std::fabs( cur.pos_y_[o] - prev.pos_y_[o] );
 
         for ( int t = 0; t < max_types; ++t )
         {
@@ -858,7 +718,7 @@ PlayerTypeAnalyzer::checkPlayerSpeedMax()
 #ifdef DEBUG
                 std::cout << M_world.time()
                           << ' ' << M_world.ourTeamName()
-                          << " Coach: opponent " << (*p)->unum()
+                          << " Coach: opponent " << i + 1
                           << "  detect invalid speed. type = "
                           << t
                           << std::endl;
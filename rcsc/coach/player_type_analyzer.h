@@ -55,9 +55,6 @@ private:
         bool maybe_referee_; //!< player may be moved by referee
         bool maybe_collide_; //!< player may be collided with others
         bool maybe_kick_;  //!< player may kick the ball
-        Vector2D pos_; //!< last pos
-        Vector2D vel_; //!< last vel
-        double body_; //!< last body direction
 
         //! if invalid data is detected, positive value is set
         std::vector< int > invalid_flags_;
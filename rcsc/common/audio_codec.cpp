@@ -74,10 +74,13 @@ AudioCodec::AudioCodec()
 {
     // create int <-> char map
 
+    std::fill( M_char_to_int_table, M_char_to_int_table + 256, -1 );
+
     for ( int i = 0; i < CHAR_SIZE; ++i )
     {
         M_char_to_int_map.insert( std::make_pair( CHAR_SET[i], i ) );
         M_int_to_char_map.push_back( CHAR_SET[i] );
+        M_char_to_int_table[static_cast< unsigned char >( CHAR_SET[i] )] = i;
     }
 }
 
@@ -103,18 +106,7 @@ AudioCodec::encodeInt64ToStr( const boost::int64_t & ival,
                               const int len,
                               std::string & to ) const
 {
-    std::vector< int > remainder_values;
-    remainder_values.reserve( len );
-
-    boost::int64_t divided = ival;
-
-    for ( int i = 0; i < len - 1; ++i )
-    {
-        remainder_values.push_back( divided % CHAR_SIZE );
-        divided /= CHAR_SIZE;
-    }
-
-    if ( divided >= CHAR_SIZE )
+    if ( ival < 0 || len <= 0 )
     {
         std::cerr << __FILE__ << ':' << __LINE__
                   << " ***ERROR*** AudioCodec::encodeInt64ToStr."
@@ -123,27 +115,29 @@ AudioCodec::encodeInt64ToStr( const boost::int64_t & ival,
         return false;
     }
 
-    remainder_values.push_back( divided );
+    // fill the characters from the last digit
+    std::string buf( len, '\0' );
+
+    boost::int64_t divided = ival;
 
-    try
+    for ( int i = len - 1; i > 0; --i )
     {
-        const std::vector< int >::reverse_iterator end = remainder_values.rend();
-        for ( std::vector< int >::reverse_iterator it = remainder_values.rbegin();
-              it != end;
-              ++it )
-        {
-            to += M_int_to_char_map.at( *it );
-        }
+        buf[i] = M_int_to_char_map[static_cast< int >( divided % CHAR_SIZE )];
+        divided /= CHAR_SIZE;
     }
-    catch ( std::exception & e )
+
+    if ( divided >= CHAR_SIZE )
     {
         std::cerr << __FILE__ << ':' << __LINE__
                   << " ***ERROR*** AudioCodec::encodeInt64ToStr."
-                  << " Exception caught: " << e.what()
+                  << " Illegal value. "
                   << std::endl;
         return false;
     }
 
+    buf[0] = M_int_to_char_map[static_cast< int >( divided )];
+
+    to += buf;
     return true;
 }
 
@@ -161,15 +155,14 @@ AudioCodec::decodeStrToInt64( const std::string & from,
     }
 
     boost::int64_t rval = 0;
-    int digit_count = from.length() - 1;
 
     const std::string::const_iterator end = from.end();
     for ( std::string::const_iterator ch = from.begin();
           ch != end;
-          ++ch, --digit_count )
+          ++ch )
     {
-        CharToIntCont::const_iterator it = M_char_to_int_map.find( *ch );
-        if ( it == M_char_to_int_map.end() )
+        const int digit = charToInt( *ch );
+        if ( digit < 0 )
         {
             std::cerr << __FILE__ << ": " << __LINE__
                       << " ***ERROR*** AudioCodec::decodeStrToInt64."
@@ -179,11 +172,7 @@ AudioCodec::decodeStrToInt64( const std::string & from,
             return false;
         }
 
-        rval
-            += static_cast< boost::int64_t >( it->second )
-            * static_cast< boost::int64_t >
-            ( std::pow( static_cast< double >( CHAR_SIZE ),
-                        static_cast< double >( digit_count ) ) );
+        rval = rval * CHAR_SIZE + digit;
     }
 
     if ( to )
@@ -219,18 +208,16 @@ AudioCodec::encodePercentageToChar( const double & value ) const
         return '\0';
     }
 
-    try
-    {
-        return  intToCharMap().at( ival );
-    }
-    catch ( ... )
+    const char ch = intToChar( ival );
+    if ( ch == '\0' )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::encodePercentageToChar."
-                  << " Exception caught! Failed to encode"
+                  << " Failed to encode"
                   << std::endl;
-        return '\0';
     }
+
+    return ch;
 }
 
 /*-------------------------------------------------------------------*/
@@ -240,8 +227,8 @@ AudioCodec::encodePercentageToChar( const double & value ) const
 double
 AudioCodec::decodeCharToPercentage( const char ch ) const
 {
-    CharToIntCont::const_iterator it = charToIntMap().find( ch );
-    if ( it == charToIntMap().end() )
+    const int ival = charToInt( ch );
+    if ( ival < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeCharToPercentage."
@@ -250,7 +237,7 @@ AudioCodec::decodeCharToPercentage( const char ch ) const
         return ERROR_VALUE;
     }
 
-    return ( static_cast< double >( it->second )
+    return ( static_cast< double >( ival )
              / static_cast< double >( CHAR_SIZE - 1) );
 }
 
@@ -602,23 +589,19 @@ AudioCodec::encodeCoordToStr2( const double & xy,
         return std::string();
     }
 
-    std::string msg;
-    msg.reserve( 2 );
-
-    try
-    {
-        msg += intToCharMap().at( i1 );
-        msg += intToCharMap().at( i2 );
-    }
-    catch ( ... )
+    if ( i1 < 0 || i2 < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::encodeCoordToStr2."
-                  << " Exception caught! "
+                  << " negative value. value = " << xy
+                  << " norm_factor = " << norm_factor
                   << std::endl;
         return std::string();
     }
 
+    std::string msg( 2, M_int_to_char_map[i1] );
+    msg[1] = M_int_to_char_map[i2];
+
     return msg;
 }
 
@@ -631,10 +614,8 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                                const char ch2,
                                const double & norm_factor ) const
 {
-    const CharToIntCont::const_iterator end = charToIntMap().end();
-
-    CharToIntCont::const_iterator it = charToIntMap().find( ch1 );
-    if ( it == end )
+    const int i1 = charToInt( ch1 );
+    if ( i1 < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeStr2ToCoord()."
@@ -642,10 +623,9 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                   << std::endl;
         return ERROR_VALUE;
     }
-    int i1 = it->second;
 
-    it = charToIntMap().find( ch2 );
-    if ( it == end )
+    const int i2 = charToInt( ch2 );
+    if ( i2 < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeStr2ToCoord()."
@@ -653,7 +633,6 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                   << std::endl;
         return ERROR_VALUE;
     }
-    int i2 = it->second;
 
     return
         (
@@ -740,20 +719,16 @@ AudioCodec::encodeSpeedToChar( const double & val ) const
 
     int ival = static_cast< int >( rint( tmp ) );
 
-    try
-    {
-        return  intToCharMap().at( ival );
-    }
-    catch ( ... )
+    const char ch = intToChar( ival );
+    if ( ch == '\0' )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::encodeSpeedL1."
-                  << " Exception caught! Failed to encode"
+                  << " Failed to encode"
                   << std::endl;
-        return '\0';
     }
 
-    return '\0';
+    return ch;
 }
 
 /*-------------------------------------------------------------------*/
@@ -763,8 +738,8 @@ AudioCodec::encodeSpeedToChar( const double & val ) const
 double
 AudioCodec::decodeCharToSpeed( const char ch ) const
 {
-    CharToIntCont::const_iterator it = charToIntMap().find( ch );
-    if ( it == charToIntMap().end() )
+    const int ival = charToInt( ch );
+    if ( ival < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeSpeedL1."
@@ -774,7 +749,7 @@ AudioCodec::decodeCharToSpeed( const char ch ) const
     }
 
     return
-        ( static_cast< double >( it->second ) * SPEED_STEP_L1
+        ( static_cast< double >( ival ) * SPEED_STEP_L1
           - SPEED_NORM_FACTOR
           );
 }
@@ -109,6 +109,9 @@ private:
     //! map to cnvert integer to character. vector of char
     IntToCharCont M_int_to_char_map;
 
+    //! flat table to convert character to integer. -1 means illegal character.
+    int M_char_to_int_table[256];
+
 public:
 
     static const std::string CHAR_SET; //!< available character set
@@ -203,6 +206,28 @@ public:
           return M_int_to_char_map;
       }
 
+    /*!
+      \brief convert character to integer by the table lookup
+      \param ch character to be converted
+      \return converted integer value, or -1 if ch is not in CHAR_SET
+    */
+    int charToInt( const char ch ) const
+      {
+          return M_char_to_int_table[static_cast< unsigned char >( ch )];
+      }
+
+    /*!
+      \brief convert integer to character
+      \param ival integer value to be converted
+      \return converted character, or '\0' if ival is out of range
+    */
+    char intToChar( const int ival ) const
+      {
+          return ( 0 <= ival && ival < CHAR_SIZE
+                   ? M_int_to_char_map[ival]
+                   : '\0' );
+      }
+
     /*!
       \brief encode decimal (64bit) integer to the encoded string.
       \param ival input value
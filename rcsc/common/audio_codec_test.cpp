@@ -0,0 +1,426 @@
+// -*-c++-*-
+
+/*!
+  \file audio_codec_test.cpp
+  \brief round trip test code for rcsc::AudioCodec
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/random.hpp>
+
+#include "audio_codec.h"
+#include "server_param.h"
+
+#include <rcsc/geom/vector_2d.h>
+
+#include <string>
+
+using namespace boost::unit_test_framework;
+
+namespace {
+
+//! the number of random samples for each codec
+const int N_SAMPLES = 20000;
+
+//! small margin for the rounding error
+const double EPS = 1.0e-6;
+
+typedef boost::variate_generator< boost::mt19937 &,
+                                  boost::uniform_real<> > RealGen;
+
+boost::mt19937 &
+random_engine()
+{
+    static boost::mt19937 s_engine( 5489 );
+    return s_engine;
+}
+
+double
+random_real( const double & min_v,
+             const double & max_v )
+{
+    RealGen gen( random_engine(),
+                 boost::uniform_real<>( min_v, max_v ) );
+    return gen();
+}
+
+boost::int64_t
+random_int64( const boost::int64_t & max_v )
+{
+    // combine 2 draws to cover values larger than 32 bits
+    boost::uint64_t v = random_engine()();
+    v <<= 32;
+    v |= random_engine()();
+    return static_cast< boost::int64_t >( v % static_cast< boost::uint64_t >( max_v ) );
+}
+
+/*!
+  \brief get CHAR_SIZE^len
+ */
+boost::int64_t
+max_value( const int len )
+{
+    boost::int64_t v = 1;
+    for ( int i = 0; i < len; ++i )
+    {
+        v *= rcsc::AudioCodec::CHAR_SIZE;
+    }
+    return v;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkInt64RoundTrip()
+{
+    const rcsc::AudioCodec & codec = rcsc::AudioCodec::i();
+
+    for ( int len = 1; len <= 9; ++len )
+    {
+        const boost::int64_t max_v = max_value( len );
+
+        //
+        // boundary values
+        //
+        const boost::int64_t boundary[] = { 0, 1,
+                                            rcsc::AudioCodec::CHAR_SIZE - 1,
+                                            max_v / 2,
+                                            max_v - 1 };
+        for ( int i = 0; i < 5; ++i )
+        {
+            if ( boundary[i] >= max_v ) continue;
+
+            std::string str;
+            BOOST_REQUIRE( codec.encodeInt64ToStr( boundary[i], len, str ) );
+            BOOST_CHECK_EQUAL( str.length(), static_cast< std::size_t >( len ) );
+
+            boost::int64_t decoded = -1;
+            BOOST_CHECK( codec.decodeStrToInt64( str, &decoded ) );
+            BOOST_CHECK_EQUAL( decoded, boundary[i] );
+        }
+
+        //
+        // out of range
+        //
+        {
+            std::string str;
+            BOOST_CHECK( ! codec.encodeInt64ToStr( max_v, len, str ) );
+            BOOST_CHECK( ! codec.encodeInt64ToStr( -1, len, str ) );
+            BOOST_CHECK( str.empty() );
+        }
+
+        //
+        // random values
+        //
+        for ( int i = 0; i < N_SAMPLES / 9; ++i )
+        {
+            const boost::int64_t value = random_int64( max_v );
+
+            std::string str;
+            BOOST_REQUIRE( codec.encodeInt64ToStr( value, len, str ) );
+
+            boost::int64_t decoded = -1;
+            BOOST_CHECK( codec.decodeStrToInt64( str, &decoded ) );
+            BOOST_CHECK_EQUAL( decoded, value );
+        }
+    }
+
+    // the result is appended
+    {
+        std::string str = "ab";
+        BOOST_CHECK( codec.encodeInt64ToStr( 0, 2, str ) );
+        BOOST_CHECK_EQUAL( str, std::string( "ab00" ) );
+    }
+
+    // illegal characters
+    {
+        boost::int64_t decoded = 0;
+        BOOST_CHECK( ! codec.decodeStrToInt64( std::string(), &decoded ) );
+        BOOST_CHECK( ! codec.decodeStrToInt64( "a!b", &decoded ) );
+        BOOST_CHECK( ! codec.decodeStrToInt64( "a\"", &decoded ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkPosRoundTrip()
+{
+    const rcsc::AudioCodec & codec = rcsc::AudioCodec::i();
+
+    // half of the quantization steps
+    const double str3_x_err = ( 104.0 / 511.0 ) * 0.5 + EPS;
+    const double str3_y_err = ( 68.0 / 511.0 ) * 0.5 + EPS;
+    const double str4_err = rcsc::AudioCodec::COORD_STEP_L2 * 0.5 + EPS;
+
+    const rcsc::Vector2D boundary[] = { rcsc::Vector2D( 0.0, 0.0 ),
+                                        rcsc::Vector2D( -52.0, -34.0 ),
+                                        rcsc::Vector2D( 52.0, 34.0 ),
+                                        rcsc::Vector2D( -52.0, 34.0 ),
+                                        rcsc::Vector2D( 52.0, -34.0 ) };
+
+    for ( int i = 0; i < N_SAMPLES + 5; ++i )
+    {
+        const rcsc::Vector2D pos = ( i < 5
+                                     ? boundary[i]
+                                     : rcsc::Vector2D( random_real( -52.0, 52.0 ),
+                                                       random_real( -34.0, 34.0 ) ) );
+
+        // 3 characters
+        {
+            std::string str;
+            BOOST_REQUIRE( codec.encodePosToStr3( pos, str ) );
+            BOOST_CHECK_EQUAL( str.length(), std::size_t( 3 ) );
+
+            rcsc::Vector2D decoded;
+            BOOST_CHECK( codec.decodeStr3ToPos( str, &decoded ) );
+            BOOST_CHECK_SMALL( decoded.x - pos.x, str3_x_err );
+            BOOST_CHECK_SMALL( decoded.y - pos.y, str3_y_err );
+        }
+
+        // 4 characters
+        {
+            const std::string str = codec.encodePosToStr4( pos );
+            BOOST_REQUIRE_EQUAL( str.length(), std::size_t( 4 ) );
+
+            const rcsc::Vector2D decoded = codec.decodeStr4ToPos( str );
+            BOOST_CHECK( decoded.valid() );
+            BOOST_CHECK_SMALL( decoded.x - pos.x, str4_err );
+            BOOST_CHECK_SMALL( decoded.y - pos.y, str4_err );
+        }
+    }
+
+    //
+    // out of the field. the value is clipped.
+    //
+    {
+        std::string str;
+        BOOST_REQUIRE( codec.encodePosToStr3( rcsc::Vector2D( 100.0, -100.0 ), str ) );
+
+        rcsc::Vector2D decoded;
+        BOOST_CHECK( codec.decodeStr3ToPos( str, &decoded ) );
+        BOOST_CHECK_SMALL( decoded.x - 52.0, EPS );
+        BOOST_CHECK_SMALL( decoded.y - ( -34.0 ), EPS );
+
+        const rcsc::Vector2D decoded4
+            = codec.decodeStr4ToPos( codec.encodePosToStr4( rcsc::Vector2D( -100.0, 100.0 ) ) );
+        BOOST_CHECK_SMALL( decoded4.x - ( -rcsc::AudioCodec::X_NORM_FACTOR ), EPS );
+        BOOST_CHECK_SMALL( decoded4.y - rcsc::AudioCodec::Y_NORM_FACTOR, EPS );
+    }
+
+    //
+    // illegal length or characters
+    //
+    {
+        rcsc::Vector2D decoded;
+        BOOST_CHECK( ! codec.decodeStr3ToPos( "ab", &decoded ) );
+        BOOST_CHECK( ! codec.decodeStr3ToPos( "abcd", &decoded ) );
+        BOOST_CHECK( ! codec.decodeStr3ToPos( "a!c", &decoded ) );
+        BOOST_CHECK( ! codec.decodeStr4ToPos( "abc" ).valid() );
+        BOOST_CHECK( ! codec.decodeStr4ToPos( "ab!d" ).valid() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkPosVelRoundTrip()
+{
+    const rcsc::AudioCodec & codec = rcsc::AudioCodec::i();
+
+    const double max_speed = rcsc::ServerParam::i().ballSpeedMax();
+
+    const double x_err = ( 105.0 / 1023.0 ) * 0.5 + EPS;
+    const double y_err = ( 68.0 / 511.0 ) * 0.5 + EPS;
+    const double vel_err = ( max_speed * 2.0 / 63.0 ) * 0.5 + EPS;
+
+    const rcsc::Vector2D boundary_pos[] = { rcsc::Vector2D( -52.5, -34.0 ),
+                                            rcsc::Vector2D( 52.5, 34.0 ),
+                                            rcsc::Vector2D( 0.0, 0.0 ) };
+    const rcsc::Vector2D boundary_vel[] = { rcsc::Vector2D( -max_speed, -max_speed ),
+                                            rcsc::Vector2D( max_speed, max_speed ),
+                                            rcsc::Vector2D( 0.0, 0.0 ) };
+
+    for ( int i = 0; i < N_SAMPLES + 3; ++i )
+    {
+        const rcsc::Vector2D pos = ( i < 3
+                                     ? boundary_pos[i]
+                                     : rcsc::Vector2D( random_real( -52.5, 52.5 ),
+                                                       random_real( -34.0, 34.0 ) ) );
+        const rcsc::Vector2D vel = ( i < 3
+                                     ? boundary_vel[i]
+                                     : rcsc::Vector2D( random_real( -max_speed, max_speed ),
+                                                       random_real( -max_speed, max_speed ) ) );
+
+        std::string str;
+        BOOST_REQUIRE( codec.encodePosVelToStr5( pos, vel, str ) );
+        BOOST_CHECK_EQUAL( str.length(), std::size_t( 5 ) );
+
+        rcsc::Vector2D decoded_pos, decoded_vel;
+        BOOST_CHECK( codec.decodeStr5ToPosVel( str, &decoded_pos, &decoded_vel ) );
+        BOOST_CHECK_SMALL( decoded_pos.x - pos.x, x_err );
+        BOOST_CHECK_SMALL( decoded_pos.y - pos.y, y_err );
+        BOOST_CHECK_SMALL( decoded_vel.x - vel.x, vel_err );
+        BOOST_CHECK_SMALL( decoded_vel.y - vel.y, vel_err );
+    }
+
+    //
+    // speed 1 character
+    //
+    const double speed_err = rcsc::AudioCodec::SPEED_STEP_L1 * 0.5 + EPS;
+    for ( int i = 0; i < N_SAMPLES + 3; ++i )
+    {
+        const double speed = ( i == 0 ? -rcsc::AudioCodec::SPEED_NORM_FACTOR
+                               : i == 1 ? rcsc::AudioCodec::SPEED_NORM_FACTOR
+                               : i == 2 ? 0.0
+                               : random_real( -rcsc::AudioCodec::SPEED_NORM_FACTOR,
+                                              rcsc::AudioCodec::SPEED_NORM_FACTOR ) );
+
+        const char ch = codec.encodeSpeedToChar( speed );
+        BOOST_REQUIRE( ch != '\0' );
+
+        const double decoded = codec.decodeCharToSpeed( ch );
+        BOOST_CHECK_SMALL( decoded - speed, speed_err );
+    }
+
+    BOOST_CHECK_EQUAL( codec.decodeCharToSpeed( '!' ),
+                       rcsc::AudioCodec::ERROR_VALUE );
+    BOOST_CHECK( ! codec.decodeStr5ToPosVel( "abcd", 0, 0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkUnumRoundTrip()
+{
+    const rcsc::AudioCodec & codec = rcsc::AudioCodec::i();
+
+    const double x_err = ( 105.0 / 1023.0 ) * 0.5 + EPS;
+    const double y_err = ( 68.0 / 511.0 ) * 0.5 + EPS;
+
+    //
+    // hex uniform number
+    //
+    for ( int unum = 1; unum <= 11; ++unum )
+    {
+        BOOST_CHECK_EQUAL( rcsc::AudioCodec::hex2unum( rcsc::AudioCodec::unum2hex( unum ) ),
+                           unum );
+    }
+    BOOST_CHECK_EQUAL( rcsc::AudioCodec::unum2hex( 0 ), '\0' );
+    BOOST_CHECK_EQUAL( rcsc::AudioCodec::unum2hex( 12 ), '\0' );
+    BOOST_CHECK( rcsc::AudioCodec::hex2unum( 'C' ) < 1 );
+
+    //
+    // uniform number and position
+    //
+    for ( int i = 0; i < N_SAMPLES; ++i )
+    {
+        const int unum = 1 + i % 11;
+        const rcsc::Vector2D pos = ( i < 11
+                                     ? rcsc::Vector2D( ( i % 2 == 0 ? -52.5 : 52.5 ),
+                                                       ( i % 3 == 0 ? -34.0 : 34.0 ) )
+                                     : rcsc::Vector2D( random_real( -52.5, 52.5 ),
+                                                       random_real( -34.0, 34.0 ) ) );
+
+        std::string str;
+        BOOST_REQUIRE( codec.encodeUnumPosToStr4( unum, pos, str ) );
+        BOOST_CHECK_EQUAL( str.length(), std::size_t( 4 ) );
+
+        int decoded_unum = 0;
+        rcsc::Vector2D decoded_pos;
+        BOOST_CHECK( codec.decodeStr4ToUnumPos( str, &decoded_unum, &decoded_pos ) );
+        BOOST_CHECK_EQUAL( decoded_unum, unum );
+        BOOST_CHECK_SMALL( decoded_pos.x - pos.x, x_err );
+        BOOST_CHECK_SMALL( decoded_pos.y - pos.y, y_err );
+    }
+
+    {
+        std::string str;
+        BOOST_CHECK( ! codec.encodeUnumPosToStr4( 0, rcsc::Vector2D( 0.0, 0.0 ), str ) );
+        BOOST_CHECK( ! codec.encodeUnumPosToStr4( 12, rcsc::Vector2D( 0.0, 0.0 ), str ) );
+        BOOST_CHECK( str.empty() );
+
+        int unum = 0;
+        BOOST_CHECK( ! codec.decodeStr4ToUnumPos( "abc", &unum, 0 ) );
+        BOOST_CHECK( ! codec.decodeStr4ToUnumPos( "ab!d", &unum, 0 ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkPercentageRoundTrip()
+{
+    const rcsc::AudioCodec & codec = rcsc::AudioCodec::i();
+
+    const double step = 1.0 / ( rcsc::AudioCodec::CHAR_SIZE - 1 );
+
+    for ( int i = 0; i < rcsc::AudioCodec::CHAR_SIZE; ++i )
+    {
+        const double value = i * step;
+        const char ch = codec.encodePercentageToChar( value );
+        BOOST_REQUIRE( ch != '\0' );
+        BOOST_CHECK_SMALL( codec.decodeCharToPercentage( ch ) - value, EPS );
+    }
+
+    for ( int i = 0; i < N_SAMPLES; ++i )
+    {
+        const double value = random_real( 0.0, 1.0 );
+        const char ch = codec.encodePercentageToChar( value );
+        BOOST_REQUIRE( ch != '\0' );
+        BOOST_CHECK_SMALL( codec.decodeCharToPercentage( ch ) - value,
+                           step * 0.5 + EPS );
+    }
+
+    BOOST_CHECK_EQUAL( codec.encodePercentageToChar( -0.1 ), '\0' );
+    BOOST_CHECK_EQUAL( codec.encodePercentageToChar( 1.1 ), '\0' );
+}
+
+
+test_suite *
+init_unit_test_suite( int argc, char * argv[] )
+{
+    test_suite * test = BOOST_TEST_SUITE( "rcsc::AudioCodec test" );
+
+    test -> add( BOOST_TEST_CASE( &checkInt64RoundTrip ) );
+    test -> add( BOOST_TEST_CASE( &checkPosRoundTrip ) );
+    test -> add( BOOST_TEST_CASE( &checkPosVelRoundTrip ) );
+    test -> add( BOOST_TEST_CASE( &checkUnumRoundTrip ) );
+    test -> add( BOOST_TEST_CASE( &checkPercentageRoundTrip ) );
+
+    return test;
+}
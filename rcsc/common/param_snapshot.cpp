@@ -0,0 +1,381 @@
+// -*-c++-*-
+
+/*!
+  \file param_snapshot.cpp
+  \brief binary snapshot of the parsed server parameters Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "param_snapshot.h"
+
+#include "server_param.h"
+#include "player_param.h"
+#include "player_type.h"
+
+#include <rcsc/param/param_map.h>
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+namespace {
+
+//! file header
+const char SNAPSHOT_MAGIC[] = "RCSCPSN1";
+//! header length
+const std::size_t SNAPSHOT_MAGIC_LEN = 8;
+
+}
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ParamSnapshot::ParamSnapshot()
+    : M_modified( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParamSnapshot::open( const std::string & file_path )
+{
+    M_file_path = file_path;
+    M_blobs.clear();
+    M_modified = false;
+
+    if ( M_file_path.empty() )
+    {
+        return false;
+    }
+
+    std::ifstream fin( M_file_path.c_str(), std::ios_base::binary );
+    if ( ! fin.is_open() )
+    {
+        // the file will be created later
+        return false;
+    }
+
+    char magic[SNAPSHOT_MAGIC_LEN];
+    boost::uint32_t count = 0;
+    if ( ! fin.read( magic, SNAPSHOT_MAGIC_LEN )
+         || std::memcmp( magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN ) != 0
+         || ! read_binary_value( fin, count ) )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " ***WARNING*** illegal parameter snapshot ["
+                  << M_file_path << "]. ignored."
+                  << std::endl;
+        return false;
+    }
+
+    for ( boost::uint32_t i = 0; i < count; ++i )
+    {
+        boost::uint32_t key = 0;
+        std::string blob;
+        if ( ! read_binary_value( fin, key )
+             || ! read_binary_value( fin, blob ) )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " ***WARNING*** broken parameter snapshot ["
+                      << M_file_path << "]. ignored."
+                      << std::endl;
+            M_blobs.clear();
+            return false;
+        }
+
+        M_blobs[key] = blob;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParamSnapshot::write() const
+{
+    if ( M_file_path.empty() )
+    {
+        return false;
+    }
+
+    std::ostringstream tmp_path;
+    tmp_path << M_file_path << ".tmp";
+#ifdef HAVE_UNISTD_H
+    tmp_path << '.' << ::getpid();
+#endif
+
+    {
+        std::ofstream fout( tmp_path.str().c_str(),
+                            std::ios_base::binary | std::ios_base::trunc );
+        if ( ! fout.is_open() )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " ***ERROR*** failed to open [" << tmp_path.str() << "]"
+                      << std::endl;
+            return false;
+        }
+
+        fout.write( SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN );
+        write_binary_value( fout, static_cast< boost::uint32_t >( M_blobs.size() ) );
+
+        const BlobMap::const_iterator end = M_blobs.end();
+        for ( BlobMap::const_iterator it = M_blobs.begin();
+              it != end;
+              ++it )
+        {
+            write_binary_value( fout, it->first );
+            write_binary_value( fout, it->second );
+        }
+
+        if ( ! fout.good() )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " ***ERROR*** failed to write [" << tmp_path.str() << "]"
+                      << std::endl;
+            std::remove( tmp_path.str().c_str() );
+            return false;
+        }
+    }
+
+    if ( std::rename( tmp_path.str().c_str(), M_file_path.c_str() ) != 0 )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " ***ERROR*** failed to rename [" << tmp_path.str()
+                  << "] to [" << M_file_path << "]"
+                  << std::endl;
+        std::remove( tmp_path.str().c_str() );
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+boost::uint32_t
+ParamSnapshot::hash_message( const char * msg,
+                             const double & version )
+{
+    // FNV-1a
+    boost::uint32_t h = 2166136261u;
+
+    // the interpretation of the message depends on the protocol version
+    const boost::uint32_t v = static_cast< boost::uint32_t >( version * 100.0 );
+    for ( int i = 0; i < 4; ++i )
+    {
+        h ^= ( v >> ( i * 8 ) ) & 0xff;
+        h *= 16777619u;
+    }
+
+    for ( const char * c = msg; *c != '\0'; ++c )
+    {
+        h ^= static_cast< unsigned char >( *c );
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const
+std::string *
+ParamSnapshot::find( const boost::uint32_t key ) const
+{
+    BlobMap::const_iterator it = M_blobs.find( key );
+    if ( it == M_blobs.end() )
+    {
+        return static_cast< const std::string * >( 0 );
+    }
+
+    return &( it->second );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ParamSnapshot::store( const boost::uint32_t key,
+                      const std::string & blob )
+{
+    M_blobs[key] = blob;
+    M_modified = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParamSnapshot::parseServerParam( const char * msg,
+                                 const double & version )
+{
+    if ( ! enabled() )
+    {
+        return ServerParam::instance().parse( msg, version );
+    }
+
+    const boost::uint32_t key = hash_message( msg, version );
+
+    if ( const std::string * blob = find( key ) )
+    {
+        std::istringstream istrm( *blob );
+        if ( ServerParam::instance().readBinary( istrm ) )
+        {
+            return true;
+        }
+    }
+
+    if ( ! ServerParam::instance().parse( msg, version ) )
+    {
+        return false;
+    }
+
+    std::ostringstream ostrm;
+    if ( ServerParam::i().writeBinary( ostrm ) )
+    {
+        store( key, ostrm.str() );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParamSnapshot::parsePlayerParam( const char * msg,
+                                 const double & version )
+{
+    if ( ! enabled() )
+    {
+        return PlayerParam::instance().parse( msg, version );
+    }
+
+    const boost::uint32_t key = hash_message( msg, version );
+
+    if ( const std::string * blob = find( key ) )
+    {
+        std::istringstream istrm( *blob );
+        if ( PlayerParam::instance().readBinary( istrm ) )
+        {
+            return true;
+        }
+    }
+
+    if ( ! PlayerParam::instance().parse( msg, version ) )
+    {
+        return false;
+    }
+
+    std::ostringstream ostrm;
+    if ( PlayerParam::i().writeBinary( ostrm ) )
+    {
+        store( key, ostrm.str() );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParamSnapshot::parsePlayerType( const char * msg,
+                                const double & version )
+{
+    if ( ! enabled() )
+    {
+        PlayerType player_type( ServerParam::i(), msg, version );
+        PlayerTypeSet::instance().insert( player_type );
+        return true;
+    }
+
+    const boost::uint32_t key = hash_message( msg, version );
+
+    PlayerType player_type;
+    bool restored = false;
+
+    if ( const std::string * blob = find( key ) )
+    {
+        std::istringstream istrm( *blob );
+        restored = player_type.readBinary( ServerParam::i(), istrm );
+    }
+
+    if ( ! restored )
+    {
+        player_type = PlayerType( ServerParam::i(), msg, version );
+
+        std::ostringstream ostrm;
+        if ( player_type.writeBinary( ostrm ) )
+        {
+            store( key, ostrm.str() );
+        }
+    }
+
+    PlayerTypeSet::instance().insert( player_type );
+
+    if ( M_modified
+         && static_cast< int >( PlayerTypeSet::i().playerTypeMap().size() )
+         >= PlayerParam::i().playerTypes() )
+    {
+        if ( write() )
+        {
+            M_modified = false;
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,159 @@
+// -*-c++-*-
+
+/*!
+  \file param_snapshot.h
+  \brief binary snapshot of the parsed server parameters Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_PARAM_SNAPSHOT_H
+#define RCSC_COMMON_PARAM_SNAPSHOT_H
+
+#include <boost/cstdint.hpp>
+
+#include <map>
+#include <string>
+
+namespace rcsc {
+
+/*!
+  \class ParamSnapshot
+  \brief binary cache of ServerParam, PlayerParam and PlayerType set.
+
+  Each parsed server_param, player_param and player_type message is
+  stored as the binary parameter data keyed by the hash value of the
+  raw message. A restarted agent that receives the same message restores
+  the parameters from the snapshot file without the text parsing.
+
+  The snapshot file can be shared by all agents of the same team. The
+  file is replaced atomically by rename().
+ */
+class ParamSnapshot {
+private:
+
+    //! key: message hash, value: binary data
+    typedef std::map< boost::uint32_t, std::string > BlobMap;
+
+    //! snapshot file path. if empty, snapshot is not used.
+    std::string M_file_path;
+
+    //! stored binary data
+    BlobMap M_blobs;
+
+    //! true if new data is stored after the file was read
+    bool M_modified;
+
+public:
+
+    /*!
+      \brief create a disabled snapshot
+     */
+    ParamSnapshot();
+
+    /*!
+      \brief set the snapshot file and read it if exists
+      \param file_path snapshot file path. if empty, snapshot is disabled.
+      \return true if the file is read successfully
+     */
+    bool open( const std::string & file_path );
+
+    /*!
+      \brief check if snapshot is used
+      \return true if the snapshot file is specified
+     */
+    bool enabled() const
+      {
+          return ! M_file_path.empty();
+      }
+
+    /*!
+      \brief update ServerParam by the server_param message
+      \param msg raw message string
+      \param version client protocol version
+      \return true if parameters are updated
+     */
+    bool parseServerParam( const char * msg,
+                           const double & version );
+
+    /*!
+      \brief update PlayerParam by the player_param message
+      \param msg raw message string
+      \param version client protocol version
+      \return true if parameters are updated
+     */
+    bool parsePlayerParam( const char * msg,
+                           const double & version );
+
+    /*!
+      \brief insert the player type into PlayerTypeSet
+      \param msg raw message string
+      \param version client protocol version
+      \return true if the player type is inserted
+
+      If all player types are received and some new data has been
+      stored, the snapshot file is written.
+     */
+    bool parsePlayerType( const char * msg,
+                          const double & version );
+
+    /*!
+      \brief write the snapshot file
+      \return true if successfully written
+     */
+    bool write() const;
+
+    /*!
+      \brief get the key value of the message
+      \param msg raw message string
+      \param version client protocol version
+      \return hash value (FNV-1a)
+     */
+    static
+    boost::uint32_t hash_message( const char * msg,
+                                  const double & version );
+
+private:
+
+    /*!
+      \brief get the stored data
+      \param key message hash value
+      \return pointer to the stored data, or NULL if not found.
+     */
+    const
+    std::string * find( const boost::uint32_t key ) const;
+
+    /*!
+      \brief store the binary data
+      \param key message hash value
+      \param blob binary data
+     */
+    void store( const boost::uint32_t key,
+                const std::string & blob );
+};
+
+}
+
+#endif
@@ -445,4 +445,24 @@ PlayerParam::toStr() const
     return os.str();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PlayerParam::writeBinary( std::ostream & os ) const
+{
+    return M_param_map->writeBinary( os );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PlayerParam::readBinary( std::istream & is )
+{
+    return M_param_map->readBinary( is );
+}
+
 }
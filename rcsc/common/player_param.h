@@ -36,6 +36,8 @@
 
 #include <boost/scoped_ptr.hpp>
 
+#include <iostream>
+
 namespace rcsc {
 
 namespace rcg {
@@ -194,6 +196,20 @@ public:
      */
     std::string toStr() const;
 
+    /*!
+      \brief write all parameter values to the binary stream
+      \param os reference to the binary output stream
+      \return true if successfully written
+     */
+    bool writeBinary( std::ostream & os ) const;
+
+    /*!
+      \brief read parameter values written by writeBinary()
+      \param is reference to the binary input stream
+      \return true if successfully read
+     */
+    bool readBinary( std::istream & is );
+
 
     /*!
       \brief get the number of player types
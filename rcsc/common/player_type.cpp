@@ -37,6 +37,7 @@
 #include "player_param.h"
 #include "server_param.h"
 
+#include <rcsc/param/param_map.h>
 #include <rcsc/rcg/util.h>
 
 #include <sstream>
@@ -229,6 +230,55 @@ PlayerType::toStr() const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+PlayerType::writeBinary( std::ostream & os ) const
+{
+    write_binary_value( os, M_id );
+    write_binary_value( os, M_player_speed_max );
+    write_binary_value( os, M_stamina_inc_max );
+    write_binary_value( os, M_player_decay );
+    write_binary_value( os, M_inertia_moment );
+    write_binary_value( os, M_dash_power_rate );
+    write_binary_value( os, M_player_size );
+    write_binary_value( os, M_kickable_margin );
+    write_binary_value( os, M_kick_rand );
+    write_binary_value( os, M_extra_stamina );
+    write_binary_value( os, M_effort_max );
+    return write_binary_value( os, M_effort_min );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PlayerType::readBinary( const ServerParam & sparam,
+                        std::istream & is )
+{
+    if ( ! read_binary_value( is, M_id )
+         || ! read_binary_value( is, M_player_speed_max )
+         || ! read_binary_value( is, M_stamina_inc_max )
+         || ! read_binary_value( is, M_player_decay )
+         || ! read_binary_value( is, M_inertia_moment )
+         || ! read_binary_value( is, M_dash_power_rate )
+         || ! read_binary_value( is, M_player_size )
+         || ! read_binary_value( is, M_kickable_margin )
+         || ! read_binary_value( is, M_kick_rand )
+         || ! read_binary_value( is, M_extra_stamina )
+         || ! read_binary_value( is, M_effort_max )
+         || ! read_binary_value( is, M_effort_min ) )
+    {
+        return false;
+    }
+
+    initAdditionalParams( sparam );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 PlayerType::parseV8( const char * msg )
@@ -161,6 +161,24 @@ public:
      */
     std::string toStr() const;
 
+    /*!
+      \brief write the base parameters to the binary stream
+      \param os reference to the binary output stream
+      \return true if successfully written
+     */
+    bool writeBinary( std::ostream & os ) const;
+
+    /*!
+      \brief read the base parameters written by writeBinary()
+      \param sparam const reference to the ServerParam
+      \param is reference to the binary input stream
+      \return true if successfully read
+
+      Additional parameters are recalculated after reading.
+     */
+    bool readBinary( const ServerParam & sparam,
+                     std::istream & is );
+
 private:
 
     /*!
@@ -247,11 +247,9 @@ InterceptMessageParser::parse( const int sender,
     }
     ++msg;
 
-    AudioCodec::CharToIntCont::const_iterator unum_it
-        = AudioCodec::i().charToIntMap().find( *msg );
-    if ( unum_it == AudioCodec::i().charToIntMap().end()
-         || unum_it->second <= 0
-         || MAX_PLAYER*2 < unum_it->second )
+    const int unum = AudioCodec::i().charToInt( *msg );
+    if ( unum <= 0
+         || MAX_PLAYER*2 < unum )
     {
         std::cerr << "InterceptMessageParser::parse() "
                   << " Illegal player number. message = [" << msg << "]"
@@ -263,9 +261,8 @@ InterceptMessageParser::parse( const int sender,
     }
     ++msg;
 
-    AudioCodec::CharToIntCont::const_iterator cycle
-        = AudioCodec::i().charToIntMap().find( *msg );
-    if ( cycle == AudioCodec::i().charToIntMap().end() )
+    const int cycle = AudioCodec::i().charToInt( *msg );
+    if ( cycle < 0 )
     {
         std::cerr << "InterceptMessageParser::parse() "
                   << " Illegal cycle. message = [" << msg << "]"
@@ -278,9 +275,9 @@ InterceptMessageParser::parse( const int sender,
 
     dlog.addText( Logger::SENSOR,
                   "InterceptMessageParser: success! number=%d cycle=%d",
-                  unum_it->second, cycle->second );
+                  unum, cycle );
 
-    M_memory->setIntercept( sender, unum_it->second, cycle->second, current );
+    M_memory->setIntercept( sender, unum, cycle, current );
 
     return slength();
 }
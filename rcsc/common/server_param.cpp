@@ -1476,4 +1476,28 @@ ServerParam::toStr() const
     return os.str();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ServerParam::writeBinary( std::ostream & os ) const
+{
+    return M_param_map->writeBinary( os );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ServerParam::readBinary( std::istream & is )
+{
+    const bool result = M_param_map->readBinary( is );
+
+    setAdditionalParam();
+
+    return result;
+}
+
 }
@@ -37,6 +37,7 @@
 #include <boost/scoped_ptr.hpp>
 
 #include <string>
+#include <iostream>
 
 namespace rcsc {
 
@@ -682,6 +683,20 @@ public:
      */
     std::string toStr() const;
 
+    /*!
+      \brief write all parameter values to the binary stream
+      \param os reference to the binary output stream
+      \return true if successfully written
+     */
+    bool writeBinary( std::ostream & os ) const;
+
+    /*!
+      \brief read parameter values written by writeBinary()
+      \param is reference to the binary input stream
+      \return true if successfully read
+     */
+    bool readBinary( std::istream & is );
+
 
     // static parameters
 
@@ -44,14 +44,79 @@ namespace rcsc {
 
  */
 Formation::Formation()
+    : M_cached_focus_point( Vector2D::INVALIDATED )
 {
     for ( int i = 0; i < 11; ++i )
     {
+        M_cached_valid[i] = false;
         M_synmetry_number[i] = -1;
     }
 }
 
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+Formation::getCachedPosition( const int unum,
+                              const Vector2D & focus_point ) const
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " *** ERROR *** invalid unum " << unum
+                  << std::endl;
+        return Vector2D::INVALIDATED;
+    }
+
+    if ( M_cached_focus_point != focus_point )
+    {
+        clearPositionCache();
+        M_cached_focus_point = focus_point;
+    }
+
+    if ( ! M_cached_valid[unum - 1] )
+    {
+        M_cached_positions[unum - 1] = getPosition( unum, focus_point );
+        M_cached_valid[unum - 1] = true;
+    }
+
+    return M_cached_positions[unum - 1];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Formation::getCachedPositions( const Vector2D & focus_point,
+                               std::vector< Vector2D > & positions ) const
+{
+    if ( M_cached_focus_point == focus_point
+         && std::find( M_cached_valid, M_cached_valid + 11, false )
+         == M_cached_valid + 11 )
+    {
+        positions.assign( M_cached_positions, M_cached_positions + 11 );
+        return;
+    }
+
+    getPositions( focus_point, positions );
+
+    if ( positions.size() != 11 )
+    {
+        clearPositionCache();
+        return;
+    }
+
+    M_cached_focus_point = focus_point;
+    for ( int i = 0; i < 11; ++i )
+    {
+        M_cached_positions[i] = positions[i];
+        M_cached_valid[i] = true;
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -164,6 +229,8 @@ Formation::updateRole( const int unum,
                        const int synmetry_unum,
                        const std::string & role_name )
 {
+    clearPositionCache();
+
     if ( getSynmetryNumber( unum ) != synmetry_unum )
     {
         if ( synmetry_unum == 0 )
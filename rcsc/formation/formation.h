@@ -36,6 +36,7 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
 #include <string>
 #include <list>
 #include <vector>
@@ -87,6 +88,14 @@ protected:
     */
     int M_synmetry_number[11];
 
+private:
+
+    //! focus point used to create M_cached_positions
+    mutable Vector2D M_cached_focus_point;
+    //! players' positions for M_cached_focus_point. index is (unum - 1)
+    mutable Vector2D M_cached_positions[11];
+    //! true if the element of M_cached_positions is computed
+    mutable bool M_cached_valid[11];
 
 public:
 
@@ -244,6 +253,42 @@ public:
     void getPositions( const Vector2D & focus_point,
                        std::vector< Vector2D > & positions ) const = 0;
 
+    /*!
+      \brief get position using the cached result of getPosition()
+      \param unum player number
+      \param focus_point current focus point, usually ball position.
+      \return player's position
+
+      Only the requested player's position is computed when it is not
+      cached for focus_point. Successive calls with the same focus point
+      and the same unum only read the cached position.
+     */
+    Vector2D getCachedPosition( const int unum,
+                                const Vector2D & focus_point ) const;
+
+    /*!
+      \brief get all players' positions using the cache
+      \param focus_point current focus point, usually ball position.
+      \param positions reference to the result container
+
+      All players' positions are computed by getPositions() at once
+      unless all of them are already cached for focus_point.
+     */
+    void getCachedPositions( const Vector2D & focus_point,
+                             std::vector< Vector2D > & positions ) const;
+
+    /*!
+      \brief clear the cached positions.
+
+      This method has to be called when the formation parameters are
+      modified by other than train(), read() and updateRole().
+     */
+    void clearPositionCache() const
+      {
+          M_cached_focus_point = Vector2D::INVALIDATED;
+          std::fill( M_cached_valid, M_cached_valid + 11, false );
+      }
+
     /*!
       \brief update formation paramter using training data set
       \param train_data training data container
@@ -34,6 +34,7 @@
 #endif
 
 #include "formation_bpn.h"
+#include "parallel_trainer.h"
 
 #include <rcsc/math_util.h>
 
@@ -475,6 +476,8 @@ FormationBPN::getPositions( const Vector2D & focus_point,
 void
 FormationBPN::train( const std::list< Snapshot > & train_data )
 {
+    clearPositionCache();
+
     if ( train_data.empty() )
     {
         return;
@@ -485,6 +488,13 @@ FormationBPN::train( const std::list< Snapshot > & train_data )
 
     std::cerr << "FormationBPN::train. Started!!" << std::endl;
 
+    typedef NetTrainTask< FormationBPN::Param::PosNet,
+                          FormationBPN::Param::PosNet::input_array,
+                          FormationBPN::Param::PosNet::output_array > TrainTask;
+
+    ParallelTrainer trainer;
+    std::vector< boost::shared_ptr< TrainTask > > tasks;
+
     for ( int unum = 1; unum <= 11; ++unum )
     {
         int number = unum;
@@ -519,89 +529,68 @@ FormationBPN::train( const std::list< Snapshot > & train_data )
 
         FormationBPN::Param::PosNet & net = param->getParam();
 
+        boost::shared_ptr< TrainTask > task( new TrainTask( net, 5000, 0.003 ) );
+        task->reserve( train_data.size() );
+        task->log() << "  Training. player " << unum << '\n';
+
         FormationBPN::Param::PosNet::input_array input;
         FormationBPN::Param::PosNet::output_array teacher;
 
+        bool reversed = false;
         const std::list< Formation::Snapshot >::const_iterator snap_end
             = train_data.end();
-        int loop = 0;
-        double ave_err = 0.0;
-        double max_err = 0.0;
-        bool success = false;
-        while ( ++loop <= 5000 )
+        for ( std::list< Formation::Snapshot >::const_iterator snap
+                  = train_data.begin();
+              snap != snap_end;
+              ++snap )
         {
-            ave_err = 0.0;
-            max_err = 0.0;
-            double snap_count = 1.0;
-            for ( std::list< Formation::Snapshot >::const_iterator snap
-                      = train_data.begin();
-                  snap != snap_end;
-                  ++snap, snap_count += 1.0 )
-            {
-                double by = snap->ball_.y;
-                double py = snap->players_[unum - 1].y;
-
-                if ( type == Formation::CENTER
-                     && by > 0.0 )
-                {
-                    if ( loop == 2 )
-                    {
-                        std::cerr << "      unum " << unum
-                                  << "  training data Y is reversed"
-                                  << std::endl;
-                    }
-                    by *= -1.0;
-                    py *= -1.0;
-                }
-
-                input[0] = min_max( 0.0,
-                                    snap->ball_.x / PITCH_LENGTH + 0.5,
-                                    1.0 );
-                input[1] = min_max( 0.0,
-                                    by / PITCH_WIDTH + 0.5,
-                                    1.0 );
-                teacher[0] = min_max( 0.0,
-                                      snap->players_[unum - 1].x / PITCH_LENGTH + 0.5,
-                                      1.0 );
-                teacher[1] = std::max( 0.0,
-                                       std::min( py / PITCH_WIDTH + 0.5, 1.0 ) );
-
-                double err = net.train( input, teacher );
-                if ( max_err < err )
-                {
-                    max_err = err;
-                }
-                ave_err
-                    = ave_err * ( ( snap_count - 1.0 ) / snap_count )
-                    + err / snap_count;
-            }
-#if 0
-            if ( loop % 500 == 0 )
-            {
-                std::cerr << "      Training. player " << unum
-                          << "  counter " << loop << std::endl;
-            }
-#endif
-            if ( max_err < 0.003 )
+            double by = snap->ball_.y;
+            double py = snap->players_[unum - 1].y;
+
+            if ( type == Formation::CENTER
+                 && by > 0.0 )
             {
-                std::cerr << "  ----> converged. average err=" << ave_err
-                          << "  last max err=" << max_err
-                          << std::endl;
-                success = true;
-                //printMessageWithTime( "train. converged. loop=%d", loop );
-                break;
+                reversed = true;
+                by *= -1.0;
+                py *= -1.0;
             }
+
+            input[0] = min_max( 0.0,
+                                snap->ball_.x / PITCH_LENGTH + 0.5,
+                                1.0 );
+            input[1] = min_max( 0.0,
+                                by / PITCH_WIDTH + 0.5,
+                                1.0 );
+            teacher[0] = min_max( 0.0,
+                                  snap->players_[unum - 1].x / PITCH_LENGTH + 0.5,
+                                  1.0 );
+            teacher[1] = std::max( 0.0,
+                                   std::min( py / PITCH_WIDTH + 0.5, 1.0 ) );
+
+            task->addSample( input, teacher );
         }
-        if ( ! success )
+
+        if ( reversed )
         {
-            std::cerr << "  *** Failed to converge *** " << std::endl;
-            //printMessageWithTime( "train. Failed to converge. player %d", unum );
+            task->log() << "      unum " << unum
+                        << "  training data Y is reversed"
+                        << '\n';
         }
-        std::cerr << "  ----> " << loop
-                  << " loop. last average err=" << ave_err
-                  << "  last max err=" << max_err
-                  << std::endl;
+
+        trainer.addTask( task );
+        tasks.push_back( task );
+    }
+
+    // each player's network is trained independently.
+    trainer.run();
+
+    for ( std::vector< boost::shared_ptr< TrainTask > >::const_iterator it = tasks.begin();
+          it != tasks.end();
+          ++it )
+    {
+        (*it)->printLog( std::cerr );
     }
+
     std::cerr << "FormationBPN::train. Ended!!" << std::endl;
 }
 
@@ -684,6 +673,8 @@ FormationBPN::param( const int unum ) const
 bool
 FormationBPN::read( std::istream & is )
 {
+    clearPositionCache();
+
     int n_line = 0;
 
     n_line += readName( is );
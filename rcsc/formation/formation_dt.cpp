@@ -444,6 +444,8 @@ FormationDT::interpolate( const int unum,
 void
 FormationDT::train( const std::list< Snapshot > & train_data )
 {
+    clearPositionCache();
+
     Rect2D pitch( - 60.0, - 45.0,
                   120.0, 90.0 );
     M_triangulation.init( pitch );
@@ -470,6 +472,8 @@ FormationDT::train( const std::list< Snapshot > & train_data )
 bool
 FormationDT::read( std::istream & is )
 {
+    clearPositionCache();
+
     M_param.clear();
 
     int n_line = 0;
@@ -0,0 +1,372 @@
+// -*-c++-*-
+
+/*!
+	\file formation_grid.cpp
+	\brief rasterized formation table Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_grid.h"
+
+#include <algorithm>
+#include <string>
+#include <cmath>
+
+namespace rcsc {
+
+const double FormationGrid::MIN_X = -54.0;
+const double FormationGrid::MAX_X = +54.0;
+const double FormationGrid::MIN_Y = -36.0;
+const double FormationGrid::MAX_Y = +36.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormationGrid::FormationGrid( FormationPtr formation,
+                              const double & step )
+    : Formation()
+    , M_formation( formation )
+    , M_step( std::max( 0.1, step ) )
+    , M_size_x( static_cast< int >( std::ceil( ( MAX_X - MIN_X ) / M_step ) ) + 1 )
+    , M_size_y( static_cast< int >( std::ceil( ( MAX_Y - MIN_Y ) / M_step ) ) + 1 )
+{
+    createTable();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Formation::Snapshot
+FormationGrid::createDefaultParam()
+{
+    Snapshot snap = M_formation->createDefaultParam();
+    createTable();
+    return snap;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FormationGrid::createNewRole( const int,
+                              const std::string &,
+                              const SideType )
+{
+    std::cerr << __FILE__ << ":" << __LINE__
+              << " ***ERROR*** FormationGrid cannot create a role."
+              << " edit the original formation."
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FormationGrid::setRoleName( const int,
+                            const std::string & )
+{
+    std::cerr << __FILE__ << ":" << __LINE__
+              << " ***ERROR*** FormationGrid cannot set a role name."
+              << " edit the original formation."
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FormationGrid::createTable()
+{
+    clearPositionCache();
+
+    for ( int unum = 1; unum <= 11; ++unum )
+    {
+        M_synmetry_number[unum - 1] = M_formation->getSynmetryNumber( unum );
+    }
+
+    M_table.assign( M_size_x * M_size_y * 11 * 2, 0.0f );
+
+    std::vector< Vector2D > positions;
+    positions.reserve( 11 );
+
+    std::vector< float >::iterator it = M_table.begin();
+    for ( int iy = 0; iy < M_size_y; ++iy )
+    {
+        const double y = MIN_Y + M_step * iy;
+        for ( int ix = 0; ix < M_size_x; ++ix )
+        {
+            const double x = MIN_X + M_step * ix;
+
+            M_formation->getPositions( Vector2D( x, y ), positions );
+            positions.resize( 11, Vector2D( 0.0, 0.0 ) );
+
+            for ( int i = 0; i < 11; ++i )
+            {
+                *it++ = static_cast< float >( positions[i].x );
+                *it++ = static_cast< float >( positions[i].y );
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FormationGrid::getCell( const Vector2D & focus_point,
+                        int & index,
+                        double & tx,
+                        double & ty ) const
+{
+    double fx = ( focus_point.x - MIN_X ) / M_step;
+    double fy = ( focus_point.y - MIN_Y ) / M_step;
+
+    fx = std::min( std::max( 0.0, fx ), static_cast< double >( M_size_x - 1 ) );
+    fy = std::min( std::max( 0.0, fy ), static_cast< double >( M_size_y - 1 ) );
+
+    int ix = std::min( static_cast< int >( fx ), M_size_x - 2 );
+    int iy = std::min( static_cast< int >( fy ), M_size_y - 2 );
+
+    tx = fx - ix;
+    ty = fy - iy;
+    index = ( iy * M_size_x + ix ) * 22;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+FormationGrid::getPosition( const int unum,
+                            const Vector2D & focus_point ) const
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " *** ERROR *** Illegal unum " << unum
+                  << std::endl;
+        return Vector2D::INVALIDATED;
+    }
+
+    int index = 0;
+    double tx = 0.0, ty = 0.0;
+    getCell( focus_point, index, tx, ty );
+
+    const float * p00 = &M_table[index + ( unum - 1 ) * 2];
+    const float * p10 = p00 + 22;
+    const float * p01 = p00 + M_size_x * 22;
+    const float * p11 = p01 + 22;
+
+    const double w00 = ( 1.0 - tx ) * ( 1.0 - ty );
+    const double w10 = tx * ( 1.0 - ty );
+    const double w01 = ( 1.0 - tx ) * ty;
+    const double w11 = tx * ty;
+
+    return Vector2D( p00[0] * w00 + p10[0] * w10 + p01[0] * w01 + p11[0] * w11,
+                     p00[1] * w00 + p10[1] * w10 + p01[1] * w01 + p11[1] * w11 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FormationGrid::getPositions( const Vector2D & focus_point,
+                             std::vector< Vector2D > & positions ) const
+{
+    positions.clear();
+
+    int index = 0;
+    double tx = 0.0, ty = 0.0;
+    getCell( focus_point, index, tx, ty );
+
+    const float * p00 = &M_table[index];
+    const float * p10 = p00 + 22;
+    const float * p01 = p00 + M_size_x * 22;
+    const float * p11 = p01 + 22;
+
+    const double w00 = ( 1.0 - tx ) * ( 1.0 - ty );
+    const double w10 = tx * ( 1.0 - ty );
+    const double w01 = ( 1.0 - tx ) * ty;
+    const double w11 = tx * ty;
+
+    for ( int i = 0; i < 22; i += 2 )
+    {
+        positions.push_back( Vector2D( p00[i] * w00 + p10[i] * w10
+                                       + p01[i] * w01 + p11[i] * w11,
+                                       p00[i+1] * w00 + p10[i+1] * w10
+                                       + p01[i+1] * w01 + p11[i+1] * w11 ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FormationGrid::train( const std::list< Snapshot > & train_data )
+{
+    M_formation->train( train_data );
+    createTable();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FormationGrid::read( std::istream & is )
+{
+    if ( ! M_formation->read( is ) )
+    {
+        return false;
+    }
+
+    createTable();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+FormationGrid::print( std::ostream & os ) const
+{
+    return M_formation->print( os );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+FormationGrid::checkError( double & max_error,
+                           double & average_error ) const
+{
+    max_error = 0.0;
+    average_error = 0.0;
+
+    std::vector< Vector2D > exact;
+    std::vector< Vector2D > interpolated;
+
+    int count = 0;
+    double sum_error = 0.0;
+
+    for ( int iy = 0; iy < M_size_y - 1; ++iy )
+    {
+        const double y = MIN_Y + M_step * ( iy + 0.5 );
+        for ( int ix = 0; ix < M_size_x - 1; ++ix )
+        {
+            const Vector2D ball( MIN_X + M_step * ( ix + 0.5 ), y );
+
+            M_formation->getPositions( ball, exact );
+            getPositions( ball, interpolated );
+
+            const std::size_t size = std::min( exact.size(), interpolated.size() );
+            for ( std::size_t i = 0; i < size; ++i )
+            {
+                double err = exact[i].dist( interpolated[i] );
+                max_error = std::max( max_error, err );
+                sum_error += err;
+                ++count;
+            }
+        }
+    }
+
+    if ( count > 0 )
+    {
+        average_error = sum_error / count;
+    }
+
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FormationGrid::writeTable( std::ostream & os ) const
+{
+    os << "FormationGrid " << M_step
+       << ' ' << M_size_x << ' ' << M_size_y << '\n';
+    os.write( reinterpret_cast< const char * >( &M_table[0] ),
+              M_table.size() * sizeof( float ) );
+    return os.good();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FormationGrid::readTable( std::istream & is )
+{
+    std::string tag;
+    double step = 0.0;
+    int size_x = 0, size_y = 0;
+
+    if ( ! ( is >> tag >> step >> size_x >> size_y )
+         || tag != "FormationGrid"
+         || std::fabs( step - M_step ) > 1.0e-6
+         || size_x != M_size_x
+         || size_y != M_size_y )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** mismatched formation grid header."
+                  << std::endl;
+        return false;
+    }
+
+    is.get(); // skip the new line
+
+    std::vector< float > table( M_table.size() );
+    if ( ! is.read( reinterpret_cast< char * >( &table[0] ),
+                    table.size() * sizeof( float ) ) )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** too short formation grid table."
+                  << std::endl;
+        return false;
+    }
+
+    M_table.swap( table );
+    clearPositionCache();
+    return true;
+}
+
+}
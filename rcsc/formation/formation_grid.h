@@ -0,0 +1,253 @@
+// -*-c++-*-
+
+/*!
+	\file formation_grid.h
+	\brief rasterized formation table Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_FORMATION_FORMATION_GRID_H
+#define RCSC_FORMATION_FORMATION_GRID_H
+
+#include <rcsc/formation/formation.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <vector>
+
+namespace rcsc {
+
+/*!
+  \class FormationGrid
+  \brief rasterized table of another formation
+
+  All players' positions of the original formation are sampled at the
+  ball positions on a regular grid. Positions are looked up by bilinear
+  interpolation of the nearest four grid points, so the cost does not
+  depend on the original formation method.
+
+  Role information, read() and print() are delegated to the original
+  formation. The table is rebuilt after read() and train().
+ */
+class FormationGrid
+    : public Formation {
+public:
+
+    //! minimal x of the grid
+    static const double MIN_X;
+    //! maximal x of the grid
+    static const double MAX_X;
+    //! minimal y of the grid
+    static const double MIN_Y;
+    //! maximal y of the grid
+    static const double MAX_Y;
+
+private:
+
+    //! the original formation
+    FormationPtr M_formation;
+
+    //! grid step
+    double M_step;
+    //! the number of grid points along x axis
+    int M_size_x;
+    //! the number of grid points along y axis
+    int M_size_y;
+
+    /*!
+      positions table. the index of player unum at grid (ix, iy) is
+      ( ( iy * M_size_x + ix ) * 11 + unum - 1 ) * 2
+     */
+    std::vector< float > M_table;
+
+public:
+
+    /*!
+      \brief create the table of the original formation
+      \param formation the original formation
+      \param step grid step. the minimal value is 0.1.
+     */
+    FormationGrid( FormationPtr formation,
+                   const double & step );
+
+    /*!
+      \brief get the original formation
+      \return const reference to the formation pointer
+     */
+    const FormationPtr & formation() const
+      {
+          return M_formation;
+      }
+
+    /*!
+      \brief get the grid step
+      \return grid step value
+     */
+    const double & step() const
+      {
+          return M_step;
+      }
+
+    /*!
+      \brief get the name of the original formation
+      \return name string
+     */
+    virtual
+    std::string methodName() const
+      {
+          return M_formation->methodName();
+      }
+
+    /*!
+      \brief create default formation of the original formation
+      \return snapshot variable for the initial state(ball pos=(0,0)).
+     */
+    virtual
+    Snapshot createDefaultParam();
+
+protected:
+
+    /*!
+      \brief not supported. role parameter has to be edited in the
+      original formation.
+     */
+    virtual
+    void createNewRole( const int unum,
+                        const std::string & role_name,
+                        const SideType type );
+
+    /*!
+      \brief not supported. role parameter has to be edited in the
+      original formation.
+     */
+    virtual
+    void setRoleName( const int unum,
+                      const std::string & name );
+
+public:
+
+    /*!
+      \brief get the role name of the specified player
+      \param unum target player's number
+      \return role name string of the original formation
+     */
+    virtual
+    std::string getRoleName( const int unum ) const
+      {
+          return M_formation->getRoleName( unum );
+      }
+
+    /*!
+      \brief get interpolated position for the current focus point
+      \param unum player number
+      \param focus_point current focus point, usually ball position.
+     */
+    virtual
+    Vector2D getPosition( const int unum,
+                          const Vector2D & focus_point ) const;
+
+    /*
+      \brief get all interpolated positions for the current focus point
+      \param focus_point current focus point, usually ball position
+      \param positions contaner to store the result
+     */
+    virtual
+    void getPositions( const Vector2D & focus_point,
+                       std::vector< Vector2D > & positions ) const;
+
+    /*!
+      \brief train the original formation and rebuild the table
+      \param train_data training data container
+     */
+    virtual
+    void train( const std::list< Snapshot > & train_data );
+
+    /*!
+      \brief read the original formation and rebuild the table
+      \param is reference to the input stream.
+      \return parsing result
+     */
+    virtual
+    bool read( std::istream & is );
+
+    /*!
+      \brief put the original formation to the output stream
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    virtual
+    std::ostream & print( std::ostream & os ) const;
+
+    /*!
+      \brief compare the interpolated positions with the original formation.
+      \param max_error reference to the variable to store the maximal error
+      \param average_error reference to the variable to store the average error
+      \return the number of checked positions
+
+      Errors are measured at the center of each grid cell, where the
+      interpolation error is usually largest.
+     */
+    int checkError( double & max_error,
+                    double & average_error ) const;
+
+    /*!
+      \brief write the table in the binary format
+      \param os reference to the output stream
+      \return true if successfully written
+     */
+    bool writeTable( std::ostream & os ) const;
+
+    /*!
+      \brief restore the table written by writeTable()
+      \param is reference to the input stream
+      \return true if the table is read and its grid matches this object.
+     */
+    bool readTable( std::istream & is );
+
+private:
+
+    /*!
+      \brief sample the original formation at all grid points
+     */
+    void createTable();
+
+    /*!
+      \brief get the cell index and the weights for bilinear interpolation
+      \param focus_point ball position
+      \param index reference to the variable to store the index of the
+      bottom left grid point
+      \param tx reference to the variable to store the x weight
+      \param ty reference to the variable to store the y weight
+     */
+    void getCell( const Vector2D & focus_point,
+                  int & index,
+                  double & tx,
+                  double & ty ) const;
+
+};
+
+}
+
+#endif
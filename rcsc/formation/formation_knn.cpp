@@ -333,25 +333,6 @@ FormationKNN::createNewRole( const int unum,
 }
 
 
-/*-------------------------------------------------------------------*/
-
-class DataCmp {
-private:
-    const Vector2D M_point;
-public:
-
-    DataCmp( const Vector2D & point )
-        : M_point( point )
-      { }
-
-    bool operator()( const FormationKNN::Data * lhs,
-                     const FormationKNN::Data * rhs )
-      {
-          return lhs->ball_.dist2( M_point ) < rhs->ball_.dist2( M_point );
-      }
-};
-
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -368,55 +349,32 @@ FormationKNN::getPosition( const int unum,
         return Vector2D::INVALIDATED;
     }
 
-    if ( M_data_ptr.empty() )
+    if ( M_tree.empty() )
     {
         return Vector2D( 0.0, 0.0 );
     }
 
-    const size_t size = std::min( M_data_ptr.size(), M_k );
+    std::vector< std::pair< double, const Data * > > neighbors;
+    findNearestData( focus_point, neighbors );
 
-    std::partial_sort( M_data_ptr.begin(),
-                       M_data_ptr.begin() + size,
-                       M_data_ptr.end(),
-                       DataCmp( focus_point ) );
+    const size_t size = neighbors.size();
 
-    std::vector< double > inv_dist2( size, 0.0 );
-    double sum_inv_dist2 = 0.0;
-
-    for ( size_t i = 0; i < size; ++i )
+    if ( neighbors.front().first < 1.0e-10 )
     {
-        double d2 = M_data_ptr[i]->ball_.dist2( focus_point );
-        if ( d2 < 1.0e-10 )
-        {
-            return M_data_ptr[i]->getPosition( unum );
-        }
-        inv_dist2[i] = 1.0 / d2;
-        sum_inv_dist2 += inv_dist2[i];
+        return neighbors.front().second->getPosition( unum );
     }
 
     Vector2D pos( 0.0, 0.0 );
+    double sum_inv_dist2 = 0.0;
 
     for ( size_t i = 0; i < size; ++i )
     {
-        pos += M_data_ptr[i]->getPosition( unum ) * inv_dist2[i];
+        double inv_dist2 = 1.0 / neighbors[i].first;
+        pos += neighbors[i].second->getPosition( unum ) * inv_dist2;
+        sum_inv_dist2 += inv_dist2;
     }
 
     pos /= sum_inv_dist2;
-#if 0
-    if ( unum == 11 )
-    {
-        std::cerr << "sum_inv_dist2=" << sum_inv_dist2 << '\n';
-        for ( size_t i = 0; i < size; ++i )
-        {
-            std::cerr << "  ball=" << M_data_ptr[i]->ball_
-                      << " pos=" << M_data_ptr[i]->getPosition( unum )
-                      << " inv_dist2=" << inv_dist2[i]
-                      << " rate=" << ( inv_dist2[i] / sum_inv_dist2 )
-                      << '\n';
-        }
-        std::cerr << "  pos = " << pos << std::endl;
-    }
-#endif
     return pos;
 }
 
@@ -430,20 +388,31 @@ FormationKNN::getPositions( const Vector2D & focus_point,
 {
     positions.clear();
 
-    const size_t size = std::min( M_data_ptr.size(), M_k );
+    if ( M_tree.empty() )
+    {
+        positions.assign( 11, Vector2D( 0.0, 0.0 ) );
+        return;
+    }
+
+    // same weighting as getPosition(), but the neighbors are searched once.
+    std::vector< std::pair< double, const Data * > > neighbors;
+    findNearestData( focus_point, neighbors );
+
+    const size_t size = neighbors.size();
 
-    std::partial_sort( M_data_ptr.begin(),
-                       M_data_ptr.begin() + size,
-                       M_data_ptr.end(),
-                       DataCmp( focus_point ) );
+    if ( neighbors.front().first < 1.0e-10 )
+    {
+        positions = neighbors.front().second->players_;
+        return;
+    }
 
-    std::vector< double > dist( size, 0.0 );
-    double sum_dist = 0.0;
+    std::vector< double > inv_dist2( size, 0.0 );
+    double sum_inv_dist2 = 0.0;
 
     for ( size_t i = 0; i < size; ++i )
     {
-        dist[i] = M_data_ptr[i]->ball_.dist( focus_point );
-        sum_dist += dist[i];
+        inv_dist2[i] = 1.0 / neighbors[i].first;
+        sum_inv_dist2 += inv_dist2[i];
     }
 
     for ( int unum = 1; unum <= 11; ++unum )
@@ -452,13 +421,167 @@ FormationKNN::getPositions( const Vector2D & focus_point,
 
         for ( size_t i = 0; i < size; ++i )
         {
-            pos += M_data_ptr[i]->getPosition( unum ) * ( ( sum_dist - dist[i] ) / sum_dist );
+            pos += neighbors[i].second->getPosition( unum ) * inv_dist2[i];
         }
 
+        pos /= sum_inv_dist2;
         positions.push_back( pos );
     }
 }
 
+/*-------------------------------------------------------------------*/
+
+namespace {
+
+/*!
+  \brief compare the data by the ball position on the split axis
+ */
+class AxisCmp {
+private:
+    const int M_axis;
+public:
+
+    explicit
+    AxisCmp( const int axis )
+        : M_axis( axis )
+      { }
+
+    bool operator()( const FormationKNN::Data * lhs,
+                     const FormationKNN::Data * rhs ) const
+      {
+          return ( M_axis == 0
+                   ? lhs->ball_.x < rhs->ball_.x
+                   : lhs->ball_.y < rhs->ball_.y );
+      }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationKNN::createTree()
+{
+    M_tree.clear();
+    M_tree.reserve( M_data.size() );
+
+    for ( std::vector< Data >::const_iterator it = M_data.begin();
+          it != M_data.end();
+          ++it )
+    {
+        M_tree.push_back( &(*it) );
+    }
+
+    createTree( 0, M_tree.size(), 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationKNN::createTree( const std::size_t first,
+                          const std::size_t last,
+                          const int depth )
+{
+    if ( last - first <= 1 )
+    {
+        return;
+    }
+
+    const std::size_t mid = ( first + last ) / 2;
+
+    std::nth_element( M_tree.begin() + first,
+                      M_tree.begin() + mid,
+                      M_tree.begin() + last,
+                      AxisCmp( depth % 2 ) );
+
+    createTree( first, mid, depth + 1 );
+    createTree( mid + 1, last, depth + 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationKNN::findNearestData( const Vector2D & focus_point,
+                               std::vector< std::pair< double, const Data * > > & neighbors ) const
+{
+    neighbors.clear();
+    neighbors.reserve( M_k + 1 );
+
+    findNearestData( focus_point, 0, M_tree.size(), 0, neighbors );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationKNN::findNearestData( const Vector2D & focus_point,
+                               const std::size_t first,
+                               const std::size_t last,
+                               const int depth,
+                               std::vector< std::pair< double, const Data * > > & neighbors ) const
+{
+    if ( first >= last )
+    {
+        return;
+    }
+
+    const std::size_t mid = ( first + last ) / 2;
+    const Data * node = M_tree[mid];
+
+    //
+    // check the node. neighbors are kept sorted by the distance.
+    //
+    const double d2 = node->ball_.dist2( focus_point );
+    if ( neighbors.size() < M_k
+         || d2 < neighbors.back().first )
+    {
+        std::vector< std::pair< double, const Data * > >::iterator it = neighbors.end();
+        while ( it != neighbors.begin()
+                && d2 < ( it - 1 )->first )
+        {
+            --it;
+        }
+        neighbors.insert( it, std::make_pair( d2, node ) );
+        if ( neighbors.size() > M_k )
+        {
+            neighbors.pop_back();
+        }
+    }
+
+    //
+    // search the near side first, then the far side if it can contain the closer data.
+    //
+    const double diff = ( depth % 2 == 0
+                          ? focus_point.x - node->ball_.x
+                          : focus_point.y - node->ball_.y );
+
+    if ( diff < 0.0 )
+    {
+        findNearestData( focus_point, first, mid, depth + 1, neighbors );
+        if ( neighbors.size() < M_k
+             || diff * diff < neighbors.back().first )
+        {
+            findNearestData( focus_point, mid + 1, last, depth + 1, neighbors );
+        }
+    }
+    else
+    {
+        findNearestData( focus_point, mid + 1, last, depth + 1, neighbors );
+        if ( neighbors.size() < M_k
+             || diff * diff < neighbors.back().first )
+        {
+            findNearestData( focus_point, first, mid, depth + 1, neighbors );
+        }
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -466,8 +589,9 @@ FormationKNN::getPositions( const Vector2D & focus_point,
 void
 FormationKNN::train( const std::list< Snapshot > & train_data )
 {
+    clearPositionCache();
+
     M_data.clear();
-    M_data_ptr.clear();
 
     M_data.reserve( train_data.size() );
 
@@ -479,14 +603,7 @@ FormationKNN::train( const std::list< Snapshot > & train_data )
         M_data.push_back( Data( *it ) );
     }
 
-    M_data.reserve( M_data.size() );
-
-    for ( std::vector< Data >::iterator it = M_data.begin();
-          it != M_data.end();
-          ++it )
-    {
-        M_data_ptr.push_back( &(*it) );
-    }
+    createTree();
 }
 
 /*-------------------------------------------------------------------*/
@@ -496,7 +613,10 @@ FormationKNN::train( const std::list< Snapshot > & train_data )
 bool
 FormationKNN::read( std::istream & is )
 {
+    clearPositionCache();
+
     M_data.clear();
+    M_tree.clear();
 
     int n_line = 0;
 
@@ -640,15 +760,7 @@ FormationKNN::readSamples( std::istream & is )
         }
     }
 
-
-    M_data_ptr.reserve( M_data.size() );
-
-    for ( std::vector< Data >::iterator it = M_data.begin();
-          it != M_data.end();
-          ++it )
-    {
-        M_data_ptr.push_back( &(*it) );
-    }
+    createTree();
 
     return true;
 }
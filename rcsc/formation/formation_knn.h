@@ -34,6 +34,8 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
+#include <utility>
 
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/formation/formation.h>
@@ -104,8 +106,12 @@ private:
     //! data instance container
     std::vector< Data > M_data;
 
-    //! data pointer container
-    mutable std::vector< Data * > M_data_ptr;
+    /*!
+      static k-d tree of the data. the median element of the range
+      [begin, end) is the node, and the split axis is x at even depth
+      and y at odd depth.
+     */
+    std::vector< const Data * > M_tree;
 
 public:
     /*!
@@ -260,6 +266,44 @@ private:
     */
     bool readSamples( std::istream & is );
 
+    /*!
+      \brief build the k-d tree from the current data.
+     */
+    void createTree();
+
+    /*!
+      \brief build the subtree recursively
+      \param first begin of the subtree range
+      \param last end of the subtree range
+      \param depth depth of the subtree root
+     */
+    void createTree( const std::size_t first,
+                     const std::size_t last,
+                     const int depth );
+
+    /*!
+      \brief find k nearest data from the focus point
+      \param focus_point search point
+      \param neighbors reference to the result container. the elements are
+      sorted by the squared distance.
+     */
+    void findNearestData( const Vector2D & focus_point,
+                          std::vector< std::pair< double, const Data * > > & neighbors ) const;
+
+    /*!
+      \brief search the subtree recursively
+      \param focus_point search point
+      \param first begin of the subtree range
+      \param last end of the subtree range
+      \param depth depth of the subtree root
+      \param neighbors reference to the result container.
+     */
+    void findNearestData( const Vector2D & focus_point,
+                          const std::size_t first,
+                          const std::size_t last,
+                          const int depth,
+                          std::vector< std::pair< double, const Data * > > & neighbors ) const;
+
 };
 
 }
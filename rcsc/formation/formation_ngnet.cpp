@@ -34,6 +34,7 @@
 #endif
 
 #include "formation_ngnet.h"
+#include "parallel_trainer.h"
 
 #include <rcsc/math_util.h>
 
@@ -449,6 +450,8 @@ FormationNGNet::getPositions( const Vector2D & focus_point,
 void
 FormationNGNet::train( const std::list< Snapshot > & train_data )
 {
+    clearPositionCache();
+
     if ( train_data.empty() )
     {
         return;
@@ -456,6 +459,13 @@ FormationNGNet::train( const std::list< Snapshot > & train_data )
 
     std::cerr << "FormationNGNet::train. Started!!" << std::endl;
 
+    typedef NetTrainTask< NGNet,
+                          NGNet::input_vector,
+                          NGNet::output_vector > TrainTask;
+
+    ParallelTrainer trainer;
+    std::vector< boost::shared_ptr< TrainTask > > tasks;
+
     for ( int unum = 1; unum <= 11; ++unum )
     {
         int number = unum;
@@ -510,83 +520,50 @@ FormationNGNet::train( const std::list< Snapshot > & train_data )
 
         net.printUnits( std::cerr );
 
+        boost::shared_ptr< TrainTask > task( new TrainTask( net, 5000, 0.001 ) );
+        task->reserve( train_data.size() );
+        task->log() << "---------- FormationNGNet::train. " << unum << '\n';
+
         NGNet::input_vector input;
         NGNet::output_vector teacher;
 
         const std::list< Formation::Snapshot >::const_iterator snap_end
             = train_data.end();
-        int loop = 0;
-        double ave_err = 0.0;
-        double max_err = 0.0;
-        bool success = false;
-        while ( ++loop <= 5000 )
+        for ( std::list< Formation::Snapshot >::const_iterator snap
+                  = train_data.begin();
+              snap != snap_end;
+              ++snap )
         {
-            ave_err = 0.0;
-            max_err = 0.0;
-            double snap_count = 1.0;
-            for ( std::list< Formation::Snapshot >::const_iterator snap
-                      = train_data.begin();
-                  snap != snap_end;
-                  ++snap, snap_count += 1.0 )
-            {
-                /*
-                  input[0] = bound( 0.0,
-                  snap->ball_.x / PITCH_LENGTH + 0.5,
-                  1.0 );
-                  input[1] = bound( 0.0,
-                  snap->ball_.y / PITCH_WIDTH + 0.5,
-                  1.0 );
-                  teacher[0] = bound( 0.0,
-                  snap->players_[unum - 1].x / PITCH_LENGTH + 0.5,
-                  1.0 );
-                  teacher[1] = bound( 0.0,
-                  snap->players_[unum - 1].y / PITCH_WIDTH + 0.5,
-                  1.0 );
-                */
-                input[0] = snap->ball_.x;
-                input[1] = snap->ball_.y;
-                teacher[0] = snap->players_[unum - 1].x;
-                teacher[1] = snap->players_[unum - 1].y;
-
-                if ( loop == 2 )
-                {
-                    std::cerr << "  ----> " << unum
-                              << "  ball = " << input[0] << ", " << input[1]
-                              << "  teacher = " << teacher[0] << ", " << teacher[1]
-                              << std::endl;
-                }
-
-                double err = net.train( input, teacher );
-                if ( max_err < err )
-                {
-                    max_err = err;
-                }
-                ave_err
-                    = ave_err * ( ( snap_count - 1.0 ) / snap_count )
-                    + err / snap_count;
-            }
+            input[0] = snap->ball_.x;
+            input[1] = snap->ball_.y;
+            teacher[0] = snap->players_[unum - 1].x;
+            teacher[1] = snap->players_[unum - 1].y;
 
-            if ( max_err < 0.001 )
-            {
-                std::cerr << "  ----> converged. average err=" << ave_err
-                          << "  last max err=" << max_err
-                          << std::endl;
-                success = true;
-                //printMessageWithTime( "train. converged. loop=%d", loop );
-                break;
-            }
-        }
-        if ( ! success )
-        {
-            std::cerr << "  *** Failed to converge *** " << std::endl;
-            //printMessageWithTime( "train. Failed to converge. player %d", unum );
+            task->log() << "  ----> " << unum
+                        << "  ball = " << input[0] << ", " << input[1]
+                        << "  teacher = " << teacher[0] << ", " << teacher[1]
+                        << '\n';
+
+            task->addSample( input, teacher );
         }
-        std::cerr << "  ----> " << loop
-                  << " loop. last average err=" << ave_err
-                  << "  last max err=" << max_err
-                  << std::endl;
-        net.printUnits( std::cerr );
+
+        trainer.addTask( task );
+        tasks.push_back( task );
+    }
+
+    // each player's network is trained independently.
+    // new centers are added above on this thread,
+    // because the random number generator of units is shared.
+    trainer.run();
+
+    for ( std::vector< boost::shared_ptr< TrainTask > >::const_iterator it = tasks.begin();
+          it != tasks.end();
+          ++it )
+    {
+        (*it)->printLog( std::cerr );
+        (*it)->net().printUnits( std::cerr );
     }
+
     std::cerr << "FormationNGNet::train. Ended!!" << std::endl;
 }
 
@@ -659,6 +636,8 @@ FormationNGNet::param( const int unum ) const
 bool
 FormationNGNet::read( std::istream & is )
 {
+    clearPositionCache();
+
     int n_line = 0;
 
     n_line += readName( is );
@@ -564,6 +564,8 @@ FormationSBSP::getPosition( const int unum,
 void
 FormationSBSP::train( const std::list< Snapshot > & train_data )
 {
+    clearPositionCache();
+
 
 }
 
@@ -574,6 +576,8 @@ FormationSBSP::train( const std::list< Snapshot > & train_data )
 bool
 FormationSBSP::read( std::istream & is )
 {
+    clearPositionCache();
+
     int n_line = 0;
 
     n_line += readName( is );
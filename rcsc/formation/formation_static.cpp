@@ -200,6 +200,8 @@ FormationStatic::getPositions( const Vector2D & focus_point,
 void
 FormationStatic::train( const std::list< Snapshot > & train_data )
 {
+    clearPositionCache();
+
 
 
 }
@@ -211,6 +213,8 @@ FormationStatic::train( const std::list< Snapshot > & train_data )
 bool
 FormationStatic::read( std::istream & is )
 {
+    clearPositionCache();
+
     int n_line = 0;
 
     n_line += readName( is );
@@ -318,6 +318,8 @@ FormationUvA::getPositions( const Vector2D & focus_point,
 void
 FormationUvA::train( const std::list< Snapshot > & train_data )
 {
+    clearPositionCache();
+
 
 
 }
@@ -329,6 +331,8 @@ FormationUvA::train( const std::list< Snapshot > & train_data )
 bool
 FormationUvA::read( std::istream & is )
 {
+    clearPositionCache();
+
     int n_line = 0;
 
     n_line += readName( is );
@@ -0,0 +1,141 @@
+// -*-c++-*-
+
+/*!
+	\file parallel_trainer.cpp
+	\brief parallel training task runner Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "parallel_trainer.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace rcsc {
+
+int ParallelTrainer::S_max_threads = 11;
+
+namespace {
+
+/*!
+  \brief shared state of the worker threads
+ */
+struct TaskQueue {
+    //! tasks
+    const std::vector< ParallelTrainer::TaskPtr > * tasks_;
+    //! index of the next task
+    std::size_t next_;
+    //! mutex for next_
+    pthread_mutex_t mutex_;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void *
+run_tasks( void * arg )
+{
+    TaskQueue * queue = static_cast< TaskQueue * >( arg );
+
+    while ( 1 )
+    {
+        pthread_mutex_lock( &queue->mutex_ );
+        const std::size_t i = queue->next_++;
+        pthread_mutex_unlock( &queue->mutex_ );
+
+        if ( i >= queue->tasks_->size() )
+        {
+            break;
+        }
+
+        (*queue->tasks_)[i]->run();
+    }
+
+    return NULL;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ParallelTrainer::set_max_threads( const int n )
+{
+    S_max_threads = std::max( 1, n );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ParallelTrainer::run()
+{
+    TaskQueue queue;
+    queue.tasks_ = &M_tasks;
+    queue.next_ = 0;
+    pthread_mutex_init( &queue.mutex_, NULL );
+
+    const int n_threads = std::min( S_max_threads,
+                                    static_cast< int >( M_tasks.size() ) );
+
+    std::vector< pthread_t > threads;
+    for ( int i = 1; i < n_threads; ++i )
+    {
+        pthread_t t;
+        if ( pthread_create( &t, NULL, run_tasks, &queue ) != 0 )
+        {
+            std::cerr << __FILE__ << ":" << __LINE__
+                      << " ***WARNING*** failed to create a training thread."
+                      << std::endl;
+            break;
+        }
+        threads.push_back( t );
+    }
+
+    // the caller thread also executes the tasks.
+    run_tasks( &queue );
+
+    for ( std::vector< pthread_t >::iterator t = threads.begin();
+          t != threads.end();
+          ++t )
+    {
+        pthread_join( *t, NULL );
+    }
+
+    pthread_mutex_destroy( &queue.mutex_ );
+}
+
+}
@@ -0,0 +1,301 @@
+// -*-c++-*-
+
+/*!
+	\file parallel_trainer.h
+	\brief parallel training task runner Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_FORMATION_PARALLEL_TRAINER_H
+#define RCSC_FORMATION_PARALLEL_TRAINER_H
+
+#include <rcsc/timer.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+
+namespace rcsc {
+
+/*!
+  \class ParallelTrainer
+  \brief run independent training tasks on the worker threads.
+
+  Formation methods that have one network for each player register one
+  task for each network. The tasks must not share any mutable data.
+  run() returns after all tasks are finished.
+ */
+class ParallelTrainer {
+public:
+
+    /*!
+      \class Task
+      \brief abstract training task
+     */
+    class Task {
+    public:
+        /*!
+          \brief virtual destructor
+         */
+        virtual
+        ~Task()
+          { }
+
+        /*!
+          \brief execute the task. this method is called on a worker thread.
+         */
+        virtual
+        void run() = 0;
+    };
+
+    //! pointer type
+    typedef boost::shared_ptr< Task > TaskPtr;
+
+private:
+
+    //! the maximal number of worker threads
+    static int S_max_threads;
+
+    //! registered tasks
+    std::vector< TaskPtr > M_tasks;
+
+public:
+
+    /*!
+      \brief set the maximal number of worker threads used by run().
+      \param n the number of threads. if n <= 1, all tasks are executed
+      on the caller thread.
+     */
+    static
+    void set_max_threads( const int n );
+
+    /*!
+      \brief get the maximal number of worker threads
+      \return the number of threads
+     */
+    static
+    int max_threads()
+      {
+          return S_max_threads;
+      }
+
+    /*!
+      \brief register the task
+      \param task pointer to the task object
+     */
+    void addTask( TaskPtr task )
+      {
+          if ( task )
+          {
+              M_tasks.push_back( task );
+          }
+      }
+
+    /*!
+      \brief get the registered tasks
+      \return const reference to the task container
+     */
+    const
+    std::vector< TaskPtr > & tasks() const
+      {
+          return M_tasks;
+      }
+
+    /*!
+      \brief execute all registered tasks and wait for them.
+     */
+    void run();
+
+};
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class NetTrainTask
+  \brief training task for one network.
+
+  Training samples are copied to the contiguous arrays on construction,
+  and the network is trained by the online back propagation until the
+  maximal error becomes less than the threshold.
+  Messages are stored to the internal buffer, because the tasks run
+  concurrently. They should be printed after ParallelTrainer::run().
+
+  NET must have train( const INPUT &, const OUTPUT & ), which returns the
+  error value.
+ */
+template < typename NET, typename INPUT, typename OUTPUT >
+class NetTrainTask
+    : public ParallelTrainer::Task {
+private:
+    //! trained network
+    NET & M_net;
+
+    //! input values of the samples
+    std::vector< INPUT > M_inputs;
+    //! teacher values of the samples
+    std::vector< OUTPUT > M_teachers;
+
+    //! the maximal number of epochs
+    const int M_max_loop;
+    //! convergence threshold of the maximal error
+    const double M_threshold;
+
+    //! message buffer
+    std::ostringstream M_log;
+
+public:
+
+    /*!
+      \brief construct with the target network
+      \param net reference to the trained network
+      \param max_loop the maximal number of epochs
+      \param threshold convergence threshold of the maximal error
+     */
+    NetTrainTask( NET & net,
+                  const int max_loop,
+                  const double & threshold )
+        : M_net( net )
+        , M_max_loop( max_loop )
+        , M_threshold( threshold )
+      { }
+
+    /*!
+      \brief get the trained network
+      \return const reference to the network
+     */
+    const
+    NET & net() const
+      {
+          return M_net;
+      }
+
+    /*!
+      \brief reserve the sample arrays
+      \param size the number of samples
+     */
+    void reserve( const std::size_t size )
+      {
+          M_inputs.reserve( size );
+          M_teachers.reserve( size );
+      }
+
+    /*!
+      \brief add the training sample
+      \param input input value
+      \param teacher teacher value
+     */
+    void addSample( const INPUT & input,
+                    const OUTPUT & teacher )
+      {
+          M_inputs.push_back( input );
+          M_teachers.push_back( teacher );
+      }
+
+    /*!
+      \brief get the message buffer
+      \return reference to the message buffer
+     */
+    std::ostream & log()
+      {
+          return M_log;
+      }
+
+    /*!
+      \brief print the messages
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & printLog( std::ostream & os ) const
+      {
+          return os << M_log.str() << std::flush;
+      }
+
+    /*!
+      \brief train the network
+     */
+    virtual
+    void run()
+      {
+          const std::size_t size = M_inputs.size();
+          if ( size == 0 )
+          {
+              return;
+          }
+
+          MSecTimer timer;
+
+          int loop = 0;
+          double ave_err = 0.0;
+          double max_err = 0.0;
+          bool success = false;
+          while ( ++loop <= M_max_loop )
+          {
+              ave_err = 0.0;
+              max_err = 0.0;
+              for ( std::size_t i = 0; i < size; ++i )
+              {
+                  double err = M_net.train( M_inputs[i], M_teachers[i] );
+                  if ( max_err < err )
+                  {
+                      max_err = err;
+                  }
+                  ave_err += err;
+              }
+              ave_err /= size;
+
+              if ( max_err < M_threshold )
+              {
+                  M_log << "  ----> converged. average err=" << ave_err
+                        << "  last max err=" << max_err
+                        << '\n';
+                  success = true;
+                  break;
+              }
+          }
+
+          const double msec = timer.elapsedReal();
+          const int epochs = std::min( loop, M_max_loop );
+
+          if ( ! success )
+          {
+              M_log << "  *** Failed to converge *** " << '\n';
+          }
+          M_log << "  ----> " << loop
+                << " loop. last average err=" << ave_err
+                << "  last max err=" << max_err
+                << '\n';
+          M_log << "  ----> elapsed " << msec << " [msec]  "
+                << ( msec > 0.0 ? epochs * 1000.0 / msec : 0.0 )
+                << " loop/sec" << '\n';
+      }
+};
+
+}
+
+#endif
@@ -0,0 +1,227 @@
+// -*-c++-*-
+
+/*!
+	\file snapshot_rcg_handler.cpp
+	\brief rcg handler to collect formation snapshots Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "snapshot_rcg_handler.h"
+#include "snapshot_reservoir.h"
+
+#include <rcsc/rcg/util.h>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SnapshotRcgHandler::SnapshotRcgHandler( SnapshotReservoir & reservoir,
+                                        const SideID side,
+                                        const PlayMode playmode )
+    : M_reservoir( reservoir )
+    , M_side( side )
+    , M_target_playmode( playmode )
+    , M_playmode( PM_Null )
+{
+    M_snapshot.players_.reserve( 11 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SnapshotRcgHandler::handleDispInfo( const rcg::dispinfo_t & info )
+{
+    if ( rcg::nstohi( info.mode ) == rcg::SHOW_MODE )
+    {
+        return handleShowInfo( info.body.show );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SnapshotRcgHandler::handleShowInfo( const rcg::showinfo_t & info )
+{
+    handlePlayMode( info.pmode );
+
+    if ( M_playmode != M_target_playmode )
+    {
+        return true;
+    }
+
+    M_snapshot.ball_.assign( rcg::nstohd( info.pos[0].x ),
+                             rcg::nstohd( info.pos[0].y ) );
+    M_snapshot.players_.clear();
+
+    for ( int i = 1; i < MAX_PLAYER * 2 + 1; ++i )
+    {
+        const rcg::pos_t & p = info.pos[i];
+        if ( rcg::nstohi( p.side ) != M_side )
+        {
+            continue;
+        }
+
+        if ( rcg::nstohi( p.enable ) == 0 )
+        {
+            return true;
+        }
+
+        M_snapshot.players_.push_back( Vector2D( rcg::nstohd( p.x ),
+                                                 rcg::nstohd( p.y ) ) );
+    }
+
+    addSnapshot();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SnapshotRcgHandler::handleShortShowInfo2( const rcg::short_showinfo_t2 & info )
+{
+    if ( M_playmode != M_target_playmode )
+    {
+        return true;
+    }
+
+    M_snapshot.ball_.assign( rcg::nltohd( info.ball.x ),
+                             rcg::nltohd( info.ball.y ) );
+    M_snapshot.players_.clear();
+
+    const int first = ( M_side == LEFT ? 0 : MAX_PLAYER );
+    for ( int i = first; i < first + MAX_PLAYER; ++i )
+    {
+        const rcg::player_t & p = info.pos[i];
+        if ( rcg::nstohi( p.mode ) == 0 )
+        {
+            return true;
+        }
+
+        M_snapshot.players_.push_back( Vector2D( rcg::nltohd( p.x ),
+                                                 rcg::nltohd( p.y ) ) );
+    }
+
+    addSnapshot();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SnapshotRcgHandler::handlePlayMode( char playmode )
+{
+    M_playmode = static_cast< PlayMode >( playmode );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SnapshotRcgHandler::handleShow( const int,
+                                const rcg::ShowInfoT & show )
+{
+    if ( M_playmode != M_target_playmode )
+    {
+        return true;
+    }
+
+    M_snapshot.ball_.assign( show.ball_.x_, show.ball_.y_ );
+    M_snapshot.players_.clear();
+
+    const int first = ( M_side == LEFT ? 0 : MAX_PLAYER );
+    for ( int i = first; i < first + MAX_PLAYER; ++i )
+    {
+        const rcg::PlayerT & p = show.player_[i];
+        if ( p.unum_ == 0
+             || p.state_ == 0 )
+        {
+            return true;
+        }
+
+        M_snapshot.players_.push_back( Vector2D( p.x_, p.y_ ) );
+    }
+
+    addSnapshot();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SnapshotRcgHandler::handlePlayMode( const int,
+                                    const PlayMode pm )
+{
+    M_playmode = pm;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+SnapshotRcgHandler::addSnapshot()
+{
+    if ( M_snapshot.players_.size() != 11 )
+    {
+        return;
+    }
+
+    if ( M_side == RIGHT )
+    {
+        M_snapshot.ball_ = -M_snapshot.ball_;
+        for ( std::vector< Vector2D >::iterator p = M_snapshot.players_.begin();
+              p != M_snapshot.players_.end();
+              ++p )
+        {
+            *p = -(*p);
+        }
+    }
+
+    M_reservoir.add( M_snapshot );
+}
+
+}
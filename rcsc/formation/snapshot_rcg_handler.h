@@ -0,0 +1,274 @@
+// -*-c++-*-
+
+/*!
+	\file snapshot_rcg_handler.h
+	\brief rcg handler to collect formation snapshots Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_FORMATION_SNAPSHOT_RCG_HANDLER_H
+#define RCSC_FORMATION_SNAPSHOT_RCG_HANDLER_H
+
+#include <rcsc/formation/formation.h>
+#include <rcsc/rcg/handler.h>
+#include <rcsc/types.h>
+
+namespace rcsc {
+
+class SnapshotReservoir;
+
+/*!
+  \class SnapshotRcgHandler
+  \brief rcg handler that puts the field status to SnapshotReservoir.
+
+  The positions of the ball and all players of the target team are
+  read from each show data while the game is in the target playmode.
+  Positions of the right team are reversed, so the snapshots always
+  use the left team coordinates. Show data with the disabled players
+  are skipped.
+
+  Usage:
+  \code
+  rcsc::SnapshotReservoir reservoir( 10000 );
+  rcsc::SnapshotRcgHandler handler( reservoir, rcsc::LEFT );
+  rcsc::rcg::ParserPtr parser = rcsc::rcg::make_parser( fin );
+  parser->parse( fin, handler );
+  \endcode
+ */
+class SnapshotRcgHandler
+    : public rcg::Handler {
+private:
+
+    //! snapshot container
+    SnapshotReservoir & M_reservoir;
+
+    //! target team side
+    const SideID M_side;
+
+    //! target playmode
+    const PlayMode M_target_playmode;
+
+    //! current playmode
+    PlayMode M_playmode;
+
+    //! snapshot buffer
+    Formation::Snapshot M_snapshot;
+
+    // not used
+    SnapshotRcgHandler();
+    SnapshotRcgHandler( const SnapshotRcgHandler & );
+    SnapshotRcgHandler & operator=( const SnapshotRcgHandler & );
+
+public:
+
+    /*!
+      \brief construct with the container
+      \param reservoir reference to the snapshot container
+      \param side target team side
+      \param playmode target playmode
+     */
+    SnapshotRcgHandler( SnapshotReservoir & reservoir,
+                        const SideID side,
+                        const PlayMode playmode = PM_PlayOn );
+
+    /*!
+      \brief handle rcg v1 data
+      \param info handled data
+      \return always true
+     */
+    virtual
+    bool handleDispInfo( const rcg::dispinfo_t & info );
+
+    /*!
+      \brief handle rcg v2 show data
+      \param info handled data
+      \return always true
+     */
+    virtual
+    bool handleShowInfo( const rcg::showinfo_t & info );
+
+    /*!
+      \brief handle rcg v3 show data
+      \param info handled data
+      \return always true
+     */
+    virtual
+    bool handleShortShowInfo2( const rcg::short_showinfo_t2 & info );
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handleMsgInfo( rcg::Int16,
+                        const std::string & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief record the current playmode (rcg v1-v3)
+      \param playmode playmode id
+      \return always true
+     */
+    virtual
+    bool handlePlayMode( char playmode );
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handleTeamInfo( const rcg::team_t &,
+                         const rcg::team_t & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handlePlayerType( const rcg::player_type_t & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handleServerParam( const rcg::server_params_t & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handlePlayerParam( const rcg::player_params_t & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handleEOF()
+      {
+          return true;
+      }
+
+    /*!
+      \brief handle rcg v4 show data
+      \param show handled data
+      \return always true
+     */
+    virtual
+    bool handleShow( const int,
+                     const rcg::ShowInfoT & show );
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handleMsg( const int,
+                    const int,
+                    const char * )
+      {
+          return true;
+      }
+
+    /*!
+      \brief record the current playmode (rcg v4)
+      \param pm playmode id
+      \return always true
+     */
+    virtual
+    bool handlePlayMode( const int,
+                         const PlayMode pm );
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handleTeam( const int,
+                     const rcg::TeamT &,
+                     const rcg::TeamT & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handleServerParam( const std::string & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handlePlayerParam( const std::string & )
+      {
+          return true;
+      }
+
+    /*!
+      \brief ignored
+      \return always true
+     */
+    virtual
+    bool handlePlayerType( const std::string & )
+      {
+          return true;
+      }
+
+private:
+
+    /*!
+      \brief put the snapshot buffer to the container
+     */
+    void addSnapshot();
+
+};
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+// -*-c++-*-
+
+/*!
+	\file snapshot_reservoir.cpp
+	\brief bounded training snapshot container Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "snapshot_reservoir.h"
+
+#include <cmath>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SnapshotReservoir::SnapshotReservoir( const std::size_t capacity,
+                                      const double & cell_size,
+                                      const unsigned int seed )
+    : M_capacity( capacity )
+    , M_cell_size( cell_size )
+    , M_accepted_count( 0 )
+    , M_total_count( 0 )
+    , M_rng( seed )
+{
+    M_snapshots.reserve( capacity );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+SnapshotReservoir::clear()
+{
+    M_snapshots.clear();
+    M_cells.clear();
+    M_accepted_count = 0;
+    M_total_count = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::pair< int, int >
+SnapshotReservoir::getCell( const Formation::Snapshot & snapshot ) const
+{
+    return std::make_pair( static_cast< int >( std::floor( snapshot.ball_.x / M_cell_size ) ),
+                           static_cast< int >( std::floor( snapshot.ball_.y / M_cell_size ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+SnapshotReservoir::add( const Formation::Snapshot & snapshot )
+{
+    ++M_total_count;
+
+    if ( M_capacity == 0
+         || snapshot.players_.size() != 11 )
+    {
+        return false;
+    }
+
+    const bool dedupe = ( M_cell_size > 0.0 );
+    const std::pair< int, int > cell = ( dedupe
+                                         ? getCell( snapshot )
+                                         : std::make_pair( 0, 0 ) );
+
+    if ( dedupe
+         && M_cells.find( cell ) != M_cells.end() )
+    {
+        return false;
+    }
+
+    ++M_accepted_count;
+
+    if ( M_snapshots.size() < M_capacity )
+    {
+        M_snapshots.push_back( snapshot );
+        if ( dedupe ) M_cells.insert( cell );
+        return true;
+    }
+
+    //
+    // reservoir sampling.
+    // the new snapshot replaces a stored one with probability capacity / accepted.
+    //
+
+    boost::uniform_int< long > dst( 0, M_accepted_count - 1 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_int< long > > rng( M_rng, dst );
+
+    const long index = rng();
+    if ( index >= static_cast< long >( M_capacity ) )
+    {
+        return false;
+    }
+
+    if ( dedupe )
+    {
+        M_cells.erase( getCell( M_snapshots[index] ) );
+        M_cells.insert( cell );
+    }
+    M_snapshots[index] = snapshot;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+SnapshotReservoir::copyTo( std::list< Formation::Snapshot > & train_data ) const
+{
+    train_data.assign( M_snapshots.begin(), M_snapshots.end() );
+}
+
+}
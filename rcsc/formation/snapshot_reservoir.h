@@ -0,0 +1,156 @@
+// -*-c++-*-
+
+/*!
+	\file snapshot_reservoir.h
+	\brief bounded training snapshot container Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_FORMATION_SNAPSHOT_RESERVOIR_H
+#define RCSC_FORMATION_SNAPSHOT_RESERVOIR_H
+
+#include <rcsc/formation/formation.h>
+
+#include <boost/random.hpp>
+
+#include <vector>
+#include <list>
+#include <set>
+#include <utility>
+
+namespace rcsc {
+
+/*!
+  \class SnapshotReservoir
+  \brief bounded container of the formation training snapshots.
+
+  Snapshots whose ball position falls into the same dedupe cell as a
+  stored snapshot are ignored. Other snapshots are sampled by the
+  reservoir sampling, so the stored snapshots are a uniform random
+  sample of all accepted snapshots and the memory usage never exceeds
+  the capacity, however many logs are read.
+ */
+class SnapshotReservoir {
+private:
+
+    //! the maximal number of stored snapshots
+    std::size_t M_capacity;
+
+    //! size of the dedupe cell
+    double M_cell_size;
+
+    //! stored snapshots
+    std::vector< Formation::Snapshot > M_snapshots;
+
+    //! dedupe cells occupied by the stored snapshots
+    std::set< std::pair< int, int > > M_cells;
+
+    //! the number of snapshots that passed the dedupe check
+    long M_accepted_count;
+
+    //! the number of snapshots given to add()
+    long M_total_count;
+
+    //! random number generator for the reservoir sampling
+    boost::mt19937 M_rng;
+
+    // not used
+    SnapshotReservoir( const SnapshotReservoir & );
+    SnapshotReservoir & operator=( const SnapshotReservoir & );
+
+public:
+
+    /*!
+      \brief create empty container
+      \param capacity the maximal number of stored snapshots
+      \param cell_size size of the dedupe cell. if 0, dedupe is disabled.
+      \param seed random seed for the reservoir sampling
+     */
+    explicit
+    SnapshotReservoir( const std::size_t capacity,
+                       const double & cell_size = 0.5,
+                       const unsigned int seed = 5489 );
+
+    /*!
+      \brief remove all snapshots and reset all counters
+     */
+    void clear();
+
+    /*!
+      \brief offer the snapshot
+      \param snapshot offered snapshot.
+      \return true if the snapshot is stored.
+     */
+    bool add( const Formation::Snapshot & snapshot );
+
+    /*!
+      \brief get the stored snapshots
+      \return const reference to the snapshot container
+     */
+    const
+    std::vector< Formation::Snapshot > & snapshots() const
+      {
+          return M_snapshots;
+      }
+
+    /*!
+      \brief get the number of snapshots that passed the dedupe check
+      \return the number of snapshots
+     */
+    long acceptedCount() const
+      {
+          return M_accepted_count;
+      }
+
+    /*!
+      \brief get the number of snapshots given to add()
+      \return the number of snapshots
+     */
+    long totalCount() const
+      {
+          return M_total_count;
+      }
+
+    /*!
+      \brief copy the stored snapshots to the training data container.
+      \param train_data reference to the container used by Formation::train()
+     */
+    void copyTo( std::list< Formation::Snapshot > & train_data ) const;
+
+private:
+
+    /*!
+      \brief get the dedupe cell of the snapshot
+      \param snapshot checked snapshot
+      \return cell index
+     */
+    std::pair< int, int > getCell( const Formation::Snapshot & snapshot ) const;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,267 @@
+// -*-c++-*-
+
+/*!
+  \file snapshot_reservoir_test.cpp
+  \brief test code for rcsc::SnapshotReservoir and rcsc::SnapshotRcgHandler
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "snapshot_reservoir.h"
+#include "snapshot_rcg_handler.h"
+
+#include <rcsc/rcg/factory.h>
+#include <rcsc/rcg/parser.h>
+
+#include <sstream>
+#include <cstdio>
+
+using namespace boost::unit_test_framework;
+
+namespace {
+
+/*!
+  \brief create the snapshot with the given ball position
+ */
+rcsc::Formation::Snapshot
+create_snapshot( const double & ball_x,
+                 const double & ball_y )
+{
+    rcsc::Formation::Snapshot snapshot;
+    snapshot.ball_.assign( ball_x, ball_y );
+    for ( int i = 0; i < 11; ++i )
+    {
+        snapshot.players_.push_back( rcsc::Vector2D( -40.0 + i * 4.0,
+                                                     ball_y * 0.5 ) );
+    }
+    return snapshot;
+}
+
+/*!
+  \brief write one rcg v4 show line.
+  all players are placed relative to the ball.
+ */
+void
+write_show( std::ostream & os,
+            const int time,
+            const double & ball_x,
+            const double & ball_y )
+{
+    char buf[512];
+
+    os << "(show " << time
+       << " ((b) " << ball_x << ' ' << ball_y << " 0 0)";
+
+    for ( int side = 0; side < 2; ++side )
+    {
+        for ( int unum = 1; unum <= 11; ++unum )
+        {
+            const double x = ( side == 0 ? -1.0 : 1.0 ) * ( 5.0 + unum * 3.0 );
+            const double y = ball_y * 0.5 + unum - 6.0;
+            std::snprintf( buf, 512,
+                           " ((%c %d) 0 0x1 %.2f %.2f 0 0 0 0"
+                           " (v h 90) (s 8000 1 1)"
+                           " (c 0 0 0 0 0 0 0 0 0 0 0))",
+                           ( side == 0 ? 'l' : 'r' ), unum, x, y );
+            os << buf;
+        }
+    }
+
+    os << ")\n";
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkReservoirDedupe()
+{
+    rcsc::SnapshotReservoir reservoir( 100, 0.5 );
+
+    BOOST_CHECK( reservoir.add( create_snapshot( 10.1, 5.1 ) ) );
+    // the same dedupe cell
+    BOOST_CHECK( ! reservoir.add( create_snapshot( 10.3, 5.4 ) ) );
+    // the next cell
+    BOOST_CHECK( reservoir.add( create_snapshot( 10.6, 5.4 ) ) );
+    // illegal player size
+    rcsc::Formation::Snapshot broken = create_snapshot( 30.0, 0.0 );
+    broken.players_.pop_back();
+    BOOST_CHECK( ! reservoir.add( broken ) );
+
+    BOOST_CHECK_EQUAL( reservoir.snapshots().size(), std::size_t( 2 ) );
+    BOOST_CHECK_EQUAL( reservoir.acceptedCount(), 2L );
+    BOOST_CHECK_EQUAL( reservoir.totalCount(), 4L );
+
+    // dedupe is disabled
+    rcsc::SnapshotReservoir all( 100, 0.0 );
+    BOOST_CHECK( all.add( create_snapshot( 10.1, 5.1 ) ) );
+    BOOST_CHECK( all.add( create_snapshot( 10.1, 5.1 ) ) );
+    BOOST_CHECK_EQUAL( all.snapshots().size(), std::size_t( 2 ) );
+
+    // copy to the training data
+    std::list< rcsc::Formation::Snapshot > train_data;
+    reservoir.copyTo( train_data );
+    BOOST_CHECK_EQUAL( train_data.size(), std::size_t( 2 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkReservoirSampling()
+{
+    const std::size_t capacity = 10;
+    const int n_items = 40;
+    const int n_trials = 2000;
+
+    std::vector< int > hits( n_items, 0 );
+
+    for ( int trial = 0; trial < n_trials; ++trial )
+    {
+        rcsc::SnapshotReservoir reservoir( capacity, 0.5, 1000 + trial );
+
+        for ( int i = 0; i < n_items; ++i )
+        {
+            // every snapshot has its own dedupe cell
+            reservoir.add( create_snapshot( i * 1.0 - 20.0, 0.0 ) );
+        }
+
+        // the memory never exceeds the capacity
+        BOOST_CHECK_EQUAL( reservoir.snapshots().size(), capacity );
+        BOOST_CHECK_EQUAL( reservoir.acceptedCount(), static_cast< long >( n_items ) );
+
+        for ( std::vector< rcsc::Formation::Snapshot >::const_iterator
+                  it = reservoir.snapshots().begin();
+              it != reservoir.snapshots().end();
+              ++it )
+        {
+            const int i = static_cast< int >( it->ball_.x + 20.0 + 0.5 );
+            BOOST_REQUIRE( 0 <= i && i < n_items );
+            hits[i] += 1;
+        }
+    }
+
+    //
+    // each snapshot is kept with probability capacity / n_items (= 0.25).
+    // binomial standard deviation is about 0.0097, so 0.05 is a 5 sigma margin.
+    //
+    const double expected = static_cast< double >( capacity ) / n_items;
+    for ( int i = 0; i < n_items; ++i )
+    {
+        const double rate = static_cast< double >( hits[i] ) / n_trials;
+        BOOST_CHECK_SMALL( rate - expected, 0.05 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static void checkRcgHandler()
+{
+    //
+    // small rcg v4 log.
+    // before_kick_off:   2 shows (ignored)
+    // play_on:           4 shows, 1 of them has the same ball cell
+    // kick_in_l:         1 show (ignored)
+    //
+    std::stringstream log;
+    log << "ULG4\n";
+    log << "(playmode 0 before_kick_off)\n";
+    write_show( log, 0, 0.0, 0.0 );
+    write_show( log, 0, 0.0, 0.0 );
+    log << "(playmode 1 play_on)\n";
+    write_show( log, 1, 1.1, 2.1 );
+    write_show( log, 2, 1.3, 2.3 ); // duplicated cell
+    write_show( log, 3, 5.0, -3.0 );
+    write_show( log, 4, -20.0, 10.0 );
+    log << "(playmode 5 kick_in_l)\n";
+    write_show( log, 5, -20.0, 34.0 );
+
+    //
+    // left team
+    //
+    {
+        rcsc::SnapshotReservoir reservoir( 100, 0.5 );
+        rcsc::SnapshotRcgHandler handler( reservoir, rcsc::LEFT );
+
+        std::istringstream is( log.str() );
+        rcsc::rcg::ParserPtr parser = rcsc::rcg::make_parser( is );
+        BOOST_REQUIRE( parser );
+        BOOST_CHECK( parser->parse( is, handler ) );
+
+        BOOST_CHECK_EQUAL( reservoir.totalCount(), 4L );
+        BOOST_REQUIRE_EQUAL( reservoir.snapshots().size(), std::size_t( 3 ) );
+
+        const rcsc::Formation::Snapshot & s = reservoir.snapshots().front();
+        BOOST_CHECK_SMALL( s.ball_.x - 1.1, 1.0e-3 );
+        BOOST_CHECK_SMALL( s.ball_.y - 2.1, 1.0e-3 );
+        BOOST_REQUIRE_EQUAL( s.players_.size(), std::size_t( 11 ) );
+        // left player 1
+        BOOST_CHECK_SMALL( s.players_[0].x - ( -8.0 ), 1.0e-3 );
+        BOOST_CHECK_SMALL( s.players_[0].y - ( 1.05 - 5.0 ), 1.0e-3 );
+    }
+
+    //
+    // right team. coordinates are reversed.
+    //
+    {
+        rcsc::SnapshotReservoir reservoir( 100, 0.5 );
+        rcsc::SnapshotRcgHandler handler( reservoir, rcsc::RIGHT );
+
+        std::istringstream is( log.str() );
+        rcsc::rcg::ParserPtr parser = rcsc::rcg::make_parser( is );
+        BOOST_REQUIRE( parser );
+        BOOST_CHECK( parser->parse( is, handler ) );
+
+        BOOST_REQUIRE_EQUAL( reservoir.snapshots().size(), std::size_t( 3 ) );
+
+        const rcsc::Formation::Snapshot & s = reservoir.snapshots().front();
+        BOOST_CHECK_SMALL( s.ball_.x - ( -1.1 ), 1.0e-3 );
+        BOOST_CHECK_SMALL( s.ball_.y - ( -2.1 ), 1.0e-3 );
+        // right player 1
+        BOOST_CHECK_SMALL( s.players_[0].x - ( -8.0 ), 1.0e-3 );
+        BOOST_CHECK_SMALL( s.players_[0].y - ( -( 1.05 - 5.0 ) ), 1.0e-3 );
+    }
+}
+
+
+test_suite *
+init_unit_test_suite( int argc, char * argv[] )
+{
+    test_suite * test = BOOST_TEST_SUITE( "rcsc::SnapshotReservoir test" );
+
+    test -> add( BOOST_TEST_CASE( &checkReservoirDedupe ) );
+    test -> add( BOOST_TEST_CASE( &checkReservoirSampling ) );
+    test -> add( BOOST_TEST_CASE( &checkRcgHandler ) );
+
+    return test;
+}
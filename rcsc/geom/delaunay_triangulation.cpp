@@ -37,6 +37,8 @@
 
 #include <rcsc/geom/triangle_2d.h>
 
+#include <cmath>
+
 namespace rcsc {
 
 const double DelaunayTriangulation::EPSILON = 1.0e-5;
@@ -164,6 +166,8 @@ DelaunayTriangulation::clear()
     M_edge_map.clear();
     M_vertices.clear();
 
+    clearIndex();
+
     //std::cout << "clear() end" << std::endl;
 }
 
@@ -315,7 +319,34 @@ DelaunayTriangulation::TrianglePtr
 DelaunayTriangulation::findTriangleContains( const Vector2D & pos ) const
 {
     TrianglePtr tri = static_cast< TrianglePtr >( 0 );
-    findTriangleContains( pos, &tri );
+
+    if ( M_triangle_index_offset.empty() )
+    {
+        // the index is not available.
+        findTriangleContains( pos, &tri );
+        return tri;
+    }
+
+    if ( pos.x < M_index_min_x - EPSILON
+         || M_index_min_x + M_index_cell_width * M_index_size_x + EPSILON < pos.x
+         || pos.y < M_index_min_y - EPSILON
+         || M_index_min_y + M_index_cell_height * M_index_size_y + EPSILON < pos.y )
+    {
+        // out of the convex hull
+        return tri;
+    }
+
+    const int cell = getIndexCell( pos );
+    const std::size_t end = M_triangle_index_offset[cell + 1];
+    for ( std::size_t i = M_triangle_index_offset[cell]; i < end; ++i )
+    {
+        if ( checkContains( M_triangle_index[i], pos ) != NOT_CONTAINED )
+        {
+            tri = M_triangle_index[i];
+            break;
+        }
+    }
+
     return tri;
 }
 
@@ -329,18 +360,84 @@ DelaunayTriangulation::findNearestVertex( const Vector2D & pos ) const
 {
     const Vertex * candidate = static_cast< Vertex * >( 0 );
 
+    if ( M_vertex_index_offset.empty() )
+    {
+        // the index is not available.
+        double min_dist2 = 10000000.0;
+        const std::vector< Vertex >::const_iterator end = M_vertices.end();
+        for ( std::vector< Vertex >::const_iterator it = M_vertices.begin();
+              it != end;
+              ++it )
+        {
+            double d2 = it->pos().dist2( pos );
+            if ( d2 < min_dist2 )
+            {
+                candidate = &(*it);
+                min_dist2 = d2;
+            }
+        }
+
+        return candidate;
+    }
+
+    //
+    // search the cells around pos ring by ring.
+    // any vertex in the cells outside the ring r is at least
+    // r * min_cell_size far from pos.
+    //
+
+    const int cell = getIndexCell( pos );
+    const int cx = cell % M_index_size_x;
+    const int cy = cell / M_index_size_x;
+    const double min_cell_size = std::min( M_index_cell_width,
+                                           M_index_cell_height );
+    const int max_ring = std::max( M_index_size_x, M_index_size_y );
+
     double min_dist2 = 10000000.0;
-    const std::vector< Vertex >::const_iterator end = M_vertices.end();
-    for ( std::vector< Vertex >::const_iterator it = M_vertices.begin();
-          it != end;
-          ++it )
+    int min_id = -1;
+
+    for ( int r = 0; r <= max_ring; ++r )
     {
-        double d2 = it->pos().dist2( pos );
-        if ( d2 < min_dist2 )
+        for ( int iy = std::max( 0, cy - r );
+              iy <= std::min( M_index_size_y - 1, cy + r );
+              ++iy )
         {
-            candidate = &(*it);
-            min_dist2 = d2;
+            const bool edge_row = ( iy == cy - r || iy == cy + r );
+            const int step = ( edge_row ? 1 : 2 * r );
+
+            for ( int ix = cx - r; ix <= cx + r; ix += std::max( step, 1 ) )
+            {
+                if ( ix < 0 || M_index_size_x <= ix )
+                {
+                    continue;
+                }
+
+                const int c = iy * M_index_size_x + ix;
+                const std::size_t end = M_vertex_index_offset[c + 1];
+                for ( std::size_t i = M_vertex_index_offset[c]; i < end; ++i )
+                {
+                    const int id = M_vertex_index[i];
+                    double d2 = M_vertices[id].pos().dist2( pos );
+                    if ( d2 < min_dist2
+                         || ( d2 == min_dist2 && id < min_id ) )
+                    {
+                        min_dist2 = d2;
+                        min_id = id;
+                    }
+                }
+            }
         }
+
+        if ( min_id >= 0
+             && min_dist2 <= std::pow( r * min_cell_size, 2 ) )
+        {
+            break;
+        }
+    }
+
+    if ( min_id >= 0 )
+    {
+        candidate = &M_vertices[min_id];
     }
 
     return candidate;
@@ -349,15 +446,191 @@ DelaunayTriangulation::findNearestVertex( const Vector2D & pos ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+DelaunayTriangulation::clearIndex()
+{
+    M_index_min_x = M_index_min_y = 0.0;
+    M_index_cell_width = M_index_cell_height = 1.0;
+    M_index_size_x = M_index_size_y = 0;
+
+    M_triangle_index_offset.clear();
+    M_triangle_index.clear();
+    M_vertex_index_offset.clear();
+    M_vertex_index.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+DelaunayTriangulation::getIndexCell( const Vector2D & pos ) const
+{
+    int ix = static_cast< int >( std::floor( ( pos.x - M_index_min_x )
+                                             / M_index_cell_width ) );
+    int iy = static_cast< int >( std::floor( ( pos.y - M_index_min_y )
+                                             / M_index_cell_height ) );
+    ix = std::min( std::max( 0, ix ), M_index_size_x - 1 );
+    iy = std::min( std::max( 0, iy ), M_index_size_y - 1 );
+
+    return iy * M_index_size_x + ix;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DelaunayTriangulation::createIndex()
+{
+    clearIndex();
+
+    if ( M_vertices.empty() )
+    {
+        return;
+    }
+
+    double min_x = M_vertices.front().pos().x;
+    double max_x = min_x;
+    double min_y = M_vertices.front().pos().y;
+    double max_y = min_y;
+
+    const std::vector< Vertex >::const_iterator vend = M_vertices.end();
+    for ( std::vector< Vertex >::const_iterator v = M_vertices.begin();
+          v != vend;
+          ++v )
+    {
+        min_x = std::min( min_x, v->pos().x );
+        max_x = std::max( max_x, v->pos().x );
+        min_y = std::min( min_y, v->pos().y );
+        max_y = std::max( max_y, v->pos().y );
+    }
+
+    // about one triangle per cell
+    const double width = std::max( max_x - min_x, EPSILON );
+    const double height = std::max( max_y - min_y, EPSILON );
+    const double n_cells = std::max( 1.0,
+                                     static_cast< double >( std::max( M_triangle_map.size(),
+                                                                      M_vertices.size() ) ) );
+    const double cell_size = std::sqrt( width * height / n_cells );
+
+    M_index_min_x = min_x;
+    M_index_min_y = min_y;
+    M_index_size_x = std::min( 1024, std::max( 1, static_cast< int >( std::ceil( width / cell_size ) ) ) );
+    M_index_size_y = std::min( 1024, std::max( 1, static_cast< int >( std::ceil( height / cell_size ) ) ) );
+    M_index_cell_width = width / M_index_size_x;
+    M_index_cell_height = height / M_index_size_y;
+
+    const int size = M_index_size_x * M_index_size_y;
+
+    //
+    // triangles. each cell refers the triangles whose bounding box overlaps it.
+    // the triangles in a cell are sorted by their Id, same as the map order.
+    //
+
+    M_triangle_index_offset.assign( size + 1, 0 );
+
+    for ( int loop = 0; loop < 2; ++loop )
+    {
+        std::vector< std::size_t > pos_in_cell;
+        if ( loop == 1 )
+        {
+            for ( int i = 0; i < size; ++i )
+            {
+                M_triangle_index_offset[i + 1] += M_triangle_index_offset[i];
+            }
+            M_triangle_index.resize( M_triangle_index_offset[size] );
+            pos_in_cell.assign( M_triangle_index_offset.begin(),
+                                M_triangle_index_offset.end() - 1 );
+        }
+
+        const std::map< int, TrianglePtr >::const_iterator tend = M_triangle_map.end();
+        for ( std::map< int, TrianglePtr >::const_iterator it = M_triangle_map.begin();
+              it != tend;
+              ++it )
+        {
+            const TrianglePtr tri = it->second;
+            Vector2D tmin = tri->vertex( 0 )->pos();
+            Vector2D tmax = tmin;
+            for ( std::size_t i = 1; i < 3; ++i )
+            {
+                tmin.x = std::min( tmin.x, tri->vertex( i )->pos().x );
+                tmin.y = std::min( tmin.y, tri->vertex( i )->pos().y );
+                tmax.x = std::max( tmax.x, tri->vertex( i )->pos().x );
+                tmax.y = std::max( tmax.y, tri->vertex( i )->pos().y );
+            }
+
+            // expand by EPSILON, because online points are also searched.
+            tmin -= Vector2D( EPSILON, EPSILON );
+            tmax += Vector2D( EPSILON, EPSILON );
+
+            const int c0 = getIndexCell( tmin );
+            const int c1 = getIndexCell( tmax );
+
+            for ( int iy = c0 / M_index_size_x; iy <= c1 / M_index_size_x; ++iy )
+            {
+                for ( int ix = c0 % M_index_size_x; ix <= c1 % M_index_size_x; ++ix )
+                {
+                    const int c = iy * M_index_size_x + ix;
+                    if ( loop == 0 )
+                    {
+                        ++M_triangle_index_offset[c + 1];
+                    }
+                    else
+                    {
+                        M_triangle_index[pos_in_cell[c]++] = tri;
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // vertices
+    //
+
+    M_vertex_index_offset.assign( size + 1, 0 );
+
+    for ( std::vector< Vertex >::const_iterator v = M_vertices.begin();
+          v != vend;
+          ++v )
+    {
+        ++M_vertex_index_offset[getIndexCell( v->pos() ) + 1];
+    }
+
+    for ( int i = 0; i < size; ++i )
+    {
+        M_vertex_index_offset[i + 1] += M_vertex_index_offset[i];
+    }
+
+    M_vertex_index.resize( M_vertices.size() );
+    std::vector< std::size_t > pos_in_cell( M_vertex_index_offset.begin(),
+                                            M_vertex_index_offset.end() - 1 );
+
+    for ( std::vector< Vertex >::const_iterator v = M_vertices.begin();
+          v != vend;
+          ++v )
+    {
+        M_vertex_index[pos_in_cell[getIndexCell( v->pos() )]++] = v->id();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 DelaunayTriangulation::compute()
 {
     //std::cout << "compute() start " << std::endl;
+    clearIndex();
+
     if ( M_vertices.size() < 3 )
     {
         //std::cout << "compute() too few vertices" << std::endl;
         removeInitialVertices();
+        createIndex();
         return;
     }
 
@@ -426,6 +699,7 @@ DelaunayTriangulation::compute()
     }
 
     removeInitialVertices();
+    createIndex();
 #ifdef DEBUG
     std::cout << __FILE__ << ':' << __LINE__
               << " compute() end\n"
@@ -866,96 +1140,108 @@ DelaunayTriangulation::legalizeEdge( TrianglePtr new_tri,
 
 */
 DelaunayTriangulation::ContainedType
-DelaunayTriangulation::findTriangleContains( const Vector2D & pos,
-                                             TrianglePtr * sol ) const
+DelaunayTriangulation::checkContains( const Triangle * tri,
+                                      const Vector2D & pos )
 {
-    const std::map< int, TrianglePtr >::const_iterator end = M_triangle_map.end();
-    for ( std::map< int, TrianglePtr >::const_iterator it = M_triangle_map.begin();
-          it != end;
-          ++it )
+    if ( std::fabs( tri->circumcenter().x - pos.x )
+         > tri->circumradius()
+         || std::fabs( tri->circumcenter().y - pos.y )
+         > tri->circumradius() )
     {
-        const TrianglePtr tri = it->second;
-
-        if ( std::fabs( tri->circumcenter().x - pos.x )
-             > tri->circumradius()
-             || std::fabs( tri->circumcenter().y - pos.y )
-             > tri->circumradius() )
-        {
-            // out of circumcircle
-            continue;
-        }
+        // out of circumcircle
+        return NOT_CONTAINED;
+    }
 
-        Vector2D rel0( tri->vertex( 0 )->pos() - pos );
-        Vector2D rel1( tri->vertex( 1 )->pos() - pos );
-        Vector2D rel2( tri->vertex( 2 )->pos() - pos );
-
-        double outer0 = rel0.outerProduct( rel1 );
-        double outer1 = rel1.outerProduct( rel2 );
-        double outer2 = rel2.outerProduct( rel0 );
-
-        //std::cout << "findTriangleContains() found online\n"
-        //          << " tri0 = " << tri->vertex( 0 )->pos()
-        //          << " tri0 = " << tri->vertex( 1 )->pos()
-        //          << " tri0 = " << tri->vertex( 2 )->pos()
-        //          << "\n  outer0 = " << outer0
-        //          << "  outer1 = " << outer1
-        //          << "  outer2 = " << outer2
-        //          << std::endl;
+    Vector2D rel0( tri->vertex( 0 )->pos() - pos );
+    Vector2D rel1( tri->vertex( 1 )->pos() - pos );
+    Vector2D rel2( tri->vertex( 2 )->pos() - pos );
+
+    double outer0 = rel0.outerProduct( rel1 );
+    double outer1 = rel1.outerProduct( rel2 );
+    double outer2 = rel2.outerProduct( rel0 );
+
+    //std::cout << "findTriangleContains() found online\n"
+    //          << " tri0 = " << tri->vertex( 0 )->pos()
+    //          << " tri0 = " << tri->vertex( 1 )->pos()
+    //          << " tri0 = " << tri->vertex( 2 )->pos()
+    //          << "\n  outer0 = " << outer0
+    //          << "  outer1 = " << outer1
+    //          << "  outer2 = " << outer2
+    //          << std::endl;
 
-        if ( std::fabs( outer0 ) <= EPSILON )
+    if ( std::fabs( outer0 ) <= EPSILON )
+    {
+        if ( rel0.x * rel1.x > 0.0
+             || rel0.y * rel1.y > 0.0 )
         {
-            if ( rel0.x * rel1.x > 0.0
-                 || rel0.y * rel1.y > 0.0 )
-            {
-                // not online
-                continue;
-            }
-            //std::cout << "findTriangleContains() found online on 0-1 " << std::endl;
-            *sol = tri;
-            return ONLINE;
+            // not online
+            return NOT_CONTAINED;
         }
+        //std::cout << "findTriangleContains() found online on 0-1 " << std::endl;
+        return ONLINE;
+    }
 
-        if ( std::fabs( outer1 ) <= EPSILON )
+    if ( std::fabs( outer1 ) <= EPSILON )
+    {
+        if ( rel1.x * rel2.x > 0.0
+             || rel1.y * rel2.y > 0.0 )
         {
-            if ( rel1.x * rel2.x > 0.0
-                 || rel1.y * rel2.y > 0.0 )
-            {
-                // not online
-                continue;
-            }
-            //std::cout << "findTriangleContains() found online on 1-2 " << std::endl;
-            *sol = tri;
-            return ONLINE;
+            // not online
+            return NOT_CONTAINED;
         }
+        //std::cout << "findTriangleContains() found online on 1-2 " << std::endl;
+        return ONLINE;
+    }
 
-        if ( std::fabs( outer2 ) <= EPSILON )
+    if ( std::fabs( outer2 ) <= EPSILON )
+    {
+        if ( rel2.x * rel0.x > 0.0
+             || rel2.y * rel0.y > 0.0 )
         {
-            if ( rel2.x * rel0.x > 0.0
-                 || rel2.y * rel0.y > 0.0 )
-            {
-                // not online
-                continue;
-            }
-            //std::cout << "findTriangleContains() found online on 2-0 " << std::endl;
-            *sol = tri;
-            return ONLINE;
+            // not online
+            return NOT_CONTAINED;
         }
+        //std::cout << "findTriangleContains() found online on 2-0 " << std::endl;
+        return ONLINE;
+    }
 
-        if ( (outer0 > 0.0 && outer1 > 0.0 && outer2 > 0.0)
-             || (outer0 < 0.0 && outer1 < 0.0 && outer2 < 0.0) )
-        {
+    if ( (outer0 > 0.0 && outer1 > 0.0 && outer2 > 0.0)
+         || (outer0 < 0.0 && outer1 < 0.0 && outer2 < 0.0) )
+    {
 #ifdef DEBUG
-            std::cout << __FILE__ << ':' << __LINE__
-                      << " findTriangleContains() found contained "
-                      << " pos" << vertex.pos()
-                      << " triangle"
-                      << tri->vertex( 0 )->pos()
-                      << tri->vertex( 1 )->pos()
-                      << tri->vertex( 2 )->pos()
-                      << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__
+                  << " findTriangleContains() found contained "
+                  << " pos" << vertex.pos()
+                  << " triangle"
+                  << tri->vertex( 0 )->pos()
+                  << tri->vertex( 1 )->pos()
+                  << tri->vertex( 2 )->pos()
+                  << std::endl;
 #endif
-            *sol = tri;
-            return CONTAINED;
+        return CONTAINED;
+    }
+
+    return NOT_CONTAINED;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DelaunayTriangulation::ContainedType
+DelaunayTriangulation::findTriangleContains( const Vector2D & pos,
+                                             TrianglePtr * sol ) const
+{
+    const std::map< int, TrianglePtr >::const_iterator end = M_triangle_map.end();
+    for ( std::map< int, TrianglePtr >::const_iterator it = M_triangle_map.begin();
+          it != end;
+          ++it )
+    {
+        ContainedType type = checkContains( it->second, pos );
+        if ( type != NOT_CONTAINED )
+        {
+            *sol = it->second;
+            return type;
         }
     }
 
@@ -529,6 +529,28 @@ private:
     //! triangle instance holder. key: id
     std::map< int, TrianglePtr > M_triangle_map;
 
+    //
+    // point location index. a bucket grid over the bounding box of vertices.
+    // it is created by compute() and cleared when the vertex set is changed.
+    //
+
+    double M_index_min_x; //!< left x of the index grid
+    double M_index_min_y; //!< top y of the index grid
+    double M_index_cell_width; //!< cell width of the index grid
+    double M_index_cell_height; //!< cell height of the index grid
+    int M_index_size_x; //!< the number of columns of the index grid
+    int M_index_size_y; //!< the number of rows of the index grid
+
+    //! start position of each cell in M_triangle_index. size = cells + 1
+    std::vector< std::size_t > M_triangle_index_offset;
+    //! triangles whose bounding box overlaps the cell, sorted by Id in each cell
+    std::vector< TrianglePtr > M_triangle_index;
+
+    //! start position of each cell in M_vertex_index. size = cells + 1
+    std::vector< std::size_t > M_vertex_index_offset;
+    //! vertex Id numbers in each cell
+    std::vector< int > M_vertex_index;
+
     // not used
     DelaunayTriangulation & operator=( const DelaunayTriangulation & );
 
@@ -538,7 +560,9 @@ public:
       \brief nothing to do
     */
     DelaunayTriangulation()
-      { }
+      {
+          clearIndex();
+      }
 
     /*!
       \brief construct with considerable rectangle region
@@ -550,6 +574,7 @@ public:
     DelaunayTriangulation( const Rect2D & region )
       {
           //std::cout << "create with rect" << std::endl;
+          clearIndex();
           createInitialTriangle( region );
       }
 
@@ -615,6 +640,7 @@ public:
       {
           int id = M_vertices.size();
           M_vertices.push_back( Vertex( id, x, y ) );
+          clearIndex();
           return id;
       }
 
@@ -645,6 +671,9 @@ public:
       \brief find triangle that contains pos from the computed triangle set.
       \param pos coordinates of the target point
       \return const pointer to the found triangle. if no triangle, NULL is returned.
+
+      If the point location index has been created by compute(), only the
+      triangles registered in the grid cell of pos are checked.
      */
     const
     TrianglePtr findTriangleContains( const Vector2D & pos ) const;
@@ -653,6 +682,9 @@ public:
       \brief find the vertex nearest to the specified point
       \param pos coordinates of the target point
       \return const pointer to the found vertex, if no vertex, NULL is returned.
+
+      If the point location index has been created by compute(), the grid
+      cells are searched from the cell of pos outward.
      */
     const
     Vertex * findNearestVertex( const Vector2D & pos ) const;
@@ -711,6 +743,34 @@ private:
     ContainedType findTriangleContains( const Vector2D & pos,
                                         TrianglePtr * sol ) const;
 
+    /*!
+      \brief check how the point is contained by the triangle.
+      \param tri checked triangle
+      \param pos coordinates of the target point
+      \return how the point is contained.
+     */
+    static
+    ContainedType checkContains( const Triangle * tri,
+                                 const Vector2D & pos );
+
+    /*!
+      \brief clear the point location index.
+     */
+    void clearIndex();
+
+    /*!
+      \brief create the point location index using the current
+      vertices and triangles.
+     */
+    void createIndex();
+
+    /*!
+      \brief get the index grid cell that contains pos.
+      \param pos coordinates of the target point
+      \return cell index. pos is clamped into the grid.
+     */
+    int getIndexCell( const Vector2D & pos ) const;
+
     /*!
       \brief remove the specified edge from edge set
       \param id Id number of the removed edge.
@@ -0,0 +1,192 @@
+// -*-c++-*-
+
+/*!
+  \file delaunay_triangulation_test.cpp
+  \brief test code for rcsc::DelaunayTriangulation
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "delaunay_triangulation.h"
+#include "rect_2d.h"
+#include "triangle_2d.h"
+#include "vector_2d.h"
+
+#include <cstdlib>
+
+using namespace boost::unit_test_framework;
+
+namespace {
+
+const rcsc::DelaunayTriangulation::Vertex *
+find_nearest_vertex_linear( const rcsc::DelaunayTriangulation & triangulation,
+                            const rcsc::Vector2D & pos )
+{
+    const rcsc::DelaunayTriangulation::Vertex * candidate = 0;
+    double min_dist2 = 10000000.0;
+
+    for ( std::vector< rcsc::DelaunayTriangulation::Vertex >::const_iterator
+              it = triangulation.vertices().begin();
+          it != triangulation.vertices().end();
+          ++it )
+    {
+        double d2 = it->pos().dist2( pos );
+        if ( d2 < min_dist2 )
+        {
+            candidate = &(*it);
+            min_dist2 = d2;
+        }
+    }
+
+    return candidate;
+}
+
+bool
+triangle_contains( const rcsc::DelaunayTriangulation::Triangle * tri,
+                   const rcsc::Vector2D & pos )
+{
+    const rcsc::Triangle2D t( tri->vertex( 0 )->pos(),
+                              tri->vertex( 1 )->pos(),
+                              tri->vertex( 2 )->pos() );
+    return t.contains( pos );
+}
+
+double
+random_value( const double & min,
+              const double & max )
+{
+    return min + ( max - min ) * ( std::rand() / ( RAND_MAX + 1.0 ) );
+}
+
+}
+
+
+static void checkFindNearestVertex()
+{
+    std::srand( 12345 );
+
+    rcsc::DelaunayTriangulation triangulation( rcsc::Rect2D( -60.0, -40.0,
+                                                           120.0, 80.0 ) );
+    for ( int i = 0; i < 100; ++i )
+    {
+        triangulation.addVertex( random_value( -52.0, 52.0 ),
+                                 random_value( -34.0, 34.0 ) );
+    }
+
+    triangulation.compute();
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        // include points outside of the vertex region
+        const rcsc::Vector2D pos( random_value( -60.0, 60.0 ),
+                                  random_value( -40.0, 40.0 ) );
+
+        const rcsc::DelaunayTriangulation::Vertex * v
+            = triangulation.findNearestVertex( pos );
+        const rcsc::DelaunayTriangulation::Vertex * linear
+            = find_nearest_vertex_linear( triangulation, pos );
+
+        BOOST_CHECK( v != 0 );
+        BOOST_CHECK( v == linear );
+    }
+}
+
+
+static void checkFindTriangleContains()
+{
+    std::srand( 54321 );
+
+    rcsc::DelaunayTriangulation triangulation( rcsc::Rect2D( -60.0, -40.0,
+                                                           120.0, 80.0 ) );
+    for ( int i = 0; i < 100; ++i )
+    {
+        triangulation.addVertex( random_value( -52.0, 52.0 ),
+                                 random_value( -34.0, 34.0 ) );
+    }
+
+    triangulation.compute();
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        const rcsc::Vector2D pos( random_value( -60.0, 60.0 ),
+                                  random_value( -40.0, 40.0 ) );
+
+        const rcsc::DelaunayTriangulation::Triangle * tri
+            = triangulation.findTriangleContains( pos );
+
+        bool contained = false;
+        for ( std::map< int, rcsc::DelaunayTriangulation::TrianglePtr >::const_iterator
+                  it = triangulation.triangleMap().begin();
+              it != triangulation.triangleMap().end();
+              ++it )
+        {
+            if ( triangle_contains( it->second, pos ) )
+            {
+                contained = true;
+                break;
+            }
+        }
+
+        if ( contained )
+        {
+            BOOST_CHECK( tri != 0 );
+            BOOST_CHECK( tri != 0 && triangle_contains( tri, pos ) );
+        }
+        else
+        {
+            BOOST_CHECK( tri == 0 );
+        }
+    }
+
+    //
+    // vertices are always located
+    //
+    for ( std::vector< rcsc::DelaunayTriangulation::Vertex >::const_iterator
+              it = triangulation.vertices().begin();
+          it != triangulation.vertices().end();
+          ++it )
+    {
+        const rcsc::DelaunayTriangulation::Triangle * tri
+            = triangulation.findTriangleContains( it->pos() );
+
+        BOOST_CHECK( tri != 0 );
+    }
+}
+
+
+test_suite *
+init_unit_test_suite( int argc, char * argv[] )
+{
+    test_suite * test = BOOST_TEST_SUITE( "rcsc::DelaunayTriangulation test" );
+
+    test -> add( BOOST_TEST_CASE( &checkFindNearestVertex ) );
+    test -> add( BOOST_TEST_CASE( &checkFindTriangleContains ) );
+
+    return test;
+}
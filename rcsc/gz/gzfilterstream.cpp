@@ -34,6 +34,7 @@
 #endif
 
 #include "gzfilterstream.h"
+#include "gzparallelcompressor.h"
 
 #ifdef HAVE_LIBZ
 #include <zlib.h>
@@ -49,6 +50,8 @@ struct gzfilterstreambuf_impl {
     z_stream * comp_stream_; //!< compressin buffer
     z_stream * decomp_stream_; //!< decompression buffer
 #endif
+    //! block parallel compressor. if not NULL, used instead of comp_stream_
+    boost::scoped_ptr< GZParallelCompressor > parallel_;
 
     /*!
       \brief default constructo
@@ -129,6 +132,8 @@ gzfilterstreambuf::~gzfilterstreambuf()
     delete [] M_write_buf;
     M_write_buf = NULL;
 
+    M_impl->parallel_.reset();
+
 #ifdef HAVE_LIBZ
     delete M_impl->comp_stream_;
     M_impl->comp_stream_ = NULL;
@@ -150,7 +155,15 @@ gzfilterstreambuf::setLevel( const int level )
 {
     bool ret = false;
 #ifdef HAVE_LIBZ
-    if ( level == DEFAULT_COMPRESSION
+    if ( M_impl->parallel_ )
+    {
+        if ( M_impl->parallel_->setLevel( level ) )
+        {
+            M_level = level;
+            ret = true;
+        }
+    }
+    else if ( level == DEFAULT_COMPRESSION
          || ( NO_COMPRESSION <= level
               && level <= BEST_COMPRESSION )
          )
@@ -173,12 +186,59 @@ gzfilterstreambuf::setLevel( const int level )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+gzfilterstreambuf::setParallel( const int threads,
+                                const std::size_t block_size )
+{
+    bool ret = false;
+#ifdef HAVE_LIBZ
+    // parallel compression must be selected before any data is written.
+    if ( ! M_impl->parallel_
+         && pptr() == NULL
+         && M_impl->comp_stream_ == NULL
+         && NO_COMPRESSION < M_level
+         && M_level <= BEST_COMPRESSION )
+    {
+        M_impl->parallel_.reset( new GZParallelCompressor( M_strmbuf,
+                                                           M_level,
+                                                           threads,
+                                                           block_size ) );
+        ret = true;
+    }
+#else
+    // Without zlib, this class cannot compress any data.
+    (void)threads;
+    (void)block_size;
+#endif
+    return ret;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 gzfilterstreambuf::writeData( int flush_type )
 {
     // size of data to write
     int size = ( pptr() - pbase() ) * sizeof( char_type );
+
+    if ( M_impl->parallel_ )
+    {
+        bool ret = ( size == 0
+                     || M_impl->parallel_->write( M_output_buf, size ) );
+        if ( flush_type == FINISH )
+        {
+            ret = M_impl->parallel_->finish() && ret;
+        }
+        else if ( flush_type != NO_FLUSH )
+        {
+            ret = ret && M_impl->parallel_->flush();
+        }
+        return ret;
+    }
+
     if ( size == 0 )
     {
         return true;
@@ -138,6 +138,20 @@ public:
     */
     bool setLevel( const int level );
 
+    /*!
+      \brief use the block parallel compressor for the output data.
+      \param threads number of worker threads
+      \param block_size size of the uncompressed block
+      \return true if the parallel compressor is enabled.
+
+      This method has to be called before any data is written, and is
+      available only if the compression level is in [1,9].
+      The output data becomes a standard gzip stream instead of zlib
+      stream, so it should be read by gzifstream or gunzip.
+    */
+    bool setParallel( const int threads,
+                      const std::size_t block_size = 128 * 1024 );
+
 protected:
 
     /*!
@@ -235,6 +249,18 @@ public:
           return M_filter_buf.setLevel( level );
       }
 
+    /*!
+      \brief use the block parallel compressor for the output data.
+      \param threads number of worker threads
+      \param block_size size of the uncompressed block
+      \return true if the parallel compressor is enabled.
+    */
+    bool setParallel( const int threads,
+                      const std::size_t block_size = 128 * 1024 )
+      {
+          return M_filter_buf.setParallel( threads, block_size );
+      }
+
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -343,6 +369,18 @@ public:
           return M_filter_buf.setLevel( level );
       }
 
+    /*!
+      \brief use the block parallel compressor for the output data.
+      \param threads number of worker threads
+      \param block_size size of the uncompressed block
+      \return true if the parallel compressor is enabled.
+    */
+    bool setParallel( const int threads,
+                      const std::size_t block_size = 128 * 1024 )
+      {
+          return M_filter_buf.setParallel( threads, block_size );
+      }
+
 };
 
 } // end namespace
@@ -0,0 +1,556 @@
+// -*-c++-*-
+
+/*!
+  \file gzparallelcompressor.cpp
+  \brief block parallel gzip compressor Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "gzparallelcompressor.h"
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <string>
+
+namespace rcsc {
+
+namespace {
+
+//! deflate window size. the last part of the previous block is used as a dictionary.
+const std::size_t DICT_SIZE = 32768;
+
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class GZParallelCompressorImpl
+  \brief the implementation of block parallel gzip compressor
+ */
+class GZParallelCompressorImpl {
+private:
+
+    /*!
+      \struct Block
+      \brief compression unit
+     */
+    struct Block {
+        std::string in_; //!< uncompressed data
+        std::string dict_; //!< the tail of the previous block
+        std::string out_; //!< compressed raw deflate data
+        int level_; //!< compression level for this block
+        bool last_; //!< true if this is the last block of the stream
+        bool done_; //!< true if compressed
+        bool ok_; //!< compression result
+        unsigned long crc_; //!< crc32 of in_
+
+        Block()
+            : level_( 6 )
+            , last_( false )
+            , done_( false )
+            , ok_( false )
+            , crc_( 0 )
+          { }
+    };
+
+    std::streambuf & M_dest;
+    int M_level;
+    std::size_t M_block_size;
+
+    //! current uncompressed block
+    std::string M_current;
+    //! the tail of the last submitted block
+    std::string M_dict;
+
+    //! submitted blocks in the output order
+    std::deque< Block * > M_blocks;
+
+    bool M_header_written;
+    bool M_finished;
+    bool M_error;
+    unsigned long M_crc;
+    unsigned long M_total_in;
+
+#ifdef HAVE_LIBZ
+    //! blocks waiting for the worker thread
+    std::deque< Block * > M_queue;
+    std::vector< pthread_t > M_threads;
+    pthread_mutex_t M_mutex;
+    //! signaled when a block is queued or the workers should stop
+    pthread_cond_t M_queue_cond;
+    //! signaled when a block is compressed
+    pthread_cond_t M_done_cond;
+    bool M_stop;
+#endif
+
+public:
+
+    GZParallelCompressorImpl( std::streambuf & dest,
+                              const int level,
+                              const int threads,
+                              const std::size_t block_size )
+        : M_dest( dest )
+        , M_level( std::min( std::max( 1, level ), 9 ) )
+        , M_block_size( std::max( block_size, DICT_SIZE ) )
+        , M_header_written( false )
+        , M_finished( false )
+        , M_error( false )
+        , M_crc( 0 )
+        , M_total_in( 0 )
+#ifdef HAVE_LIBZ
+        , M_stop( false )
+#endif
+      {
+          M_current.reserve( M_block_size );
+#ifdef HAVE_LIBZ
+          M_crc = crc32( 0L, Z_NULL, 0 );
+
+          pthread_mutex_init( &M_mutex, NULL );
+          pthread_cond_init( &M_queue_cond, NULL );
+          pthread_cond_init( &M_done_cond, NULL );
+
+          for ( int i = 0; i < threads; ++i )
+          {
+              pthread_t t;
+              if ( pthread_create( &t, NULL,
+                                   &GZParallelCompressorImpl::worker_main,
+                                   this ) != 0 )
+              {
+                  // fall back to the available threads
+                  break;
+              }
+              M_threads.push_back( t );
+          }
+#else
+          (void)threads;
+#endif
+      }
+
+    ~GZParallelCompressorImpl()
+      {
+          finish();
+#ifdef HAVE_LIBZ
+          pthread_mutex_lock( &M_mutex );
+          M_stop = true;
+          pthread_cond_broadcast( &M_queue_cond );
+          pthread_mutex_unlock( &M_mutex );
+
+          for ( std::vector< pthread_t >::iterator t = M_threads.begin();
+                t != M_threads.end();
+                ++t )
+          {
+              pthread_join( *t, NULL );
+          }
+
+          pthread_cond_destroy( &M_done_cond );
+          pthread_cond_destroy( &M_queue_cond );
+          pthread_mutex_destroy( &M_mutex );
+#endif
+          for ( std::deque< Block * >::iterator b = M_blocks.begin();
+                b != M_blocks.end();
+                ++b )
+          {
+              delete *b;
+          }
+      }
+
+    bool setLevel( const int level )
+      {
+          if ( level < 1 || 9 < level )
+          {
+              return false;
+          }
+          M_level = level;
+          return true;
+      }
+
+    bool write( const char * buf,
+                std::size_t size )
+      {
+          if ( M_finished || M_error )
+          {
+              return false;
+          }
+
+          while ( size > 0 )
+          {
+              std::size_t n = std::min( size, M_block_size - M_current.size() );
+              M_current.append( buf, n );
+              buf += n;
+              size -= n;
+
+              if ( M_current.size() >= M_block_size )
+              {
+                  submit( false );
+              }
+          }
+
+          return writeBlocks( false );
+      }
+
+    bool flush()
+      {
+          if ( M_finished || M_error )
+          {
+              return false;
+          }
+
+          if ( ! M_current.empty() )
+          {
+              submit( false );
+          }
+
+          bool ret = writeBlocks( true );
+          M_dest.pubsync();
+          return ret;
+      }
+
+    bool finish()
+      {
+          if ( M_finished )
+          {
+              return ! M_error;
+          }
+
+          // the last block is always submitted to terminate the deflate stream.
+          submit( true );
+          writeBlocks( true );
+          M_finished = true;
+
+          if ( M_error )
+          {
+              return false;
+          }
+
+#ifdef HAVE_LIBZ
+          writeHeader();
+
+          // gzip trailer. crc32 and input size in little endian.
+          char trailer[8];
+          for ( int i = 0; i < 4; ++i )
+          {
+              trailer[i] = static_cast< char >( ( M_crc >> ( 8 * i ) ) & 0xff );
+              trailer[i + 4] = static_cast< char >( ( M_total_in >> ( 8 * i ) ) & 0xff );
+          }
+          M_dest.sputn( trailer, 8 );
+#endif
+          M_dest.pubsync();
+
+          return true;
+      }
+
+private:
+
+    /*!
+      \brief pass the current block to the workers.
+      \param last true if the block is the last one.
+     */
+    void submit( const bool last )
+      {
+          Block * block = new Block();
+          block->in_.swap( M_current );
+          block->dict_ = M_dict;
+          block->level_ = M_level;
+          block->last_ = last;
+
+          if ( block->in_.size() >= DICT_SIZE )
+          {
+              M_dict.assign( block->in_, block->in_.size() - DICT_SIZE, DICT_SIZE );
+          }
+          else
+          {
+              M_dict.append( block->in_ );
+              if ( M_dict.size() > DICT_SIZE )
+              {
+                  M_dict.erase( 0, M_dict.size() - DICT_SIZE );
+              }
+          }
+
+          M_current.reserve( M_block_size );
+          M_blocks.push_back( block );
+
+#ifdef HAVE_LIBZ
+          if ( ! M_threads.empty() )
+          {
+              pthread_mutex_lock( &M_mutex );
+              M_queue.push_back( block );
+              pthread_cond_signal( &M_queue_cond );
+              pthread_mutex_unlock( &M_mutex );
+              return;
+          }
+#endif
+          compressBlock( *block );
+          block->done_ = true;
+      }
+
+    /*!
+      \brief write the compressed blocks to the destination in order.
+      \param wait_all if true, wait until all submitted blocks are written.
+      \return false if compression error occured.
+
+      If too many blocks are waiting, this method blocks until the oldest
+      one is compressed, in order to keep the memory bounded.
+     */
+    bool writeBlocks( const bool wait_all )
+      {
+#ifdef HAVE_LIBZ
+          const std::size_t max_pending = 2 * std::max( M_threads.size(),
+                                                        static_cast< std::size_t >( 1 ) );
+#endif
+          while ( ! M_blocks.empty() )
+          {
+              Block * block = M_blocks.front();
+#ifdef HAVE_LIBZ
+              pthread_mutex_lock( &M_mutex );
+              if ( wait_all || M_blocks.size() > max_pending )
+              {
+                  while ( ! block->done_ )
+                  {
+                      pthread_cond_wait( &M_done_cond, &M_mutex );
+                  }
+              }
+              const bool done = block->done_;
+              pthread_mutex_unlock( &M_mutex );
+
+              if ( ! done )
+              {
+                  break;
+              }
+#endif
+              M_blocks.pop_front();
+
+              if ( ! block->ok_ )
+              {
+                  M_error = true;
+              }
+
+              if ( ! M_error )
+              {
+                  writeHeader();
+                  M_dest.sputn( block->out_.data(), block->out_.size() );
+#ifdef HAVE_LIBZ
+                  M_crc = crc32_combine( M_crc, block->crc_, block->in_.size() );
+#endif
+                  M_total_in += block->in_.size();
+              }
+
+              delete block;
+          }
+
+          return ! M_error;
+      }
+
+    /*!
+      \brief write the gzip member header only once.
+     */
+    void writeHeader()
+      {
+          if ( M_header_written )
+          {
+              return;
+          }
+          M_header_written = true;
+#ifdef HAVE_LIBZ
+          // magic, deflate, no flags, no mtime, no extra flags, unix.
+          static const char header[10] = { '\x1f', '\x8b', 8, 0,
+                                           0, 0, 0, 0,
+                                           0, 3 };
+          M_dest.sputn( header, 10 );
+#endif
+      }
+
+    /*!
+      \brief compress the block as a raw deflate stream.
+
+      Each block but the last ends with a sync flush, so that the
+      compressed blocks can be simply concatenated.
+     */
+    static
+    void compressBlock( Block & block )
+      {
+#ifdef HAVE_LIBZ
+          block.crc_ = crc32( crc32( 0L, Z_NULL, 0 ),
+                              reinterpret_cast< const Bytef * >( block.in_.data() ),
+                              block.in_.size() );
+
+          z_stream strm;
+          strm.zalloc = Z_NULL;
+          strm.zfree = Z_NULL;
+          strm.opaque = NULL;
+
+          if ( deflateInit2( &strm, block.level_, Z_DEFLATED,
+                             -15, 8, Z_DEFAULT_STRATEGY ) != Z_OK )
+          {
+              block.ok_ = false;
+              return;
+          }
+
+          if ( ! block.dict_.empty() )
+          {
+              deflateSetDictionary( &strm,
+                                    reinterpret_cast< const Bytef * >( block.dict_.data() ),
+                                    block.dict_.size() );
+          }
+
+          // deflateBound does not count the sync flush marker.
+          block.out_.resize( deflateBound( &strm, block.in_.size() ) + 16 );
+
+          strm.next_in = reinterpret_cast< Bytef * >( const_cast< char * >( block.in_.data() ) );
+          strm.avail_in = block.in_.size();
+          strm.next_out = reinterpret_cast< Bytef * >( &block.out_[0] );
+          strm.avail_out = block.out_.size();
+
+          int err = deflate( &strm, block.last_ ? Z_FINISH : Z_SYNC_FLUSH );
+
+          block.ok_ = ( block.last_
+                        ? err == Z_STREAM_END
+                        : ( err == Z_OK && strm.avail_in == 0 ) );
+          block.out_.resize( strm.total_out );
+
+          deflateEnd( &strm );
+#else
+          block.out_ = block.in_;
+          block.ok_ = true;
+#endif
+      }
+
+#ifdef HAVE_LIBZ
+    /*!
+      \brief worker thread entry point
+     */
+    static
+    void * worker_main( void * arg )
+      {
+          GZParallelCompressorImpl * self
+              = static_cast< GZParallelCompressorImpl * >( arg );
+
+          for ( ; ; )
+          {
+              pthread_mutex_lock( &self->M_mutex );
+              while ( self->M_queue.empty() && ! self->M_stop )
+              {
+                  pthread_cond_wait( &self->M_queue_cond, &self->M_mutex );
+              }
+
+              if ( self->M_queue.empty() )
+              {
+                  pthread_mutex_unlock( &self->M_mutex );
+                  break;
+              }
+
+              Block * block = self->M_queue.front();
+              self->M_queue.pop_front();
+              pthread_mutex_unlock( &self->M_mutex );
+
+              compressBlock( *block );
+
+              pthread_mutex_lock( &self->M_mutex );
+              block->done_ = true;
+              pthread_cond_broadcast( &self->M_done_cond );
+              pthread_mutex_unlock( &self->M_mutex );
+          }
+
+          return NULL;
+      }
+#endif
+};
+
+/////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+GZParallelCompressor::GZParallelCompressor( std::streambuf & dest,
+                                            const int level,
+                                            const int threads,
+                                            const std::size_t block_size )
+    : M_impl( new GZParallelCompressorImpl( dest, level, threads, block_size ) )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+GZParallelCompressor::~GZParallelCompressor()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+GZParallelCompressor::setLevel( const int level )
+{
+    return M_impl->setLevel( level );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+GZParallelCompressor::write( const char * buf,
+                             const std::size_t size )
+{
+    return M_impl->write( buf, size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+GZParallelCompressor::flush()
+{
+    return M_impl->flush();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+GZParallelCompressor::finish()
+{
+    return M_impl->finish();
+}
+
+}
@@ -0,0 +1,127 @@
+// -*-c++-*-
+
+/*!
+  \file gzparallelcompressor.h
+  \brief block parallel gzip compressor Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GZ_GZPARALLELCOMPRESSOR_H
+#define RCSC_GZ_GZPARALLELCOMPRESSOR_H
+
+#include <boost/scoped_ptr.hpp>
+
+#include <iostream>
+
+namespace rcsc {
+
+class GZParallelCompressorImpl;
+
+/*!
+  \class GZParallelCompressor
+  \brief block parallel gzip stream writer.
+
+  Input data is split into fixed size blocks. Each block is deflated
+  independently by the worker threads, primed with the last 32KB of the
+  previous block as the dictionary, and the compressed blocks are written
+  to the destination in the original order. The output is a single
+  standard gzip member, so it can be read by gzifstream or gunzip.
+
+  If the number of threads is 0, all blocks are compressed on the caller
+  thread.
+ */
+class GZParallelCompressor {
+private:
+
+    //! implementation object
+    boost::scoped_ptr< GZParallelCompressorImpl > M_impl;
+
+    //! not used
+    GZParallelCompressor( const GZParallelCompressor & );
+    //! not used
+    GZParallelCompressor & operator=( const GZParallelCompressor & );
+
+public:
+
+    /*!
+      \brief construct with the destination and the compression parameters
+      \param dest destination stream buffer
+      \param level zlib compression level. [1,9]
+      \param threads number of worker threads.
+      \param block_size size of the uncompressed block
+     */
+    GZParallelCompressor( std::streambuf & dest,
+                          const int level = 6,
+                          const int threads = 2,
+                          const std::size_t block_size = 128 * 1024 );
+
+    /*!
+      \brief finish the gzip stream if not finished yet, and stop all threads.
+     */
+    ~GZParallelCompressor();
+
+    /*!
+      \brief set zlib compression level used for the next blocks.
+      \param level zlib compression level. [1,9]
+      \return true if level is valid value.
+     */
+    bool setLevel( const int level );
+
+    /*!
+      \brief put the data to the current block.
+      \param buf pointer to the source buffer
+      \param size size of source buffer
+      \return false if compression error occured.
+
+      A full block is passed to the worker threads. Finished blocks are
+      written to the destination without blocking the caller, unless too
+      many blocks are waiting.
+     */
+    bool write( const char * buf,
+                const std::size_t size );
+
+    /*!
+      \brief compress the current partial block and write all pending blocks.
+      \return false if compression error occured.
+
+      The destination is flushed. The output written so far can be
+      decompressed up to the flushed point.
+     */
+    bool flush();
+
+    /*!
+      \brief compress all remaining data and write the gzip trailer.
+      \return false if compression error occured.
+
+      After this method is called, no more data can be written.
+     */
+    bool finish();
+
+};
+
+}
+
+#endif
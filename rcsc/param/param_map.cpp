@@ -35,6 +35,8 @@
 
 #include "param_map.h"
 
+#include <algorithm>
+#include <sstream>
 #include <functional>
 
 namespace rcsc {
@@ -263,8 +265,9 @@ ParamMap::add( ParamPtr param )
         return M_registrar;
     }
 
-    if ( M_long_name_map.find( param->longName() ) != M_long_name_map.end()
-         || M_short_name_map.find( param->shortName() ) != M_short_name_map.end() )
+    if ( findIndex( M_long_name_index, param->longName(), true ) >= 0
+         || ( ! param->shortName().empty()
+              && findIndex( M_short_name_index, param->shortName(), false ) >= 0 ) )
     {
         std::cerr << " ***ERROR*** "
                   << " the option name [" << param->longName()
@@ -283,6 +286,22 @@ ParamMap::add( ParamPtr param )
         M_short_name_map[ param->shortName() ] = param;
     }
 
+    // keep the load factor of the hash tables less than 0.5
+    if ( M_parameters.size() * 2 > M_long_name_index.size() )
+    {
+        rebuildIndex( std::max( static_cast< std::size_t >( 16 ),
+                                M_long_name_index.size() * 2 ) );
+    }
+    else
+    {
+        const int index = static_cast< int >( M_parameters.size() ) - 1;
+        insert_index( M_long_name_index, param->longName(), index );
+        if ( ! param->shortName().empty() )
+        {
+            insert_index( M_short_name_index, param->shortName(), index );
+        }
+    }
+
     return M_registrar;
 }
 
@@ -311,6 +330,9 @@ ParamMap::remove( const std::string & long_name )
 
         M_long_name_map.erase( it_long );
     }
+
+    // indices after the removed entry are shifted
+    rebuildIndex( M_long_name_index.size() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -320,12 +342,11 @@ ParamMap::remove( const std::string & long_name )
 ParamPtr
 ParamMap::findLongName( const std::string & long_name )
 {
-    std::map< std::string, ParamPtr >::iterator it
-        = M_long_name_map.find( long_name );
+    const int index = findIndex( M_long_name_index, long_name, true );
 
-    if ( it != M_long_name_map.end() )
+    if ( index >= 0 )
     {
-        return it->second;
+        return M_parameters[index];
     }
 
     // return NULL
@@ -339,12 +360,11 @@ ParamMap::findLongName( const std::string & long_name )
 ParamPtr
 ParamMap::findShortName( const std::string & short_name )
 {
-    std::map< std::string, ParamPtr >::iterator it
-        = M_short_name_map.find( short_name );
+    const int index = findIndex( M_short_name_index, short_name, false );
 
-    if ( it != M_short_name_map.end() )
+    if ( index >= 0 )
     {
-        return it->second;
+        return M_parameters[index];
     }
 
     // return NULL
@@ -431,4 +451,178 @@ ParamMap::printValues( std::ostream & os ) const
     return os << std::flush;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+ParamMap::hash_name( const std::string & name )
+{
+    // FNV-1a
+    boost::uint32_t h = 2166136261u;
+
+    const std::string::const_iterator end = name.end();
+    for ( std::string::const_iterator c = name.begin(); c != end; ++c )
+    {
+        h ^= static_cast< unsigned char >( *c );
+        h *= 16777619u;
+    }
+
+    return static_cast< std::size_t >( h );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+ParamMap::findIndex( const std::vector< int > & table,
+                     const std::string & name,
+                     const bool long_name ) const
+{
+    if ( table.empty() )
+    {
+        return -1;
+    }
+
+    const std::size_t mask = table.size() - 1;
+    for ( std::size_t i = hash_name( name ) & mask;
+          table[i] >= 0;
+          i = ( i + 1 ) & mask )
+    {
+        const ParamPtr & param = M_parameters[ table[i] ];
+        if ( ( long_name ? param->longName() : param->shortName() ) == name )
+        {
+            return table[i];
+        }
+    }
+
+    return -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ParamMap::insert_index( std::vector< int > & table,
+                        const std::string & name,
+                        const int index )
+{
+    const std::size_t mask = table.size() - 1;
+    std::size_t i = hash_name( name ) & mask;
+    while ( table[i] >= 0 )
+    {
+        i = ( i + 1 ) & mask;
+    }
+
+    table[i] = index;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ParamMap::rebuildIndex( const std::size_t size )
+{
+    M_long_name_index.assign( size, -1 );
+    M_short_name_index.assign( size, -1 );
+
+    if ( size == 0 )
+    {
+        return;
+    }
+
+    const int n = static_cast< int >( M_parameters.size() );
+    for ( int i = 0; i < n; ++i )
+    {
+        insert_index( M_long_name_index, M_parameters[i]->longName(), i );
+        if ( ! M_parameters[i]->shortName().empty() )
+        {
+            insert_index( M_short_name_index, M_parameters[i]->shortName(), i );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParamMap::writeBinary( std::ostream & os ) const
+{
+    const boost::uint32_t count = static_cast< boost::uint32_t >( M_parameters.size() );
+    write_binary_value( os, count );
+
+    std::ostringstream value;
+
+    const std::vector< ParamPtr >::const_iterator end = M_parameters.end();
+    for ( std::vector< ParamPtr >::const_iterator it = M_parameters.begin();
+          it != end;
+          ++it )
+    {
+        value.str( std::string() );
+        if ( ! (*it)->writeBinary( value ) )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " ***ERROR*** failed to write the parameter ["
+                      << (*it)->longName() << "]"
+                      << std::endl;
+            return false;
+        }
+
+        write_binary_value( os, (*it)->longName() );
+        write_binary_value( os, value.str() );
+    }
+
+    return os.good();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParamMap::readBinary( std::istream & is )
+{
+    boost::uint32_t count = 0;
+    if ( ! read_binary_value( is, count ) )
+    {
+        return false;
+    }
+
+    std::string name;
+    std::string value;
+    for ( boost::uint32_t i = 0; i < count; ++i )
+    {
+        if ( ! read_binary_value( is, name )
+             || ! read_binary_value( is, value ) )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " ***ERROR*** broken binary parameter data."
+                      << std::endl;
+            return false;
+        }
+
+        const int index = findIndex( M_long_name_index, name, true );
+        if ( index < 0 )
+        {
+            continue;
+        }
+
+        std::istringstream istrm( value );
+        if ( ! M_parameters[index]->readBinary( istrm ) )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " ***ERROR*** failed to read the parameter ["
+                      << name << "]"
+                      << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 }
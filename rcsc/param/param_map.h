@@ -34,6 +34,7 @@
 
 #include <boost/shared_ptr.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/cstdint.hpp>
 
 #include <vector>
 #include <map>
@@ -62,6 +63,80 @@ struct BoolSwitch {
       }
 };
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the value as the raw bytes
+  \param os reference to the binary output stream
+  \param value value to be written
+  \return true if successfully written
+ */
+template < typename ValueType >
+inline
+bool
+write_binary_value( std::ostream & os,
+                    const ValueType & value )
+{
+    os.write( reinterpret_cast< const char * >( &value ), sizeof( ValueType ) );
+    return os.good();
+}
+
+/*!
+  \brief write the string with its length
+  \param os reference to the binary output stream
+  \param value string to be written
+  \return true if successfully written
+ */
+inline
+bool
+write_binary_value( std::ostream & os,
+                    const std::string & value )
+{
+    const boost::uint32_t len = static_cast< boost::uint32_t >( value.length() );
+    os.write( reinterpret_cast< const char * >( &len ), sizeof( len ) );
+    os.write( value.data(), len );
+    return os.good();
+}
+
+/*!
+  \brief read the value written by write_binary_value()
+  \param is reference to the binary input stream
+  \param value reference to the result variable
+  \return true if successfully read
+ */
+template < typename ValueType >
+inline
+bool
+read_binary_value( std::istream & is,
+                   ValueType & value )
+{
+    is.read( reinterpret_cast< char * >( &value ), sizeof( ValueType ) );
+    return is.good();
+}
+
+/*!
+  \brief read the string written by write_binary_value()
+  \param is reference to the binary input stream
+  \param value reference to the result string
+  \return true if successfully read
+ */
+inline
+bool
+read_binary_value( std::istream & is,
+                   std::string & value )
+{
+    boost::uint32_t len = 0;
+    if ( ! is.read( reinterpret_cast< char * >( &len ), sizeof( len ) ) )
+    {
+        return false;
+    }
+    value.resize( len );
+    if ( len > 0 )
+    {
+        is.read( &value[0], len );
+    }
+    return is.good();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
   \class ParamEntity
@@ -169,6 +244,22 @@ public:
     virtual
     std::ostream & printValue( std::ostream & os ) const = 0;
 
+    /*!
+      \brief pure virtual method. write the raw value to the binary stream
+      \param os reference to the binary stream
+      \return true if successfully written
+     */
+    virtual
+    bool writeBinary( std::ostream & os ) const = 0;
+
+    /*!
+      \brief pure virtual method. read the raw value from the binary stream
+      \param is reference to the binary stream
+      \return true if successfully read
+     */
+    virtual
+    bool readBinary( std::istream & is ) = 0;
+
 };
 
 /*!
@@ -247,6 +338,26 @@ public:
           return os << *M_value_ptr;
       }
 
+    /*!
+      \brief write the raw value to the binary stream
+      \param os reference to the binary stream
+      \return true if successfully written
+     */
+    bool writeBinary( std::ostream & os ) const
+      {
+          return write_binary_value( os, *M_value_ptr );
+      }
+
+    /*!
+      \brief read the raw value from the binary stream
+      \param is reference to the binary stream
+      \return true if successfully read
+     */
+    bool readBinary( std::istream & is )
+      {
+          return read_binary_value( is, *M_value_ptr );
+      }
+
 };
 
 /*-------------------------------------------------------------------*/
@@ -293,6 +404,26 @@ public:
      */
     std::ostream & printValue( std::ostream & os ) const;
 
+    /*!
+      \brief write the raw value to the binary stream
+      \param os reference to the binary stream
+      \return true if successfully written
+     */
+    bool writeBinary( std::ostream & os ) const
+      {
+          return write_binary_value( os, *M_value_ptr );
+      }
+
+    /*!
+      \brief read the raw value from the binary stream
+      \param is reference to the binary stream
+      \return true if successfully read
+     */
+    bool readBinary( std::istream & is )
+      {
+          return read_binary_value( is, *M_value_ptr );
+      }
+
 };
 
 /*-------------------------------------------------------------------*/
@@ -349,6 +480,26 @@ public:
      */
     std::ostream & printValue( std::ostream & os ) const;
 
+    /*!
+      \brief write the raw value to the binary stream
+      \param os reference to the binary stream
+      \return true if successfully written
+     */
+    bool writeBinary( std::ostream & os ) const
+      {
+          return write_binary_value( os, *M_value_ptr );
+      }
+
+    /*!
+      \brief read the raw value from the binary stream
+      \param is reference to the binary stream
+      \return true if successfully read
+     */
+    bool readBinary( std::istream & is )
+      {
+          return read_binary_value( is, *M_value_ptr );
+      }
+
 };
 
 
@@ -440,6 +591,12 @@ private:
     //! short name option map
     std::map< std::string, ParamPtr > M_short_name_map;
 
+    //! hash table for the long names. value is the index of M_parameters, or -1.
+    std::vector< int > M_long_name_index;
+
+    //! hash table for the short names. value is the index of M_parameters, or -1.
+    std::vector< int > M_short_name_index;
+
 public:
 
     /*!
@@ -561,6 +718,60 @@ public:
       \return reference to output stream
      */
     std::ostream & printValues( std::ostream & os ) const;
+
+    /*!
+      \brief write all parameter values to the binary stream
+      \param os reference to the binary output stream
+      \return true if successfully written
+
+      format: <count> { <name length> <name> <value size> <value> }...
+     */
+    bool writeBinary( std::ostream & os ) const;
+
+    /*!
+      \brief read parameter values written by writeBinary()
+      \param is reference to the binary input stream
+      \return true if successfully read. unknown names are skipped.
+     */
+    bool readBinary( std::istream & is );
+
+    /*!
+      \brief get the hash value of the parameter name (FNV-1a)
+      \param name parameter name
+      \return hash value
+     */
+    static
+    std::size_t hash_name( const std::string & name );
+
+private:
+
+    /*!
+      \brief find the parameter index by the hash table
+      \param table hash table
+      \param name searched name
+      \param long_name if true, long name is compared, else short name.
+      \return index of M_parameters, or -1 if not found.
+     */
+    int findIndex( const std::vector< int > & table,
+                   const std::string & name,
+                   const bool long_name ) const;
+
+    /*!
+      \brief insert the parameter index into the hash table
+      \param table reference to the hash table
+      \param name parameter name
+      \param index index of M_parameters
+     */
+    static
+    void insert_index( std::vector< int > & table,
+                       const std::string & name,
+                       const int index );
+
+    /*!
+      \brief recreate the hash tables from M_parameters
+      \param size new table size. must be a power of 2.
+     */
+    void rebuildIndex( const std::size_t size );
 };
 
 }
@@ -45,6 +45,8 @@
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/logger.h>
 
+#include <algorithm>
+
 namespace rcsc {
 
 /*-------------------------------------------------------------------*/
@@ -75,6 +77,9 @@ ActionEffector::ActionEffector( const PlayerAgent & agent )
     , M_tackle_dir( 0.0 )
     , M_turn_neck_moment( 0.0 )
     , M_say_message( "" )
+    , M_say_cycle_count( 0 )
+    , M_say_utility_sum( 0.0 )
+    , M_say_dropped_count( 0 )
     , M_pointto_pos( 0.0, 0.0 )
 {
     for ( int i = PlayerCommand::INIT;
@@ -1316,6 +1321,61 @@ ActionEffector::getSayMessageLength() const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+ActionEffector::selectSayMessages( std::vector< int > & selected ) const
+{
+    const int n = static_cast< int >( M_say_messages.size() );
+    const int budget = std::max( 0, ServerParam::i().playerSayMsgSize() );
+    const int width = budget + 1;
+
+    selected.assign( n, 0 );
+
+    std::vector< int > length( n, 0 );
+    std::vector< double > utility( n, 0.0 );
+    for ( int i = 0; i < n; ++i )
+    {
+        length[i] = static_cast< int >( M_say_messages[i]->length() );
+        utility[i] = M_say_messages[i]->utility( M_agent.world() );
+    }
+
+    // best[i * width + w] : max utility of the first i messages within w characters
+    std::vector< double > best( ( n + 1 ) * width, 0.0 );
+
+    for ( int i = 0; i < n; ++i )
+    {
+        const double * prev = &best[i * width];
+        double * cur = &best[( i + 1 ) * width];
+
+        for ( int w = 0; w < width; ++w )
+        {
+            cur[w] = prev[w];
+            if ( length[i] <= w
+                 && utility[i] > 0.0
+                 && prev[w - length[i]] + utility[i] > cur[w] )
+            {
+                cur[w] = prev[w - length[i]] + utility[i];
+            }
+        }
+    }
+
+    // trace back the selection
+    int w = budget;
+    for ( int i = n - 1; i >= 0; --i )
+    {
+        if ( best[( i + 1 ) * width + w] != best[i * width + w] )
+        {
+            selected[i] = 1;
+            w -= length[i];
+        }
+    }
+
+    return best[n * width + budget];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 ActionEffector::makeSayCommand()
@@ -1331,12 +1391,25 @@ ActionEffector::makeSayCommand()
     // std::sort( M_say_messages.begin(), M_say_messages.end(),
     //            SayMessagePtrSorter() );
 
-    const std::vector< const SayMessage * >::const_iterator end = M_say_messages.end();
-    for ( std::vector< const SayMessage * >::const_iterator it = M_say_messages.begin();
-          it != end;
-          ++it )
+    std::vector< int > selected;
+    const double utility = selectSayMessages( selected );
+
+    // messages are encoded in the registered order
+    const int n = static_cast< int >( M_say_messages.size() );
+    for ( int i = 0; i < n; ++i )
     {
-        (*it)->toStr( M_say_message );
+        if ( selected[i] )
+        {
+            M_say_messages[i]->toStr( M_say_message );
+        }
+        else
+        {
+            dlog.addText( Logger::ACTION,
+                          __FILE__": say message [%c] is dropped. length=%d",
+                          M_say_messages[i]->header(),
+                          static_cast< int >( M_say_messages[i]->length() ) );
+            ++M_say_dropped_count;
+        }
     }
 
     if ( M_say_message.empty() )
@@ -1344,6 +1417,13 @@ ActionEffector::makeSayCommand()
         return;
     }
 
+    ++M_say_cycle_count;
+    M_say_utility_sum += utility;
+
+    dlog.addText( Logger::ACTION,
+                  __FILE__": say utility %.1f bits. average %.2f bits/cycle",
+                  utility, M_say_utility_sum / M_say_cycle_count );
+
     M_command_say = new PlayerSayCommand( M_say_message,
                                           M_agent.config().version() );
 
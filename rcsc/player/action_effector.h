@@ -117,6 +117,11 @@ private:
     std::string M_say_message; //!< last said message string
     std::vector< const SayMessage * > M_say_messages;
 
+    // say scheduler statistics
+    long M_say_cycle_count; //!< the number of cycles when say command was sent
+    double M_say_utility_sum; //!< total utility bits of the sent messages
+    long M_say_dropped_count; //!< the number of messages dropped by the budget
+
     // pointto effect
     Vector2D M_pointto_pos;  //!< last pointto coordinates
 
@@ -504,6 +509,33 @@ public:
           return M_say_messages;
       }
 
+    /*!
+      \brief get the number of cycles when say command was sent
+      \return cycle count
+     */
+    long sayCycleCount() const
+      {
+          return M_say_cycle_count;
+      }
+
+    /*!
+      \brief get the total utility bits of the sent say messages
+      \return total utility bits
+     */
+    double sayUtilitySum() const
+      {
+          return M_say_utility_sum;
+      }
+
+    /*!
+      \brief get the number of say messages dropped by the message size limit
+      \return dropped message count
+     */
+    long sayDroppedCount() const
+      {
+          return M_say_dropped_count;
+      }
+
     //////////////////////////////////////////
     /*!
       \brief get pointto action effect
@@ -562,6 +594,14 @@ public:
 
 private:
 
+    /*!
+      \brief select the say messages that maximize the total utility
+      within the message size limit (0-1 knapsack).
+      \param selected reference to the variable to store the selection flags
+      \return total utility of the selected messages
+     */
+    double selectSayMessages( std::vector< int > & selected ) const;
+
     /*!
       \brief create say command object using the registered say message objects
      */
@@ -41,7 +41,6 @@
 #include <rcsc/net/udp_socket.h>
 
 #include <algorithm>
-#include <sstream>
 #include <iostream>
 #include <cstdarg>
 #include <cstdio>
@@ -72,54 +71,91 @@ ROUND( const double & val,
 
 /*-------------------------------------------------------------------*/
 
+/*!
+  \brief append the formatted string to the buffer.
+
+  All numbers are formatted by "%g", that is same as the default
+  format of std::ostream. The long string is formatted again into
+  the buffer sized from the result length.
+*/
+void
+append( std::string & buf,
+        const char * format, ... )
+{
+    char tmp[256];
+    va_list argp;
+    va_start( argp, format );
+    int n = vsnprintf( tmp, sizeof( tmp ), format, argp );
+    va_end( argp );
+
+    if ( n <= 0 )
+    {
+        return;
+    }
+
+    if ( n < static_cast< int >( sizeof( tmp ) ) )
+    {
+        buf.append( tmp, n );
+        return;
+    }
+
+    std::vector< char > long_buf( n + 1 );
+    va_start( argp, format );
+    vsnprintf( &long_buf[0], long_buf.size(), format, argp );
+    va_end( argp );
+
+    buf.append( &long_buf[0], n );
+}
+
+/*-------------------------------------------------------------------*/
+
 class PlayerPrinter {
 private:
-    std::ostream & M_os;
+    std::string & M_buf;
     const char M_tag;
 public:
-    PlayerPrinter( std::ostream & os,
-                     const char tag )
-        : M_os( os )
+    PlayerPrinter( std::string & buf,
+                   const char tag )
+        : M_buf( buf )
         , M_tag( tag )
       { }
 
     void operator()( const PlayerObject & p )
       {
-          M_os << " (";
           if ( p.unum() != Unum_Unknown )
           {
-              M_os << M_tag << ' ' << p.unum();
+              append( M_buf, " (%c %d", M_tag, p.unum() );
           }
           else if ( M_tag == 'u' )
           {
-              M_os << M_tag;
+              M_buf += " (u";
           }
           else
           {
-              M_os << 'u' << M_tag;
+              append( M_buf, " (u%c", M_tag );
           }
 
-          M_os << ' ' << ROUND( p.pos().x, 0.01 )
-               << ' ' << ROUND( p.pos().y, 0.01 );
+          append( M_buf, " %g %g",
+                  ROUND( p.pos().x, 0.01 ),
+                  ROUND( p.pos().y, 0.01 ) );
 
           if ( p.bodyValid() )
           {
-              M_os << " (bd " << rint( p.body().degree() )
-                   << ')';
+              append( M_buf, " (bd %g)", rint( p.body().degree() ) );
           }
 
-          M_os << " (c \""
-               << ( p.goalie() ? 'G' : M_tag )
-               << p.posCount()
-               << 'v' << p.velCount();
+          append( M_buf, " (c \"%c%dv%d",
+                  ( p.goalie() ? 'G' : M_tag ),
+                  p.posCount(),
+                  p.velCount() );
 
           if ( p.velCount() <= 100 )
           {
-              M_os << '(' << ROUND( p.vel().x, 0.1 )
-                   << ' ' << ROUND( p.vel().y, 0.1 )
-                   << ')';
+              append( M_buf, "(%g %g)",
+                      ROUND( p.vel().x, 0.1 ),
+                      ROUND( p.vel().y, 0.1 ) );
           }
-          M_os << 'f' << p.faceCount() << "\"))";
+          append( M_buf, "f%d\"))", p.faceCount() );
       }
 };
 
@@ -127,71 +163,71 @@ public:
 
 class LinePrinter {
 private:
-    std::ostream & M_os;
+    std::string & M_buf;
 public:
-    LinePrinter( std::ostream & os )
-        : M_os( os )
+    LinePrinter( std::string & buf )
+        : M_buf( buf )
       { }
     void operator()( const std::pair< Vector2D, Vector2D > & line )
       {
-          M_os << " (line "
-               << ROUND( line.first.x, 0.001 ) << ' '
-               << ROUND( line.first.y, 0.001 ) << ' '
-               << ROUND( line.second.x, 0.001 ) << ' '
-               << ROUND( line.second.y, 0.001 ) << ')';
+          append( M_buf, " (line %g %g %g %g)",
+                  ROUND( line.first.x, 0.001 ),
+                  ROUND( line.first.y, 0.001 ),
+                  ROUND( line.second.x, 0.001 ),
+                  ROUND( line.second.y, 0.001 ) );
       }
 };
 
 
 class TrianglePrinter {
 private:
-    std::ostream & M_os;
+    std::string & M_buf;
 public:
-    TrianglePrinter( std::ostream & os )
-        : M_os( os )
+    TrianglePrinter( std::string & buf )
+        : M_buf( buf )
       { }
     void operator()( const Triangle2D & tri )
       {
-          M_os << " (tri "
-               << ROUND( tri.a().x, 0.001 ) << ' '
-               << ROUND( tri.a().y, 0.001 ) << ' '
-               << ROUND( tri.b().x, 0.001 ) << ' '
-               << ROUND( tri.b().y, 0.001 ) << ' '
-               << ROUND( tri.c().x, 0.001 ) << ' '
-               << ROUND( tri.c().y, 0.001 ) << ')';
+          append( M_buf, " (tri %g %g %g %g %g %g)",
+                  ROUND( tri.a().x, 0.001 ),
+                  ROUND( tri.a().y, 0.001 ),
+                  ROUND( tri.b().x, 0.001 ),
+                  ROUND( tri.b().y, 0.001 ),
+                  ROUND( tri.c().x, 0.001 ),
+                  ROUND( tri.c().y, 0.001 ) );
       }
 };
 
 class RectPrinter {
 private:
-    std::ostream & M_os;
+    std::string & M_buf;
 public:
-    RectPrinter( std::ostream & os )
-        : M_os( os )
+    RectPrinter( std::string & buf )
+        : M_buf( buf )
       { }
     void operator()( const Rect2D & rect )
       {
-          M_os << " (rect "
-               << ROUND( rect.left(), 0.001 ) << ' '
-               << ROUND( rect.top(), 0.001 ) << ' '
-               << ROUND( rect.right(), 0.001 ) << ' '
-               << ROUND( rect.bottom(), 0.001 ) << ')';
+          append( M_buf, " (rect %g %g %g %g)",
+                  ROUND( rect.left(), 0.001 ),
+                  ROUND( rect.top(), 0.001 ),
+                  ROUND( rect.right(), 0.001 ),
+                  ROUND( rect.bottom(), 0.001 ) );
       }
 };
 
 class CirclePrinter {
 private:
-    std::ostream & M_os;
+    std::string & M_buf;
 public:
-    CirclePrinter( std::ostream & os )
-        : M_os( os )
+    CirclePrinter( std::string & buf )
+        : M_buf( buf )
       { }
     void operator()( const Circle2D & circle )
       {
-          M_os << " (circle "
-               << ROUND( circle.center().x, 0.001 ) << ' '
-               << ROUND( circle.center().y, 0.001 ) << ' '
-               << ROUND( circle.radius(), 0.001 ) << ')';
+          append( M_buf, " (circle %g %g %g)",
+                  ROUND( circle.center().x, 0.001 ),
+                  ROUND( circle.center().y, 0.001 ),
+                  ROUND( circle.radius(), 0.001 ) );
       }
 };
 
@@ -215,7 +251,10 @@ DebugClient::DebugClient()
 {
     M_main_buffer.reserve( 8192 );
     M_message.reserve( 8192 );
-    M_lines.reserve( 100 );
+    M_lines.reserve( MAX_LINE );
+    M_triangles.reserve( MAX_TRIANGLE );
+    M_rectangles.reserve( MAX_RECT );
+    M_circles.reserve( MAX_CIRCLE );
 }
 
 /*-------------------------------------------------------------------*/
@@ -276,15 +315,22 @@ DebugClient::writeAll( const WorldModel & world )
 {
     if ( M_on )
     {
-        this->toStr( world );
+        const bool write_mode = ( M_write_mode
+                                  && world.time().stopped() == 0 );
+
+        // the message is built only when it is sent or written
+        if ( M_connected
+             || write_mode )
+        {
+            this->toStr( world );
+        }
 
         if ( M_connected )
         {
             this->send();
         }
 
-        if ( M_write_mode
-             && world.time().stopped() == 0 )
+        if ( write_mode )
         {
             this->write( world.time().cycle() );
         }
@@ -319,10 +365,12 @@ DebugClient::close()
 void
 DebugClient::toStr( const WorldModel & world )
 {
-    std::ostringstream ostr;
+    // the buffer keeps its capacity, so no allocation occurs in usual cycles.
+    std::string & buf = M_main_buffer;
+    buf.erase();
 
-    ostr << "((debug (format-version 2)) (time "
-         << world.time().cycle() << ")";
+    append( buf, "((debug (format-version 2)) (time %ld)",
+            world.time().cycle() );
 
 
     // self
@@ -341,20 +389,18 @@ DebugClient::toStr( const WorldModel & world )
     */
     if ( world.self().posValid() )
     {
-        ostr << " (s "
-             << ( world.isOurLeft() ? "l " : "r " )
-             << world.self().unum() << ' '
-             << ROUND(world.self().pos().x, 0.01) << ' '
-             << ROUND(world.self().pos().y, 0.01) << ' '
-             << ROUND(world.self().vel().x, 0.01) << ' '
-             << ROUND(world.self().vel().y, 0.01) << ' '
-             << ROUND(world.self().body().degree(), 0.1) << ' '
-             << ROUND(world.self().neck().degree(), 0.1) << " (c \""
-             << world.self().posCount() << ' '
-            //<< '(' << ROUND(world.self().posError().x, 0.001)
-            //<< ", " << ROUND(world.self().posError().y, 0.001) << ") "
-             << world.self().velCount() << ' '
-             << world.self().faceCount() << "\"))";
+        append( buf, " (s %c %d %g %g %g %g %g %g (c \"%d %d %d\"))",
+                ( world.isOurLeft() ? 'l' : 'r' ),
+                world.self().unum(),
+                ROUND(world.self().pos().x, 0.01),
+                ROUND(world.self().pos().y, 0.01),
+                ROUND(world.self().vel().x, 0.01),
+                ROUND(world.self().vel().y, 0.01),
+                ROUND(world.self().body().degree(), 0.1),
+                ROUND(world.self().neck().degree(), 0.1),
+                world.self().posCount(),
+                world.self().velCount(),
+                world.self().faceCount() );
     }
 
     // ball
@@ -363,22 +409,19 @@ DebugClient::toStr( const WorldModel & world )
     */
     if ( world.ball().posValid() )
     {
-        ostr << " (b "
-             << ROUND(world.ball().pos().x, 0.01) << ' '
-             << ROUND(world.ball().pos().y, 0.01);
+        append( buf, " (b %g %g",
+                ROUND(world.ball().pos().x, 0.01),
+                ROUND(world.ball().pos().y, 0.01) );
         if ( world.ball().velValid() )
         {
-            ostr << ' ' << ROUND(world.ball().vel().x, 0.01)
-                 << ' ' << ROUND(world.ball().vel().y, 0.01);
+            append( buf, " %g %g",
+                    ROUND(world.ball().vel().x, 0.01),
+                    ROUND(world.ball().vel().y, 0.01) );
         }
-        ostr << " (c \"g" << world.ball().posCount()
-             << 'r' << world.ball().rposCount()
-            //<< "(" << ROUND(world.ball().rpos().x, 0.01)
-            // << ", " << ROUND(world.ball().rpos().y, 0.01) << ')'
-             << 'v' << world.ball().velCount()
-            //<< "(" << ROUND(world.ball().vel().x, 0.01)
-            // << ", " << ROUND(world.ball().vel().y, 0.01) << ')'
-             << "\"))";
+        append( buf, " (c \"g%dr%dv%d\"))",
+                world.ball().posCount(),
+                world.ball().rposCount(),
+                world.ball().velCount() );
     }
 
     // players
@@ -395,52 +438,51 @@ DebugClient::toStr( const WorldModel & world )
 
     std::for_each( world.teammates().begin(),
                    world.teammates().end(),
-                   PlayerPrinter( ostr, 't' ) );
+                   PlayerPrinter( buf, 't' ) );
 
     std::for_each( world.opponents().begin(),
                    world.opponents().end(),
-                   PlayerPrinter( ostr, 'o' ) );
+                   PlayerPrinter( buf, 'o' ) );
 
     std::for_each( world.unknownPlayers().begin(),
                    world.unknownPlayers().end(),
-                   PlayerPrinter( ostr, 'u' ) );
+                   PlayerPrinter( buf, 'u' ) );
 
     // target number
     if ( M_target_unum != 0 )
     {
-        ostr << " (target-teammate " << M_target_unum << ")";
+        append( buf, " (target-teammate %d)", M_target_unum );
     }
 
     // target point
     if ( M_target_point.valid() )
     {
-        ostr << " (target-point "
-             << M_target_point.x << " " << M_target_point.y
-             << ")";
+        append( buf, " (target-point %g %g)",
+                M_target_point.x, M_target_point.y );
     }
 
     // message
     if ( ! M_message.empty() )
     {
-        ostr << " (message \"" << M_message << "\")";
+        buf += " (message \"";
+        buf += M_message;
+        buf += "\")";
     }
 
     // lines
     std::for_each( M_lines.begin(), M_lines.end(),
-                   LinePrinter( ostr ) );
+                   LinePrinter( buf ) );
     // triangles
     std::for_each( M_triangles.begin(), M_triangles.end(),
-                   TrianglePrinter( ostr ) );
+                   TrianglePrinter( buf ) );
     // rectangles
     std::for_each( M_rectangles.begin(), M_rectangles.end(),
-                   RectPrinter( ostr ) );
+                   RectPrinter( buf ) );
     // circles
     std::for_each( M_circles.begin(), M_circles.end(),
-                   CirclePrinter( ostr ) );
-
-    ostr << ")";
+                   CirclePrinter( buf ) );
 
-    M_main_buffer.assign( ostr.str() );
+    buf += ')';
 }
 
 /*-------------------------------------------------------------------*/
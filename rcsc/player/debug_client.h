@@ -64,6 +64,7 @@ public:
         SoccerWindow2,
     };
 
+    // the capacity of the shape containers is reserved only once.
     static const std::size_t MAX_LINE = 50;
     static const std::size_t MAX_TRIANGLE = 50;
     static const std::size_t MAX_RECT = 50;
@@ -83,7 +84,7 @@ private:
     //! flag to check write mode
     bool M_write_mode;
 
-    //! main buffer to output all
+    //! main buffer to output all. reused every cycle.
     std::string M_main_buffer;
     //! target number shown in display
     int M_target_unum;
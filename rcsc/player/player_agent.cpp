@@ -50,6 +50,7 @@
 #include <rcsc/common/audio_memory.h>
 #include <rcsc/common/basic_client.h>
 #include <rcsc/common/logger.h>
+#include <rcsc/common/param_snapshot.h>
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/player_type.h>
 #include <rcsc/common/server_param.h>
@@ -65,6 +66,7 @@
 #include <cstring>
 
 //#define PROFILE_SEE
+//#define PROFILE_VIEW
 
 namespace rcsc {
 
@@ -120,6 +122,13 @@ struct PlayerAgentImpl {
     //! counter of see message arrival timing
     int see_timings_[11];
 
+#ifdef PROFILE_VIEW
+    long view_cycles_; //!< the number of profiled play_on cycles
+    long ball_count_sum_; //!< sum of the ball accuracy count
+    long player_count_sum_; //!< sum of the player accuracy count
+    long player_samples_; //!< the number of player samples
+#endif
+
     //! pointer to reserved action
     boost::shared_ptr< ArmAction > arm_action_;
 
@@ -132,6 +141,9 @@ struct PlayerAgentImpl {
     //! intention queue
     boost::shared_ptr< SoccerIntention > intention_;
 
+    //! binary cache of the server parameter messages
+    ParamSnapshot param_snapshot_;
+
     /*!
       \brief initialize all members
     */
@@ -146,6 +158,12 @@ struct PlayerAgentImpl {
         , clang_max_( 0 )
       {
           for ( int i = 0; i < 11; ++i ) see_timings_[i] = 0;
+#ifdef PROFILE_VIEW
+          view_cycles_ = 0;
+          ball_count_sum_ = 0;
+          player_count_sum_ = 0;
+          player_samples_ = 0;
+#endif
       }
 
     /*!
@@ -529,6 +547,8 @@ PlayerAgent::initImpl( CmdLineParser & cmd_parser )
 
     setDebugFlags();
 
+    M_impl->param_snapshot_.open( config().paramSnapshot() );
+
     SelfObject::set_count_thr( config().selfPosCountThr(),
                                config().selfVelCountThr(),
                                config().selfFaceCountThr() );
@@ -772,6 +792,32 @@ PlayerAgent::finalize()
         std::printf( "%6d", M_impl->see_timings_[i] );
     }
     std::printf( "\n" );
+#endif
+#ifdef PROFILE_VIEW
+    std::cout << config().teamName() << ' '
+              << world().self().unum() << ": "
+              << "profile view: cycles=" << M_impl->view_cycles_
+              << " ball_count=" << ( M_impl->view_cycles_ > 0
+                                     ? static_cast< double >( M_impl->ball_count_sum_ )
+                                     / M_impl->view_cycles_
+                                     : 0.0 )
+              << " player_count=" << ( M_impl->player_samples_ > 0
+                                       ? static_cast< double >( M_impl->player_count_sum_ )
+                                       / M_impl->player_samples_
+                                       : 0.0 )
+              << std::endl;
+#endif
+#ifdef PROFILE_SAY
+    std::cout << config().teamName() << ' '
+              << world().self().unum() << ": "
+              << "profile say: cycles=" << effector().sayCycleCount()
+              << " bits=" << effector().sayUtilitySum()
+              << " bits/cycle="
+              << ( effector().sayCycleCount() > 0
+                   ? effector().sayUtilitySum() / effector().sayCycleCount()
+                   : 0.0 )
+              << " dropped=" << effector().sayDroppedCount()
+              << std::endl;
 #endif
     std::cout << config().teamName() << ' '
               << world().self().unum() << ": "
@@ -1352,10 +1398,7 @@ PlayerAgent::analyzePlayerType( const char * msg )
 {
     dlog.addText( Logger::SENSOR,
                   "===receive player_type" );
-    PlayerType player_type( ServerParam::i(),
-                            msg,
-                            config().version() );
-    PlayerTypeSet::instance().insert( player_type );
+    M_impl->param_snapshot_.parsePlayerType( msg, config().version() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -1367,7 +1410,7 @@ PlayerAgent::analyzePlayerParam( const char * msg )
 {
     dlog.addText( Logger::SENSOR,
                   "===receive player_param" );
-    PlayerParam::instance().parse( msg, config().version() );
+    M_impl->param_snapshot_.parsePlayerParam( msg, config().version() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -1380,7 +1423,7 @@ PlayerAgent::analyzeServerParam( const char * msg )
     dlog.addText( Logger::SENSOR,
                   "===receive server_param" );
     //std::cout << msg << std::endl;
-    ServerParam::instance().parse( msg, config().version() );
+    M_impl->param_snapshot_.parseServerParam( msg, config().version() );
     PlayerTypeSet::instance().resetDefaultType( ServerParam::i() );
 
     M_worldmodel.setTeammatePlayerType( world().self().unum(),
@@ -1774,6 +1817,29 @@ PlayerAgent::action()
     // reset last action effect
     M_effector.reset();
 
+#ifdef PROFILE_VIEW
+    if ( world().gameMode().type() == GameMode::PlayOn )
+    {
+        // accuracy of the key objects: the ball and the players near the ball
+        M_impl->view_cycles_ += 1;
+        M_impl->ball_count_sum_ += std::min( world().ball().posCount(), 100 );
+
+        const AbstractPlayerCont::const_iterator end = world().allPlayers().end();
+        for ( AbstractPlayerCont::const_iterator p = world().allPlayers().begin();
+              p != end;
+              ++p )
+        {
+            if ( (*p)->isSelf()
+                 || (*p)->distFromBall() > 20.0 )
+            {
+                continue;
+            }
+            M_impl->player_count_sum_ += std::min( (*p)->posCount(), 100 );
+            M_impl->player_samples_ += 1;
+        }
+    }
+#endif
+
     // ------------------------------------------------------------------------
     // decide action
 
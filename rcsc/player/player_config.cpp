@@ -114,6 +114,8 @@ PlayerConfig::setDefaultParam()
     M_config_dir = "./";
     M_player_number = 0;
 
+    M_param_snapshot = "";
+
 
     //
     // debug
@@ -193,6 +195,8 @@ PlayerConfig::createParamMap( ParamMap & param_map )
         ( "config_dir", "", &M_config_dir )
         ( "player_number", "n",  &M_player_number )
 
+        ( "param_snapshot", "", &M_param_snapshot )
+
         ( "debug_connect", "", BoolSwitch( &M_debug_connect ) )
         ( "debug_server_host", "", &M_debug_server_host )
         ( "debug_server_port", "", &M_debug_server_port )
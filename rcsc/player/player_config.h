@@ -98,6 +98,9 @@ private:
     //! specifies player's number independent of uniform number
     int M_player_number;
 
+    //! binary snapshot file of the server parameters. if empty, not used.
+    std::string M_param_snapshot;
+
 
     // debug
 
@@ -308,6 +311,12 @@ public:
           return M_player_number;
       }
 
+    const
+    std::string & paramSnapshot() const
+      {
+          return M_param_snapshot;
+      }
+
     void setPlayerNumber( const int num )
       {
           M_player_number = num;
@@ -35,18 +35,80 @@
 
 #include "say_message_builder.h"
 
+#include "world_model.h"
+
 #include <rcsc/common/audio_codec.h>
+#include <rcsc/common/audio_memory.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/math_util.h>
 
+#include <algorithm>
 #include <cstring>
+#include <cmath>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the relevance factor by the teammates' need.
+  \param heard_time last time when the same kind of info was heard
+  \param current current game time
+  \return 0.5 if the info was heard in this cycle, 1.0 if it was not
+  heard during the last 10 cycles.
+*/
+inline
+double
+need_factor( const rcsc::GameTime & heard_time,
+             const rcsc::GameTime & current )
+{
+    const long elapsed = current.cycle() - heard_time.cycle();
+    return 0.5 + 0.05 * std::min( 10L, std::max( 0L, elapsed ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the relevance factor by the freshness of own info.
+  \param count accuracy count of the object
+  \return 1.0 if the object is seen in this cycle.
+*/
+inline
+double
+fresh_factor( const int count )
+{
+    return 1.0 / ( 1.0 + std::max( 0, count ) );
+}
+
+}
 
 namespace rcsc {
 
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+SayMessage::bits_per_char()
+{
+    static const double s_bits
+        = std::log( static_cast< double >( AudioCodec::CHAR_SIZE ) )
+        / std::log( 2.0 );
+    return s_bits;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+SayMessage::utility( const WorldModel & ) const
+{
+    return length() * bits_per_char();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 BallMessage::toStr( std::string & to ) const
@@ -95,6 +157,18 @@ BallMessage::toStr( std::string & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+BallMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * fresh_factor( wm.ball().posCount() )
+        * need_factor( wm.audioMemory().ballTime(), wm.time() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 PassMessage::toStr( std::string & to ) const
@@ -246,6 +320,19 @@ GoalieMessage::toStr( std::string & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+GoalieMessage::utility( const WorldModel & wm ) const
+{
+    const PlayerObject * goalie = wm.getOpponentGoalie();
+    return length() * bits_per_char()
+        * fresh_factor( goalie ? goalie->posCount() : 0 )
+        * need_factor( wm.audioMemory().goalieTime(), wm.time() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 OffsideLineMessage::toStr( std::string & to ) const
@@ -294,6 +381,17 @@ OffsideLineMessage::toStr( std::string & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+OffsideLineMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * need_factor( wm.audioMemory().offsideLineTime(), wm.time() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 DefenseLineMessage::toStr( std::string & to ) const
@@ -341,6 +439,17 @@ DefenseLineMessage::toStr( std::string & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+DefenseLineMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * need_factor( wm.audioMemory().defenseLineTime(), wm.time() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 WaitRequestMessage::toStr( std::string & to ) const
@@ -415,6 +524,20 @@ InterceptMessage::toStr( std::string & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+InterceptMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * need_factor( M_our
+                       ? wm.audioMemory().ourInterceptTime()
+                       : wm.audioMemory().oppInterceptTime(),
+                       wm.time() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 PassRequestMessage::toStr( std::string & to ) const
@@ -499,6 +622,17 @@ StaminaMessage::toStr( std::string & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+StaminaMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * need_factor( wm.audioMemory().staminaTime(), wm.time() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 RecoveryMessage::toStr( std::string & to ) const
@@ -713,6 +847,19 @@ BallGoalieMessage::toStr( std::string & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+BallGoalieMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * fresh_factor( wm.ball().posCount() )
+        * 0.5 * ( need_factor( wm.audioMemory().ballTime(), wm.time() )
+                  + need_factor( wm.audioMemory().goalieTime(), wm.time() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 OnePlayerMessage::toStr( std::string & to ) const
@@ -788,6 +935,17 @@ OnePlayerMessage::toStr( std::string & to ) const
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+OnePlayerMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * need_factor( wm.audioMemory().playerTime(), wm.time() );
+}
+
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -887,4 +1045,17 @@ BallPlayerMessage::toStr( std::string & to ) const
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+BallPlayerMessage::utility( const WorldModel & wm ) const
+{
+    return length() * bits_per_char()
+        * fresh_factor( wm.ball().posCount() )
+        * 0.5 * ( need_factor( wm.audioMemory().ballTime(), wm.time() )
+                  + need_factor( wm.audioMemory().playerTime(), wm.time() ) );
+}
+
 }
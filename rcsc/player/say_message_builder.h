@@ -39,6 +39,8 @@
 
 namespace rcsc {
 
+class WorldModel;
+
 /*-------------------------------------------------------------------*/
 /*!
   \class SayMessage
@@ -90,6 +92,23 @@ public:
     virtual
     bool toStr( std::string & to ) const = 0;
 
+    /*!
+      \brief get the useful information bits of this message.
+      used by ActionEffector to select messages within the say budget.
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance.
+      the default relevance is 1.
+    */
+    virtual
+    double utility( const WorldModel & wm ) const;
+
+    /*!
+      \brief get the number of bits carried by one message character
+      \return the number of bits, log2(AudioCodec::CHAR_SIZE)
+    */
+    static
+    double bits_per_char();
+
 };
 
 
@@ -157,6 +176,13 @@ public:
     */
     bool toStr( std::string & to ) const;
 
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
+
 };
 
 /*-------------------------------------------------------------------*/
@@ -299,6 +325,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -367,6 +400,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -429,6 +469,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -491,6 +538,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -672,6 +726,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -872,6 +933,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -941,6 +1009,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -1019,6 +1094,13 @@ public:
       \return result status of encoding
     */
     bool toStr( std::string & to ) const;
+
+    /*!
+      \brief get the useful information bits of this message
+      \param wm const reference to the world model
+      \return the number of message bits weighted by its relevance
+    */
+    double utility( const WorldModel & wm ) const;
 };
 
 }
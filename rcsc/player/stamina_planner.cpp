@@ -0,0 +1,270 @@
+// -*-c++-*-
+
+/*!
+  \file stamina_planner.cpp
+  \brief multi cycle stamina budget planner
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "stamina_planner.h"
+
+#include "world_model.h"
+
+#include <rcsc/common/logger.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+const int StaminaPlanner::STAMINA_BINS;
+const int StaminaPlanner::REFRESH_CYCLES;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+StaminaPlanner::StaminaPlanner()
+    : M_time( -1, 0 )
+    , M_player_type_id( Hetero_Unknown )
+    , M_recovery( 0.0 )
+    , M_demand( 0.0 )
+    , M_horizon( 0 )
+{
+    for ( int i = 0; i <= STAMINA_BINS; ++i )
+    {
+        M_table[i].dash_power_ = ServerParam::i().maxPower();
+        M_table[i].final_stamina_ = 0.0;
+        M_table[i].mean_effort_ = 1.0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+StaminaPlanner::cycles_till_half_end( const GameTime & current )
+{
+    // half_time is given in seconds
+    const int half_time = ( ServerParam::i().simulatorStep() > 0
+                            ? ServerParam::i().halfTime() * 1000
+                            / ServerParam::i().simulatorStep()
+                            : 0 );
+    if ( half_time <= 0 )
+    {
+        return 3000;
+    }
+
+    const long cycle = std::max( 0L, current.cycle() );
+    return static_cast< int >( half_time - cycle % half_time );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+StaminaPlanner::update( const WorldModel & wm,
+                        const double & demand )
+{
+    const double d = std::min( 1.0, std::max( 0.05, demand ) );
+
+    if ( M_time.cycle() >= 0
+         && wm.time().cycle() >= M_time.cycle()
+         && wm.time().cycle() - M_time.cycle() < REFRESH_CYCLES
+         && M_player_type_id == wm.self().playerType().id()
+         && std::fabs( M_recovery - wm.self().recovery() ) < 1.0e-6
+         && std::fabs( M_demand - d ) < 0.01 )
+    {
+        return false;
+    }
+
+    M_time = wm.time();
+    M_player_type_id = wm.self().playerType().id();
+    M_recovery = wm.self().recovery();
+    M_demand = d;
+    M_horizon = cycles_till_half_end( wm.time() );
+
+    createTable( wm.self().playerType(),
+                 wm.self().recovery(),
+                 wm.self().effort() );
+
+    dlog.addText( Logger::TEAM,
+                  "%s:%d: stamina plan. demand=%.2f horizon=%d"
+                  " budget(full)=%.1f budget(half)=%.1f"
+                  ,__FILE__, __LINE__,
+                  M_demand, M_horizon,
+                  M_table[STAMINA_BINS].dash_power_,
+                  M_table[STAMINA_BINS / 2].dash_power_ );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+StaminaPlanner::dashPower( const double & stamina ) const
+{
+    const double rate = std::max( 0.0, stamina ) / ServerParam::i().staminaMax()
+        * STAMINA_BINS;
+    const int i = std::min( static_cast< int >( std::floor( rate ) ),
+                            STAMINA_BINS - 1 );
+    const double r = std::min( 1.0, rate - i );
+
+    return M_table[i].dash_power_ * ( 1.0 - r )
+        + M_table[i + 1].dash_power_ * r;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+StaminaPlanner::solve( const double & stamina,
+                       const double & threshold,
+                       const double & inc ) const
+{
+    const double available = stamina - threshold;
+    if ( available <= 0.0 )
+    {
+        return 0.0;
+    }
+
+    // stamina does not decrease if (demand * power <= inc).
+    // then only one dash must not cross the threshold.
+    const double sustainable = std::min( inc / M_demand, available );
+
+    // otherwise stamina decreases linearly, and the dash at the end of
+    // the half must not cross the threshold:
+    //   stamina - ( demand * power - inc ) * horizon - power > threshold
+    const double h = static_cast< double >( M_horizon );
+    const double spending = ( available + inc * h ) / ( M_demand * h + 1.0 );
+
+    return std::min( ServerParam::i().maxPower(),
+                     std::max( sustainable, spending ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+StaminaPlanner::forecast( const PlayerType & ptype,
+                          const double & recovery,
+                          const double & effort,
+                          const double & stamina,
+                          const double & dash_power,
+                          Entry & result ) const
+{
+    const ServerParam & param = ServerParam::i();
+
+    double s = stamina;
+    double rec = recovery;
+    double eff = effort;
+    double effort_sum = 0.0;
+
+    for ( int i = 0; i < M_horizon; ++i )
+    {
+        s -= dash_power * M_demand;
+
+        if ( s <= param.recoverDecThrValue() )
+        {
+            rec = std::max( param.recoverMin(), rec - param.recoverDec() );
+        }
+
+        if ( s <= param.effortDecThrValue() )
+        {
+            eff = std::max( ptype.effortMin(), eff - param.effortDec() );
+        }
+        else if ( s >= param.effortIncThrValue() )
+        {
+            eff = std::min( ptype.effortMax(), eff + param.effortInc() );
+        }
+
+        s = std::min( param.staminaMax(), s + rec * ptype.staminaIncMax() );
+        effort_sum += eff;
+    }
+
+    result.dash_power_ = dash_power;
+    result.final_stamina_ = s;
+    result.mean_effort_ = ( M_horizon > 0
+                            ? effort_sum / M_horizon
+                            : eff );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+StaminaPlanner::createTable( const PlayerType & ptype,
+                             const double & recovery,
+                             const double & effort )
+{
+    const ServerParam & param = ServerParam::i();
+
+    // keep the margin of one full power dash
+    const double recover_thr = param.recoverDecThrValue() + param.maxPower();
+    const double effort_thr = param.effortDecThrValue() + param.maxPower();
+    const double inc = recovery * ptype.staminaIncMax();
+
+    for ( int i = 0; i <= STAMINA_BINS; ++i )
+    {
+        const double stamina = param.staminaMax() * i / STAMINA_BINS;
+
+        Entry & entry = M_table[i];
+        forecast( ptype, recovery, effort, stamina,
+                  solve( stamina, recover_thr, inc ),
+                  entry );
+
+        // lower power may give the larger effective power,
+        // if it keeps the effort.
+        if ( effort_thr > recover_thr )
+        {
+            Entry keep_effort;
+            forecast( ptype, recovery, effort, stamina,
+                      solve( stamina, effort_thr, inc ),
+                      keep_effort );
+
+            if ( keep_effort.dash_power_ * keep_effort.mean_effort_
+                 > entry.dash_power_ * entry.mean_effort_ )
+            {
+                entry = keep_effort;
+            }
+        }
+    }
+}
+
+}
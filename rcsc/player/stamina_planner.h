@@ -0,0 +1,192 @@
+// -*-c++-*-
+
+/*!
+  \file stamina_planner.h
+  \brief multi cycle stamina budget planner
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_STAMINA_PLANNER_H
+#define RCSC_PLAYER_STAMINA_PLANNER_H
+
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+
+class PlayerType;
+class WorldModel;
+
+/*!
+  \class StaminaPlanner
+  \brief dash power budget for the rest of the half.
+
+  The planner forecasts stamina and effort until the end of the current
+  half with the same update rules as StaminaModel, assuming that the
+  player dashes in the given ratio of cycles (role demand). For each
+  stamina level, it solves the maximal dash power that never lets
+  stamina fall to the recovery decrement threshold before the half
+  ends, and also considers keeping stamina above the effort decrement
+  threshold if that gives larger effective power.
+
+  The result is stored in a lookup table indexed by the stamina level.
+  The table is rebuilt only when the player type, the recovery or the
+  demand changes, or every REFRESH_CYCLES cycles, so the cost of one
+  query is a table interpolation.
+ */
+class StaminaPlanner {
+public:
+
+    //! the number of stamina intervals of the table
+    static const int STAMINA_BINS = 40;
+    //! the table is rebuilt at least every this cycles
+    static const int REFRESH_CYCLES = 20;
+
+    /*!
+      \struct Entry
+      \brief planned budget for one stamina level
+     */
+    struct Entry {
+        double dash_power_; //!< dash power budget
+        double final_stamina_; //!< forecast stamina at the end of the half
+        double mean_effort_; //!< forecast mean effort until the end of the half
+    };
+
+private:
+
+    //! last updated time
+    GameTime M_time;
+    //! player type id used for the last update
+    int M_player_type_id;
+    //! recovery value used for the last update
+    double M_recovery;
+    //! dash ratio used for the last update
+    double M_demand;
+    //! the number of cycles until the end of the half
+    int M_horizon;
+
+    //! budget table. element i is for stamina (staminaMax * i / STAMINA_BINS)
+    Entry M_table[STAMINA_BINS + 1];
+
+public:
+
+    /*!
+      \brief create an empty table
+     */
+    StaminaPlanner();
+
+    /*!
+      \brief rebuild the table if needed
+      \param wm const reference to the world model
+      \param demand ratio of the cycles that the player dashes (0, 1]
+      \return true if the table is rebuilt
+     */
+    bool update( const WorldModel & wm,
+                 const double & demand );
+
+    /*!
+      \brief get the dash power budget
+      \param stamina current stamina value
+      \return dash power that can be used every dashing cycle
+     */
+    double dashPower( const double & stamina ) const;
+
+    /*!
+      \brief get the table entry
+      \param index table index [0, STAMINA_BINS]
+      \return const reference to the entry
+     */
+    const
+    Entry & entry( const int index ) const
+      {
+          return M_table[ index < 0
+                          ? 0
+                          : index > STAMINA_BINS
+                          ? STAMINA_BINS
+                          : index ];
+      }
+
+    /*!
+      \brief get the forecast horizon used for the current table
+      \return the number of cycles
+     */
+    int horizon() const
+      {
+          return M_horizon;
+      }
+
+private:
+
+    /*!
+      \brief build all table entries
+      \param ptype player type of the player
+      \param recovery current recovery value
+      \param effort current effort value
+     */
+    void createTable( const PlayerType & ptype,
+                      const double & recovery,
+                      const double & effort );
+
+    /*!
+      \brief get the maximal dash power that keeps stamina above the threshold
+      \param stamina initial stamina
+      \param threshold stamina threshold
+      \param inc stamina recovered in one cycle
+      \return dash power budget
+     */
+    double solve( const double & stamina,
+                  const double & threshold,
+                  const double & inc ) const;
+
+    /*!
+      \brief forecast stamina and effort until the end of the half
+      \param ptype player type of the player
+      \param recovery recovery value
+      \param effort initial effort value
+      \param stamina initial stamina
+      \param dash_power dash power used in dashing cycles
+      \param result reference to the entry to store the forecast
+     */
+    void forecast( const PlayerType & ptype,
+                   const double & recovery,
+                   const double & effort,
+                   const double & stamina,
+                   const double & dash_power,
+                   Entry & result ) const;
+
+    /*!
+      \brief get the number of cycles until the end of the half
+      \param current current game time
+      \return the number of cycles
+     */
+    static
+    int cycles_till_half_end( const GameTime & current );
+
+};
+
+}
+
+#endif
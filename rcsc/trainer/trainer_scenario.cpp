@@ -0,0 +1,316 @@
+// -*-c++-*-
+
+/*!
+  \file trainer_scenario.cpp
+  \brief scripted training situation Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "trainer_scenario.h"
+
+#include <rcsc/coach/global_world_model.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+
+#include <sstream>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TrainerScenario::TrainerScenario()
+    : M_name( "" )
+    , M_playmode( PM_PlayOn )
+    , M_time_limit( 100 )
+    , M_ball_pos( 0.0, 0.0 )
+    , M_ball_vel( 0.0, 0.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+TrainerScenario::outcome_name( const Outcome outcome )
+{
+    static const char * names[] = { "running",
+                                    "goal_l",
+                                    "goal_r",
+                                    "out_of_field",
+                                    "kickable_l",
+                                    "kickable_r",
+                                    "time_over",
+                                    "" };
+
+    if ( outcome < Running || MAX_OUTCOME <= outcome )
+    {
+        return names[MAX_OUTCOME];
+    }
+
+    return names[outcome];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SideID
+TrainerScenario::attackingSide() const
+{
+    SideID side = NEUTRAL;
+    double min_dist2 = 1.0e10;
+
+    const std::vector< Player >::const_iterator end = M_players.end();
+    for ( std::vector< Player >::const_iterator p = M_players.begin();
+          p != end;
+          ++p )
+    {
+        double d2 = p->pos_.dist2( M_ball_pos );
+        if ( d2 < min_dist2 )
+        {
+            min_dist2 = d2;
+            side = p->side_;
+        }
+    }
+
+    return side;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+SideID
+TrainerScenario::kickableSide( const GlobalWorldModel & world )
+{
+    bool left = false;
+    bool right = false;
+
+    const std::list< GlobalPlayerObject >::const_iterator end = world.players().end();
+    for ( std::list< GlobalPlayerObject >::const_iterator p = world.players().begin();
+          p != end;
+          ++p )
+    {
+        const PlayerType * ptype
+            = PlayerTypeSet::i().get( world.heteroID( p->side(), p->unum() ) );
+        const double kickable_area = ( ptype
+                                       ? ptype->kickableArea()
+                                       : ServerParam::i().defaultKickableArea() );
+
+        if ( p->pos().dist2( world.ball().pos() ) < kickable_area * kickable_area )
+        {
+            if ( p->side() == LEFT ) left = true;
+            if ( p->side() == RIGHT ) right = true;
+        }
+    }
+
+    if ( left == right )
+    {
+        return NEUTRAL;
+    }
+
+    return ( left ? LEFT : RIGHT );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TrainerScenario::Outcome
+TrainerScenario::judge( const GlobalWorldModel & world,
+                        const int elapsed ) const
+{
+    switch ( world.getBallStatus() ) {
+    case Ball_GoalL:
+        return GoalLeft;
+    case Ball_GoalR:
+        return GoalRight;
+    case Ball_OutOfField:
+        return OutOfField;
+    default:
+        break;
+    }
+
+    if ( elapsed > 0 )
+    {
+        const SideID attacker = attackingSide();
+        const SideID kickable = kickableSide( world );
+
+        if ( attacker != NEUTRAL
+             && kickable != NEUTRAL
+             && kickable != attacker )
+        {
+            return ( attacker == LEFT
+                     ? KickableLeft
+                     : KickableRight );
+        }
+    }
+
+    if ( elapsed >= M_time_limit )
+    {
+        return TimeOver;
+    }
+
+    return Running;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+TrainerScenario::read( std::istream & is,
+                       std::vector< TrainerScenario > & scenarios )
+{
+    static const char * playmode_strings[] = PLAYMODE_STRINGS;
+
+    TrainerScenario scenario;
+    bool in_scenario = false;
+    int n_line = 0;
+
+    std::string line;
+    while ( std::getline( is, line ) )
+    {
+        ++n_line;
+
+        std::istringstream istrm( line );
+        std::string tag;
+
+        if ( ! ( istrm >> tag )
+             || tag[0] == '#' )
+        {
+            continue;
+        }
+
+        bool result = true;
+
+        if ( tag == "scenario" )
+        {
+            std::string mode;
+            scenario = TrainerScenario();
+            in_scenario = true;
+
+            if ( ! ( istrm >> scenario.M_name >> mode >> scenario.M_time_limit ) )
+            {
+                result = false;
+            }
+
+            scenario.M_playmode = PM_MAX;
+            for ( int i = PM_BeforeKickOff; i < PM_MAX; ++i )
+            {
+                if ( mode == playmode_strings[i] )
+                {
+                    scenario.M_playmode = static_cast< PlayMode >( i );
+                    break;
+                }
+            }
+
+            if ( scenario.M_playmode == PM_MAX
+                 || scenario.M_time_limit <= 0 )
+            {
+                result = false;
+            }
+        }
+        else if ( tag == "ball" && in_scenario )
+        {
+            if ( ! ( istrm >> scenario.M_ball_pos.x >> scenario.M_ball_pos.y ) )
+            {
+                result = false;
+            }
+            if ( ! ( istrm >> scenario.M_ball_vel.x >> scenario.M_ball_vel.y ) )
+            {
+                scenario.M_ball_vel.assign( 0.0, 0.0 );
+            }
+        }
+        else if ( tag == "player" && in_scenario )
+        {
+            char side = '\0';
+            int unum = 0;
+            Vector2D pos;
+            double body = 0.0;
+
+            if ( ! ( istrm >> side >> unum >> pos.x >> pos.y ) )
+            {
+                result = false;
+            }
+            if ( ! ( istrm >> body ) )
+            {
+                body = 0.0;
+            }
+
+            if ( ( side != 'l' && side != 'r' )
+                 || unum < 1 || 11 < unum )
+            {
+                result = false;
+            }
+
+            if ( result )
+            {
+                scenario.M_players.push_back( Player( side == 'l' ? LEFT : RIGHT,
+                                                      unum, pos, body ) );
+            }
+        }
+        else if ( tag == "end" && in_scenario )
+        {
+            scenarios.push_back( scenario );
+            in_scenario = false;
+        }
+        else
+        {
+            result = false;
+        }
+
+        if ( ! result )
+        {
+            std::cerr << __FILE__ << ":" << __LINE__
+                      << " ***ERROR*** illegal scenario line " << n_line
+                      << " [" << line << "]"
+                      << std::endl;
+            return false;
+        }
+    }
+
+    if ( in_scenario )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " ***ERROR*** scenario [" << scenario.M_name
+                  << "] is not closed by 'end'."
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+}
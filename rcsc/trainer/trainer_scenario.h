@@ -0,0 +1,232 @@
+// -*-c++-*-
+
+/*!
+  \file trainer_scenario.h
+  \brief scripted training situation Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_TRAINER_TRAINER_SCENARIO_H
+#define RCSC_TRAINER_TRAINER_SCENARIO_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/types.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+
+class GlobalWorldModel;
+
+/*!
+  \class TrainerScenario
+  \brief scripted situation that the trainer sets up and judges.
+
+  Scenario file format:
+  \verbatim
+  # comment
+  scenario <name> <playmode> <time_limit>
+  ball <x> <y> [<vx> <vy>]
+  player <l|r> <unum> <x> <y> [<body>]
+  ...
+  end
+  \endverbatim
+
+  playmode is the name used by rcssserver, e.g. play_on, corner_kick_l.
+  time_limit is the number of cycles of one episode.
+ */
+class TrainerScenario {
+public:
+
+    /*!
+      \enum Outcome
+      \brief result of an episode
+     */
+    enum Outcome {
+        Running, //!< not finished
+        GoalLeft, //!< ball is in the left goal
+        GoalRight, //!< ball is in the right goal
+        OutOfField, //!< ball is out of field
+        KickableLeft, //!< left team player lost the ball to the right team
+        KickableRight, //!< right team player lost the ball to the left team
+        TimeOver, //!< time limit
+        MAX_OUTCOME
+    };
+
+    /*!
+      \struct Player
+      \brief initial state of one player
+     */
+    struct Player {
+        SideID side_; //!< team side
+        int unum_; //!< uniform number
+        Vector2D pos_; //!< initial position
+        double body_; //!< initial body angle
+
+        /*!
+          \brief construct with all values
+         */
+        Player( const SideID side,
+                const int unum,
+                const Vector2D & pos,
+                const double & body )
+            : side_( side )
+            , unum_( unum )
+            , pos_( pos )
+            , body_( body )
+          { }
+    };
+
+private:
+
+    std::string M_name; //!< scenario name
+    PlayMode M_playmode; //!< playmode after the setup
+    int M_time_limit; //!< the number of cycles of one episode
+
+    Vector2D M_ball_pos; //!< initial ball position
+    Vector2D M_ball_vel; //!< initial ball velocity
+
+    std::vector< Player > M_players; //!< initial player states
+
+public:
+
+    /*!
+      \brief create an empty play_on scenario
+     */
+    TrainerScenario();
+
+    /*!
+      \brief get the scenario name
+      \return name string
+     */
+    const
+    std::string & name() const
+      {
+          return M_name;
+      }
+
+    /*!
+      \brief get the playmode after the setup
+      \return playmode
+     */
+    PlayMode playmode() const
+      {
+          return M_playmode;
+      }
+
+    /*!
+      \brief get the time limit
+      \return the number of cycles
+     */
+    int timeLimit() const
+      {
+          return M_time_limit;
+      }
+
+    /*!
+      \brief get the initial ball position
+      \return const reference to the position
+     */
+    const
+    Vector2D & ballPos() const
+      {
+          return M_ball_pos;
+      }
+
+    /*!
+      \brief get the initial ball velocity
+      \return const reference to the velocity
+     */
+    const
+    Vector2D & ballVel() const
+      {
+          return M_ball_vel;
+      }
+
+    /*!
+      \brief get the initial player states
+      \return const reference to the container
+     */
+    const
+    std::vector< Player > & players() const
+      {
+          return M_players;
+      }
+
+    /*!
+      \brief judge the current state of the episode
+      \param world const reference to the world model
+      \param elapsed the number of cycles from the episode start
+      \return outcome of the episode. Running if not finished.
+
+      The episode is finished when the ball goes into a goal or out of
+      the field, when a player of the team that did not have the ball
+      at the start can kick it, or when the time limit is reached.
+     */
+    Outcome judge( const GlobalWorldModel & world,
+                   const int elapsed ) const;
+
+    /*!
+      \brief get the outcome name
+      \param outcome outcome Id
+      \return name string
+     */
+    static
+    const char * outcome_name( const Outcome outcome );
+
+    /*!
+      \brief read all scenarios from the input stream
+      \param is reference to the input stream
+      \param scenarios reference to the container to store the result
+      \return true if all scenarios are read successfully
+     */
+    static
+    bool read( std::istream & is,
+               std::vector< TrainerScenario > & scenarios );
+
+private:
+
+    /*!
+      \brief get the team side of the ball owner at the start
+      \return nearest player's side to the initial ball position
+     */
+    SideID attackingSide() const;
+
+    /*!
+      \brief get the side of the player who can kick the ball now
+      \param world const reference to the world model
+      \return side of the kickable player. NEUTRAL if nobody or both.
+     */
+    static
+    SideID kickableSide( const GlobalWorldModel & world );
+
+};
+
+}
+
+#endif